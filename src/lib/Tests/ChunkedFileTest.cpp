@@ -0,0 +1,108 @@
+#include <core/document/ChunkedFile.hpp>
+
+#include <QBuffer>
+
+#include <random>
+
+#define CATCH_CONFIG_MAIN 1
+#if __has_include(<catch2/catch.hpp>)
+#include <catch2/catch.hpp>
+
+namespace
+{
+// A few chunks, the last one partial
+QByteArray testData()
+{
+  QByteArray data(2 * 1024 * 1024 + 12345, Qt::Uninitialized);
+  std::mt19937 rng{1234};
+  for (auto& c : data)
+    c = char(rng());
+  return data;
+}
+
+QByteArray writeChunked(const QByteArray& data)
+{
+  QByteArray file;
+  QBuffer buf{&file};
+  REQUIRE(buf.open(QIODevice::WriteOnly));
+
+  score::ChunkedFileWriter writer{buf};
+  // Not aligned on the chunks
+  for (int i = 0; i < data.size(); i += 100000)
+    REQUIRE(writer.write(data.mid(i, 100000)) == data.mid(i, 100000).size());
+  REQUIRE(writer.finish());
+  return file;
+}
+}
+
+TEST_CASE("chunked_roundtrip", "[ChunkedFile]")
+{
+  const auto data = testData();
+  const auto file = writeChunked(data);
+  REQUIRE(score::ChunkedFileReader::isChunked(file.constData(), file.size()));
+
+  score::ChunkedFileReader reader{file.constData(), file.size()};
+  REQUIRE(reader.verify());
+  REQUIRE(reader.bytesAvailable() == data.size());
+  REQUIRE(reader.readAll() == data);
+  REQUIRE(reader.bytesAvailable() == 0);
+}
+
+TEST_CASE("chunked_empty", "[ChunkedFile]")
+{
+  const auto file = writeChunked({});
+
+  score::ChunkedFileReader reader{file.constData(), file.size()};
+  REQUIRE(reader.verify());
+  REQUIRE(reader.readAll().isEmpty());
+}
+
+TEST_CASE("chunked_corrupted", "[ChunkedFile]")
+{
+  const auto data = testData();
+  const auto file = writeChunked(data);
+
+  SECTION("bit flip in a chunk")
+  {
+    auto corrupted = file;
+    corrupted[corrupted.size() / 2] = char(corrupted[corrupted.size() / 2] ^ 1);
+
+    score::ChunkedFileReader reader{corrupted.constData(), corrupted.size()};
+    REQUIRE(!reader.verify());
+    REQUIRE(!reader.isOpen());
+  }
+
+  SECTION("truncated")
+  {
+    const auto truncated = file.left(file.size() - 1);
+
+    score::ChunkedFileReader reader{truncated.constData(), truncated.size()};
+    REQUIRE(!reader.verify());
+  }
+
+  SECTION("trailing data")
+  {
+    const auto longer = file + QByteArray(16, 0);
+
+    score::ChunkedFileReader reader{longer.constData(), longer.size()};
+    REQUIRE(!reader.verify());
+  }
+
+  SECTION("not chunked")
+  {
+    score::ChunkedFileReader reader{data.constData(), data.size()};
+    REQUIRE(!reader.verify());
+  }
+}
+
+TEST_CASE("chunked_write_error", "[ChunkedFile]")
+{
+  QByteArray file;
+  QBuffer buf{&file};
+  REQUIRE(buf.open(QIODevice::ReadOnly));
+
+  score::ChunkedFileWriter writer{buf};
+  writer.write(testData());
+  REQUIRE(!writer.finish());
+}
+#endif
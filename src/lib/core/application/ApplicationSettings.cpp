@@ -11,6 +11,8 @@
 #include <QString>
 
 #include <score_git_info.hpp>
+
+#include <algorithm>
 namespace score
 {
 void ApplicationSettings::parse(QStringList cargs, int& argc, char** argv)
@@ -57,6 +59,33 @@ void ApplicationSettings::parse(QStringList cargs, int& argc, char** argv)
       "0");
   parser.addOption(waitLoadOpt);
 
+  QCommandLineOption durationOpt(
+      "duration",
+      QCoreApplication::translate(
+          "main", "Stop playing and exit after N seconds."),
+      "N",
+      "0");
+  parser.addOption(durationOpt);
+
+  QCommandLineOption exitAtEndOpt(
+      "exit-at-end",
+      QCoreApplication::translate(
+          "main", "Exit once the scenario has finished playing."));
+  parser.addOption(exitAtEndOpt);
+
+  QCommandLineOption audioDriverOpt(
+      "audio-driver",
+      QCoreApplication::translate(
+          "main", "Audio driver to use, e.g. JACK, PortAudio or Dummy."),
+      "name");
+  parser.addOption(audioDriverOpt);
+
+  QCommandLineOption metricsOpt(
+      "metrics",
+      QCoreApplication::translate(
+          "main", "Print tick timing statistics when the execution stops."));
+  parser.addOption(metricsOpt);
+
 #if defined(__APPLE__)
   // Bogus macOS gatekeeper BS:
   // https://stackoverflow.com/questions/55562155/qt-application-for-mac-not-being-launched
@@ -98,6 +127,12 @@ void ApplicationSettings::parse(QStringList cargs, int& argc, char** argv)
   if (parser.isSet(waitLoadOpt))
     waitAfterLoad = parser.value(waitLoadOpt).toInt();
 
+  if (parser.isSet(durationOpt))
+    playDuration = std::max(0., parser.value(durationOpt).toDouble());
+  exitAfterPlay = parser.isSet(exitAtEndOpt) || playDuration > 0.;
+  audioDriver = parser.value(audioDriverOpt);
+  printMetrics = parser.isSet(metricsOpt);
+
   if (!args.empty() && QFile::exists(args[0]))
   {
     loadList.push_back(args[0]);
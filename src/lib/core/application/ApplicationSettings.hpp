@@ -36,6 +36,18 @@ struct SCORE_LIB_BASE_EXPORT ApplicationSettings
   //! Seconds to wait before playing
   int waitAfterLoad = 0;
 
+  //! Seconds to play before stopping and exiting, 0 to play until stopped
+  double playDuration = 0.;
+
+  //! If true, exits once the scenario stops playing
+  bool exitAfterPlay = false;
+
+  //! Audio driver to use instead of the one in the settings, e.g. "dummy"
+  QString audioDriver;
+
+  //! If true, prints timing statistics when the execution stops
+  bool printMetrics = false;
+
   //! Complete list of arguments passed to parse
   QStringList arguments;
 
@@ -8,8 +8,64 @@
 
 #include <core/command/CommandStack.hpp>
 
+#include <array>
+#include <cstring>
+
 namespace score
 {
+namespace
+{
+static constexpr quint32 journal_magic = 0x4a434353; // SCCJ
+static constexpr quint32 journal_version = 1;
+
+enum RecordType : quint8
+{
+  Snapshot = 1, // Both stacks
+  Push = 2,     // A command, the redo stack is cleared
+  Undo = 3,     // Top of undo to redo
+  Redo = 4      // Top of redo to undo
+};
+
+struct JournalHeader
+{
+  quint32 magic{};
+  quint32 version{};
+};
+
+struct RecordHeader
+{
+  quint32 size{};
+  quint32 checksum{};
+  quint8 type{};
+  quint8 padding[3]{};
+};
+
+// Compact when the journal has more records than this
+// plus twice the number of commands in the stacks
+static constexpr int journal_min_records = 256;
+
+static constexpr std::array<quint32, 256> crc_table = [] {
+  std::array<quint32, 256> table{};
+  for (quint32 i = 0; i < 256; i++)
+  {
+    quint32 c = i;
+    for (int k = 0; k < 8; k++)
+      c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+    table[i] = c;
+  }
+  return table;
+}();
+
+static quint32 crc32(quint8 type, const char* data, qsizetype size) noexcept
+{
+  quint32 c = 0xFFFFFFFFu;
+  c = crc_table[(c ^ type) & 0xFF] ^ (c >> 8);
+  for (qsizetype i = 0; i < size; i++)
+    c = crc_table[(c ^ quint8(data[i])) & 0xFF] ^ (c >> 8);
+  return c ^ 0xFFFFFFFFu;
+}
+}
+
 CommandStackBackup::CommandStackBackup(const CommandStack& stack)
 {
   // Load initial state
@@ -28,7 +84,6 @@ CommandBackupFile::CommandBackupFile(
     QObject* parent)
     : QObject{parent}
     , m_stack{stack}
-    , m_backup{m_stack}
 {
   m_file.open();
 
@@ -39,7 +94,11 @@ CommandBackupFile::CommandBackupFile(
   con(m_stack,
       &CommandStack::sig_indexChanged,
       this,
-      &CommandBackupFile::on_indexChanged);
+      &CommandBackupFile::on_stackChanged);
+  con(m_stack,
+      &CommandStack::stackChanged,
+      this,
+      &CommandBackupFile::on_stackChanged);
 
   // Initial backup so that the file is always in a loadable state.
   commit();
@@ -52,80 +111,165 @@ QString CommandBackupFile::fileName() const
 
 void CommandBackupFile::on_push()
 {
-  /*
-  // A new command is added to m_undoable
-  // m_redoable should be cleared
-  auto cmd = m_stack.m_undoable.last();
-  m_backup.savedUndo.push(CommandData{*cmd});
-
-  m_backup.savedRedo.clear();
+  // A new command is added to m_undoable, m_redoable is cleared
+  QByteArray payload;
+  DataStream::Serializer ser{&payload};
+  ser.readFrom(CommandData{*m_stack.m_undoable.top()});
 
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  m_undoCount++;
+  m_redoCount = 0;
+  append(Push, payload);
 }
 
 void CommandBackupFile::on_undo()
 {
-  /*
-  // Pop from undoable to redoable
-  m_backup.savedRedo.push(m_savedUndo.pop());
-
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  m_undoCount--;
+  m_redoCount++;
+  append(Undo, {});
 }
 
 void CommandBackupFile::on_redo()
 {
-  /*
-  // Pop from redoable to undoable
-  m_backup.savedUndo.push(m_savedRedo.pop());
+  m_undoCount++;
+  m_redoCount--;
+  append(Redo, {});
+}
 
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+void CommandBackupFile::on_stackChanged()
+{
+  // The stacks can also be modified without the low-level signals,
+  // e.g. when restoring a document: start from a new snapshot then.
+  if (m_undoCount != m_stack.m_undoable.size()
+      || m_redoCount != m_stack.m_redoable.size())
+    commit();
 }
 
-void CommandBackupFile::on_indexChanged()
+void CommandBackupFile::append(quint8 type, const QByteArray& payload)
 {
-  /*
-  // Pop a lot
-  auto index = m_stack.currentIndex();
-  if(index > m_previousIndex)
-  {
-      for(int i = 0; i < index - m_previousIndex; i++)
-      {
-          m_backup.savedUndo.push(m_savedRedo.pop());
-      }
-  }
-  else if(index < m_previousIndex)
+  if (m_records > journal_min_records + 2 * (m_undoCount + m_redoCount))
   {
-      for(int i = 0; i < m_previousIndex - index ; i++)
-      {
-          m_backup.savedRedo.push(m_savedUndo.pop());
-      }
+    // The stacks already contain the change being recorded
+    commit();
+    return;
   }
 
-  m_previousIndex = m_stack.currentIndex();
-  */
-  commit();
+  RecordHeader h;
+  h.size = payload.size();
+  h.checksum = crc32(type, payload.constData(), payload.size());
+  h.type = type;
+
+  m_file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+  m_file.write(payload);
+  m_file.flush();
+  m_records++;
 }
 
 void CommandBackupFile::commit()
 {
-  // OPTIMIZEME: right now all the data is flushed each time.
-  // It should be better to only incrementally modify the file.
-  // See :
-  // http://www.boost.org/doc/libs/1_59_0/doc/html/interprocess/sharedmemorybetweenprocesses.html#interprocess.sharedmemorybetweenprocesses.mapped_file
+  QByteArray payload;
+  {
+    DataStream::Serializer ser{&payload};
+    ser.readFrom(m_stack);
+  }
 
-  // Another possibility would be to save the commands to a db ?
   m_file.resize(0);
   m_file.reset();
 
-  DataStream::Serializer ser(&m_file);
-  ser.readFrom(m_stack);
+  JournalHeader header{journal_magic, journal_version};
+  m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
 
+  RecordHeader h;
+  h.size = payload.size();
+  h.checksum = crc32(Snapshot, payload.constData(), payload.size());
+  h.type = Snapshot;
+  m_file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+  m_file.write(payload);
   m_file.flush();
+
+  m_undoCount = m_stack.m_undoable.size();
+  m_redoCount = m_stack.m_redoable.size();
+  m_records = 0;
+}
+
+bool CommandBackupFile::read(
+    const QByteArray& journal,
+    std::vector<CommandData>& undo,
+    std::vector<CommandData>& redo)
+{
+  JournalHeader header;
+  if (journal.size() < qsizetype(sizeof(header)))
+    return false;
+
+  std::memcpy(&header, journal.constData(), sizeof(header));
+  if (header.magic != journal_magic || header.version != journal_version)
+    return false;
+
+  undo.clear();
+  redo.clear();
+
+  qsizetype pos = sizeof(header);
+  try
+  {
+    while (pos + qsizetype(sizeof(RecordHeader)) <= journal.size())
+    {
+      RecordHeader h;
+      std::memcpy(&h, journal.constData() + pos, sizeof(h));
+      pos += sizeof(h);
+
+      if (qsizetype(h.size) > journal.size() - pos)
+        break;
+
+      const char* data = journal.constData() + pos;
+      if (crc32(h.type, data, h.size) != h.checksum)
+        break;
+      pos += h.size;
+
+      const QByteArray payload = QByteArray::fromRawData(data, h.size);
+      switch (h.type)
+      {
+        case Snapshot:
+        {
+          undo.clear();
+          redo.clear();
+          DataStream::Deserializer writer{payload};
+          writer.writeTo(undo);
+          writer.writeTo(redo);
+          writer.checkDelimiter();
+          break;
+        }
+        case Push:
+        {
+          CommandData cmd;
+          DataStream::Deserializer writer{payload};
+          writer.writeTo(cmd);
+          undo.push_back(std::move(cmd));
+          redo.clear();
+          break;
+        }
+        case Undo:
+          if (!undo.empty())
+          {
+            redo.push_back(std::move(undo.back()));
+            undo.pop_back();
+          }
+          break;
+        case Redo:
+          if (!redo.empty())
+          {
+            undo.push_back(std::move(redo.back()));
+            redo.pop_back();
+          }
+          break;
+        default:
+          return true;
+      }
+    }
+  }
+  catch (...)
+  {
+    // Keep what could be read
+  }
+
+  return true;
 }
 }
@@ -7,6 +7,8 @@
 #include <QString>
 #include <QTemporaryFile>
 
+#include <vector>
+
 namespace score
 {
 class CommandStack;
@@ -24,8 +26,11 @@ struct CommandStackBackup
 /**
  * @brief Abstraction over the backup of commands
  *
- * Synchronizes the commands of a document to an on-disk file,
- * by maintaining serialized stacks of commands at each new command.
+ * Synchronizes the commands of a document to an on-disk journal.
+ * The journal starts with a snapshot of the serialized stacks of commands,
+ * then each new command, undo and redo appends a small checksummed record.
+ * When there are too many records compared to the size of the stacks,
+ * the file is compacted into a new snapshot.
  *
  * This way, if there is a crash, the document can be restored from the
  * last successful command and only the latest user action is lost.
@@ -36,17 +41,38 @@ public:
   CommandBackupFile(const score::CommandStack& stack, QObject* parent);
   QString fileName() const;
 
+  /**
+   * @brief Reads the stacks of commands saved in a journal.
+   *
+   * Reading stops at the first incomplete or corrupted record,
+   * which would be the one being written during a crash.
+   *
+   * @return false if the data is not a journal.
+   */
+  static bool read(
+      const QByteArray& journal,
+      std::vector<CommandData>& undo,
+      std::vector<CommandData>& redo);
+
 private:
   void on_push();
   void on_undo();
   void on_redo();
-  void on_indexChanged();
+  void on_stackChanged();
 
-  //! Writes the current buffers to disk.
+  //! Rewrites the file with a snapshot of the current stacks.
   void commit();
 
+  void append(quint8 type, const QByteArray& payload);
+
   const score::CommandStack& m_stack;
-  CommandStackBackup m_backup;
+
+  // Number of commands in each stack, as described by the journal
+  int m_undoCount{};
+  int m_redoCount{};
+
+  // Records written since the last snapshot
+  int m_records{};
 
   QTemporaryFile m_file;
 };
@@ -10,16 +10,11 @@ namespace score
 template <typename RedoFun>
 void loadCommandStack(
     const score::ApplicationComponents& components,
-    DataStreamWriter& writer,
+    const std::vector<score::CommandData>& undoStack,
+    const std::vector<score::CommandData>& redoStack,
     score::CommandStack& stack,
     RedoFun redo_fun)
 {
-  std::vector<score::CommandData> undoStack, redoStack;
-  writer.writeTo(undoStack);
-  writer.writeTo(redoStack);
-
-  writer.checkDelimiter();
-
   stack.undoable().clear();
   stack.redoable().clear();
 
@@ -53,4 +48,21 @@ void loadCommandStack(
     }
   });
 }
+
+template <typename RedoFun>
+void loadCommandStack(
+    const score::ApplicationComponents& components,
+    DataStreamWriter& writer,
+    score::CommandStack& stack,
+    RedoFun redo_fun)
+{
+  std::vector<score::CommandData> undoStack, redoStack;
+  writer.writeTo(undoStack);
+  writer.writeTo(redoStack);
+
+  writer.checkDelimiter();
+
+  loadCommandStack(
+      components, undoStack, redoStack, stack, std::move(redo_fun));
+}
 }
@@ -0,0 +1,312 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "ChunkedFile.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace score
+{
+namespace
+{
+static constexpr quint32 chunked_magic = 0x46424353; // SCBF
+static constexpr quint32 chunked_version = 1;
+static constexpr quint32 chunk_size = 1024 * 1024;
+
+// Files with larger chunks are considered invalid
+static constexpr quint32 max_chunk_size = 64 * 1024 * 1024;
+
+enum ChunkFlags : quint32
+{
+  LastChunk = 1
+};
+
+struct FileHeader
+{
+  quint32 magic{};
+  quint32 version{};
+  quint32 chunkSize{};
+  quint32 padding{};
+};
+
+struct ChunkHeader
+{
+  quint32 size{};
+  quint32 flags{};
+  quint64 checksum{};
+};
+
+static constexpr quint64 prime1 = 11400714785074694791ULL;
+static constexpr quint64 prime2 = 14029467366897019727ULL;
+static constexpr quint64 prime3 = 1609587929392839161ULL;
+static constexpr quint64 prime4 = 9650029242287828579ULL;
+static constexpr quint64 prime5 = 2870177450012600261ULL;
+
+static inline quint64 rotl(quint64 x, int r) noexcept
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+static inline quint64 read64(const char* p) noexcept
+{
+  quint64 v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline quint32 read32(const char* p) noexcept
+{
+  quint32 v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline quint64 round(quint64 acc, quint64 input) noexcept
+{
+  acc += input * prime2;
+  acc = rotl(acc, 31);
+  return acc * prime1;
+}
+
+static inline quint64 merge(quint64 acc, quint64 val) noexcept
+{
+  acc ^= round(0, val);
+  return acc * prime1 + prime4;
+}
+
+// xxHash64: fast enough to not be noticeable next to the disk
+// (several GB/s), while detecting truncations and bit flips.
+static quint64 xxh64(const char* p, qint64 len, quint64 seed) noexcept
+{
+  const char* const end = p + len;
+  quint64 h{};
+
+  if (len >= 32)
+  {
+    quint64 v1 = seed + prime1 + prime2;
+    quint64 v2 = seed + prime2;
+    quint64 v3 = seed;
+    quint64 v4 = seed - prime1;
+    do
+    {
+      v1 = round(v1, read64(p));
+      v2 = round(v2, read64(p + 8));
+      v3 = round(v3, read64(p + 16));
+      v4 = round(v4, read64(p + 24));
+      p += 32;
+    } while (p + 32 <= end);
+
+    h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+    h = merge(h, v1);
+    h = merge(h, v2);
+    h = merge(h, v3);
+    h = merge(h, v4);
+  }
+  else
+  {
+    h = seed + prime5;
+  }
+
+  h += quint64(len);
+
+  for (; p + 8 <= end; p += 8)
+  {
+    h ^= round(0, read64(p));
+    h = rotl(h, 27) * prime1 + prime4;
+  }
+  if (p + 4 <= end)
+  {
+    h ^= quint64(read32(p)) * prime1;
+    h = rotl(h, 23) * prime2 + prime3;
+    p += 4;
+  }
+  for (; p < end; p++)
+  {
+    h ^= quint64(quint8(*p)) * prime5;
+    h = rotl(h, 11) * prime1;
+  }
+
+  h ^= h >> 33;
+  h *= prime2;
+  h ^= h >> 29;
+  h *= prime3;
+  h ^= h >> 32;
+  return h;
+}
+}
+
+ChunkedFileWriter::ChunkedFileWriter(QIODevice& out)
+    : m_out{out}
+{
+  m_chunk.resize(chunk_size);
+
+  const FileHeader h{chunked_magic, chunked_version, chunk_size, 0};
+  m_ok = m_out.write(reinterpret_cast<const char*>(&h), sizeof(h))
+         == sizeof(h);
+
+  open(QIODevice::WriteOnly | QIODevice::Unbuffered);
+}
+
+ChunkedFileWriter::~ChunkedFileWriter()
+{
+  close();
+}
+
+bool ChunkedFileWriter::finish()
+{
+  if (isOpen())
+  {
+    writeChunk(true);
+    close();
+  }
+  return m_ok;
+}
+
+qint64 ChunkedFileWriter::readData(char*, qint64)
+{
+  return -1;
+}
+
+qint64 ChunkedFileWriter::writeData(const char* data, qint64 len)
+{
+  qint64 written = 0;
+  while (written < len)
+  {
+    const qint64 n = std::min(len - written, qint64(chunk_size) - m_chunkSize);
+    std::memcpy(m_chunk.data() + m_chunkSize, data + written, n);
+    m_chunkSize += n;
+    written += n;
+
+    if (m_chunkSize == chunk_size && !writeChunk(false))
+      return -1;
+  }
+  return written;
+}
+
+bool ChunkedFileWriter::writeChunk(bool last)
+{
+  // The index is used as seed so that swapped chunks are detected
+  const ChunkHeader h{
+      quint32(m_chunkSize),
+      last ? LastChunk : 0u,
+      xxh64(m_chunk.constData(), m_chunkSize, m_index)};
+
+  m_ok = m_ok
+         && m_out.write(reinterpret_cast<const char*>(&h), sizeof(h))
+                == sizeof(h)
+         && m_out.write(m_chunk.constData(), m_chunkSize) == m_chunkSize;
+
+  m_chunkSize = 0;
+  m_index++;
+  return m_ok;
+}
+
+ChunkedFileReader::ChunkedFileReader(const char* data, qint64 size)
+    : m_data{data}
+    , m_size{size}
+{
+}
+
+ChunkedFileReader::~ChunkedFileReader()
+{
+  close();
+}
+
+bool ChunkedFileReader::isChunked(const char* data, qint64 size) noexcept
+{
+  if (size < qint64(sizeof(FileHeader)))
+    return false;
+
+  FileHeader h;
+  std::memcpy(&h, data, sizeof(h));
+  return h.magic == chunked_magic;
+}
+
+bool ChunkedFileReader::verify()
+{
+  if (!isChunked(m_data, m_size))
+    return false;
+
+  FileHeader h;
+  std::memcpy(&h, m_data, sizeof(h));
+  if (h.version != chunked_version || h.chunkSize > max_chunk_size)
+    return false;
+
+  qint64 pos = sizeof(FileHeader);
+  qint64 payload = 0;
+  for (quint64 index = 0;; index++)
+  {
+    ChunkHeader c;
+    if (m_size - pos < qint64(sizeof(c)))
+      return false;
+    std::memcpy(&c, m_data + pos, sizeof(c));
+    pos += sizeof(c);
+
+    if (c.size > h.chunkSize || m_size - pos < qint64(c.size))
+      return false;
+    if (xxh64(m_data + pos, c.size, index) != c.checksum)
+      return false;
+
+    pos += c.size;
+    payload += c.size;
+
+    if (c.flags & LastChunk)
+      break;
+  }
+
+  if (pos != m_size)
+    return false;
+
+  m_next = sizeof(FileHeader);
+  m_cur = nullptr;
+  m_remaining = 0;
+  m_payload = payload;
+  m_read = 0;
+  m_last = false;
+  return open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+qint64 ChunkedFileReader::bytesAvailable() const
+{
+  return m_payload - m_read + QIODevice::bytesAvailable();
+}
+
+bool ChunkedFileReader::nextChunk() noexcept
+{
+  if (m_last)
+    return false;
+
+  // Bounds and checksums were checked in verify()
+  ChunkHeader c;
+  std::memcpy(&c, m_data + m_next, sizeof(c));
+  m_cur = m_data + m_next + sizeof(c);
+  m_remaining = c.size;
+  m_last = c.flags & LastChunk;
+  m_next += sizeof(c) + c.size;
+  return true;
+}
+
+qint64 ChunkedFileReader::readData(char* data, qint64 maxlen)
+{
+  qint64 read = 0;
+  while (read < maxlen)
+  {
+    if (m_remaining == 0 && !nextChunk())
+      break;
+
+    const qint64 n = std::min(maxlen - read, m_remaining);
+    std::memcpy(data + read, m_cur, n);
+    m_cur += n;
+    m_remaining -= n;
+    read += n;
+  }
+
+  m_read += read;
+  return read;
+}
+
+qint64 ChunkedFileReader::writeData(const char*, qint64)
+{
+  return -1;
+}
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <QByteArray>
+#include <QIODevice>
+
+#include <score_lib_base_export.h>
+
+namespace score
+{
+/**
+ * @brief Writes a binary document as a sequence of checksummed chunks.
+ *
+ * The data written to this device is cut in chunks of at most 1 MiB,
+ * each preceded by its size and its xxHash64, and written as soon as the
+ * chunk is full: saving never needs a copy of the whole document in memory.
+ *
+ * finish() must be called once everything has been written:
+ * a file without its last chunk is considered truncated when loading.
+ */
+class SCORE_LIB_BASE_EXPORT ChunkedFileWriter final : public QIODevice
+{
+public:
+  explicit ChunkedFileWriter(QIODevice& out);
+  ~ChunkedFileWriter() override;
+
+  //! Writes the last chunk.
+  //! Returns false if writing to the underlying device failed.
+  bool finish();
+
+  bool isSequential() const override { return true; }
+
+protected:
+  qint64 readData(char* data, qint64 maxlen) override;
+  qint64 writeData(const char* data, qint64 len) override;
+
+private:
+  bool writeChunk(bool last);
+
+  QIODevice& m_out;
+  QByteArray m_chunk;
+  qint64 m_chunkSize{};
+  quint64 m_index{};
+  bool m_ok{true};
+};
+
+/**
+ * @brief Reads a binary document written by ChunkedFileWriter.
+ *
+ * The data is read in-place, from a memory-mapped file or a byte array
+ * which must outlive the reader.
+ * verify() checks every chunk before anything gets deserialized,
+ * so that a corrupted file is rejected as a whole.
+ */
+class SCORE_LIB_BASE_EXPORT ChunkedFileReader final : public QIODevice
+{
+public:
+  ChunkedFileReader(const char* data, qint64 size);
+  ~ChunkedFileReader() override;
+
+  //! Whether the data starts like a chunked file.
+  static bool isChunked(const char* data, qint64 size) noexcept;
+
+  //! Checks the structure and the checksums of all the chunks,
+  //! and opens the device if they are correct.
+  bool verify();
+
+  bool isSequential() const override { return true; }
+  qint64 bytesAvailable() const override;
+
+protected:
+  qint64 readData(char* data, qint64 maxlen) override;
+  qint64 writeData(const char* data, qint64 len) override;
+
+private:
+  bool nextChunk() noexcept;
+
+  const char* m_data{};
+  qint64 m_size{};
+
+  // Offset of the next chunk header
+  qint64 m_next{};
+
+  // Part of the current chunk which has not been read yet
+  const char* m_cur{};
+  qint64 m_remaining{};
+
+  qint64 m_payload{};
+  qint64 m_read{};
+  bool m_last{};
+};
+}
@@ -16,6 +16,7 @@
 
 #include <verdigris>
 
+class QIODevice;
 class QObject;
 class QWidget;
 namespace score
@@ -80,6 +81,10 @@ public:
   QByteArray saveDocumentModelAsByteArray();
 
   void saveAsJson(JSONObject::Serializer& writer);
+
+  //! Streams the document to a device in the chunked binary format.
+  //! Returns false if writing failed.
+  bool saveAsBinary(QIODevice& out);
   QByteArray saveAsByteArray();
 
   void setBackupMgr(DocumentBackupManager* backupMgr);
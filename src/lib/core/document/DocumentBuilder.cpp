@@ -9,6 +9,7 @@
 #include <score/tools/RandomNameProvider.hpp>
 #include <score/widgets/MessageBox.hpp>
 
+#include <core/application/CommandBackupFile.hpp>
 #include <core/command/CommandStackSerialization.hpp>
 #include <core/document/Document.hpp>
 #include <core/document/DocumentBackupManager.hpp>
@@ -200,24 +201,32 @@ Document* DocumentBuilder::restoreDocument(
     doclist.push_back(doc);
 
     // We restore the pre-crash command stack.
-    DataStream::Deserializer writer(cmdData);
-    loadCommandStack(
-        ctx.components,
-        writer,
-        doc->commandStack(),
-        [doc](score::Command* cmd) {
-          try
-          {
-            cmd->redo(doc->context());
-            return true;
-          }
-          catch (...)
-          {
-            qDebug() << "Error while replaying: "
-                     << cmd->key().toString().c_str() << cmd->description();
-            return false;
-          }
-        });
+    auto replay = [doc](score::Command* cmd) {
+      try
+      {
+        cmd->redo(doc->context());
+        return true;
+      }
+      catch (...)
+      {
+        qDebug() << "Error while replaying: "
+                 << cmd->key().toString().c_str() << cmd->description();
+        return false;
+      }
+    };
+
+    std::vector<score::CommandData> undoStack, redoStack;
+    if (CommandBackupFile::read(cmdData, undoStack, redoStack))
+    {
+      loadCommandStack(
+          ctx.components, undoStack, redoStack, doc->commandStack(), replay);
+    }
+    else
+    {
+      // Backup written by an older version
+      DataStream::Deserializer writer(cmdData);
+      loadCommandStack(ctx.components, writer, doc->commandStack(), replay);
+    }
 
     return doc;
   }
@@ -1,5 +1,6 @@
 // This is an open source non-commercial project. Dear PVS-Studio, please check
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "ChunkedFile.hpp"
 #include "Document.hpp"
 #include "DocumentModel.hpp"
 
@@ -23,6 +24,7 @@
 #include <core/presenter/DocumentManager.hpp>
 
 #include <QApplication>
+#include <QBuffer>
 #include <QByteArray>
 #include <QCryptographicHash>
 #include <QDataStream>
@@ -93,51 +95,49 @@ void Document::saveAsJson(JSONObject::Serializer& writer)
   m_commandStack.markCurrentIndexAsSaved();
 }
 
-QByteArray Document::saveAsByteArray()
+bool Document::saveAsBinary(QIODevice& out)
 {
-  using namespace std;
-  QByteArray global;
-  QDataStream writer(&global, QIODevice::WriteOnly);
-
-  // Save the document
-  auto docByteArray = saveDocumentModelAsByteArray();
-
-  // Save the document plug-ins
-  QVector<QPair<QByteArray, QByteArray>> documentPluginModels;
+  ChunkedFileWriter file{out};
+  DataStream::Serializer s{&file};
 
+  // Save the document plug-ins first: they are needed to load the document
+  std::vector<SerializableDocumentPlugin*> plugins;
   for (const auto& plugin : model().pluginModels())
   {
     if (auto serializable_plugin
         = qobject_cast<SerializableDocumentPlugin*>(plugin))
     {
-      //static_assert(
-      //    is_identified_object<SerializableDocumentPlugin>::value, "");
-      //static_assert(
-      //    (is_identified_object<SerializableDocumentPlugin>::value
-      //     && !is_entity<SerializableDocumentPlugin>::value
-      //     && is_abstract_base<SerializableDocumentPlugin>::value
-      //     && !is_custom_serialized<SerializableDocumentPlugin>::value),
-      //    "");
       static_assert(
           (is_abstract_base<SerializableDocumentPlugin>::value
            && !is_custom_serialized<SerializableDocumentPlugin>::value),
           "");
-      QByteArray arr_before, arr_after;
-      DataStream::Serializer s_before{&arr_before};
-      s_before.readFrom(*serializable_plugin);
-      documentPluginModels.push_back(
-          {std::move(arr_before), std::move(arr_after)});
+      plugins.push_back(serializable_plugin);
     }
   }
 
-  writer << docByteArray << documentPluginModels;
+  s.stream() << int32_t(plugins.size());
+  for (auto plugin : plugins)
+    s.readFrom(*plugin);
 
-  auto hash = QCryptographicHash::hash(
-      global, QCryptographicHash::Algorithm::Sha512);
-  writer << hash;
+  // Save the document
+  TSerializer<DataStream, IdentifiedObject<DocumentDelegateModel>>::readFrom(
+      s, m_model->modelDelegate());
+  m_model->modelDelegate().serialize(s.toVariant());
+
+  if (!file.finish())
+    return false;
 
   // Indicate in the stack that the current position is saved
   m_commandStack.markCurrentIndexAsSaved();
+  return true;
+}
+
+QByteArray Document::saveAsByteArray()
+{
+  QByteArray global;
+  QBuffer buf{&global};
+  buf.open(QIODevice::WriteOnly);
+  saveAsBinary(buf);
   return global;
 }
 
@@ -320,6 +320,39 @@ void DocumentModel::loadDocumentAsByteArray(
     const QByteArray& data,
     DocumentDelegateFactory& fact)
 {
+  if (ChunkedFileReader::isChunked(data.constData(), data.size()))
+  {
+    ChunkedFileReader file{data.constData(), data.size()};
+    if (!file.verify())
+      throw std::runtime_error("Invalid file.");
+
+    DataStream::Deserializer doc_writer{&file};
+    this->setId(getStrongId(ctx.app.documents.documents()));
+
+    // Same order as below: the plugin models, then the document model
+    int32_t plug_n{};
+    doc_writer.stream() >> plug_n;
+
+    auto& plugin_factories = ctx.app.interfaces<DocumentPluginFactoryList>();
+    for (int i = 0; i < plug_n; i++)
+    {
+      auto plug
+          = deserialize_interface(plugin_factories, doc_writer, ctx, this);
+      if (plug)
+      {
+        this->addPluginModel(plug);
+      }
+      else
+      {
+        SCORE_TODO;
+      }
+    }
+
+    fact.load(doc_writer.toVariant(), ctx, m_model, this);
+    return;
+  }
+
+  // Format of the files saved before the chunked one.
   // Deserialize the first parts
   QByteArray doc;
   QVector<QPair<QByteArray, QByteArray>> documentPluginModels;
@@ -164,5 +164,5 @@
  * The available decoders are then listed in VideoNodeRenderer::createGpuDecoder() ;
  * the AVFormat / fourcc is used to create the correct decoder for the input format.
  *
- * See for instance score::gfx::YUV420Decoder for an example of GPU decoding of tri-planar YUV420 video.
+ * See for instance score::gfx::PlanarYUVDecoder for an example of GPU decoding of planar YUV video.
  */
@@ -115,6 +115,47 @@ static QDir getDialogDirectory(score::Document* current)
   return {};
 }
 
+//! Only replaces the file if the whole document could be written
+static bool writeDocument(
+    score::Document& doc,
+    const QString& savename,
+    QWidget* parent)
+{
+  QSaveFile f{savename};
+  bool ok = f.open(QIODevice::WriteOnly);
+  if (ok)
+  {
+    if (savename.indexOf(".scorebin") != -1)
+    {
+      ok = doc.saveAsBinary(f);
+    }
+    else
+    {
+      JSONReader w;
+      w.buffer.Reserve(1024 * 1024 * 16);
+      doc.saveAsJson(w);
+
+      ok = f.write(w.buffer.GetString(), w.buffer.GetSize())
+           == qint64(w.buffer.GetSize());
+    }
+  }
+
+  if (ok)
+    ok = f.commit();
+  else
+    f.cancelWriting();
+
+  if (!ok)
+  {
+    score::warning(
+        parent,
+        QObject::tr("Error"),
+        QObject::tr("Could not save the document to %1:\n%2")
+            .arg(savename)
+            .arg(f.errorString()));
+  }
+  return ok;
+}
 }
 
 namespace score
@@ -323,23 +364,12 @@ bool DocumentManager::saveDocument(Document& doc)
 
   if (savename.indexOf(tr("Untitled")) == 0)
   {
-    saveDocumentAs(doc);
+    return saveDocumentAs(doc);
   }
   else if (savename.size() != 0)
   {
-    QSaveFile f{savename};
-    f.open(QIODevice::WriteOnly);
-    if (savename.indexOf(".scorebin") != -1)
-      f.write(doc.saveAsByteArray());
-    else
-    {
-      JSONReader w;
-      w.buffer.Reserve(1024 * 1024 * 16);
-      doc.saveAsJson(w);
-
-      f.write(w.buffer.GetString(), w.buffer.GetSize());
-    }
-    f.commit();
+    if (!writeDocument(doc, savename, m_view))
+      return false;
 
     m_recentFiles->addRecentFile(savename);
     saveRecentFilesState();
@@ -384,20 +414,14 @@ bool DocumentManager::saveDocumentAs(Document& doc)
           savename += ".score";
       }
 
-      QSaveFile f{savename};
-      f.open(QIODevice::WriteOnly);
+      // Set first as the document may save paths relative to its file
+      const auto previous_name = doc.metadata().fileName();
       doc.metadata().setFileName(savename);
-      if (savename.indexOf(".scorebin") != -1)
-        f.write(doc.saveAsByteArray());
-      else
+      if (!writeDocument(doc, savename, m_view))
       {
-        JSONReader w;
-        w.buffer.Reserve(1024 * 1024 * 16);
-        doc.saveAsJson(w);
-
-        f.write(w.buffer.GetString(), w.buffer.GetSize());
+        doc.metadata().setFileName(previous_name);
+        return false;
       }
-      f.commit();
 
       m_recentFiles->addRecentFile(savename);
       saveRecentFilesState();
@@ -3,7 +3,11 @@
 
 #include <ossia/detail/algorithms.hpp>
 
+#include <cstddef>
+#include <iterator>
 #include <list>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 /**
@@ -46,13 +50,282 @@ int index_of_child(const std::list<T>& list, const T* child)
   return -1;
 }
 
+template <typename Node, bool Const>
+class TreeNodeIterator
+{
+  using base_type = std::conditional_t<
+      Const,
+      const std::unique_ptr<Node>*,
+      std::unique_ptr<Node>*>;
+
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = Node;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::conditional_t<Const, const Node&, Node&>;
+  using pointer = std::conditional_t<Const, const Node*, Node*>;
+
+  TreeNodeIterator() noexcept = default;
+  explicit TreeNodeIterator(base_type it) noexcept
+      : m_it{it}
+  {
+  }
+
+  template <bool C = Const, std::enable_if_t<C, int> = 0>
+  TreeNodeIterator(const TreeNodeIterator<Node, false>& other) noexcept
+      : m_it{other.base()}
+  {
+  }
+
+  base_type base() const noexcept { return m_it; }
+
+  reference operator*() const noexcept { return **m_it; }
+  pointer operator->() const noexcept { return m_it->get(); }
+  reference operator[](difference_type n) const noexcept { return *m_it[n]; }
+
+  TreeNodeIterator& operator++() noexcept
+  {
+    ++m_it;
+    return *this;
+  }
+  TreeNodeIterator operator++(int) noexcept { return TreeNodeIterator{m_it++}; }
+  TreeNodeIterator& operator--() noexcept
+  {
+    --m_it;
+    return *this;
+  }
+  TreeNodeIterator operator--(int) noexcept { return TreeNodeIterator{m_it--}; }
+
+  TreeNodeIterator& operator+=(difference_type n) noexcept
+  {
+    m_it += n;
+    return *this;
+  }
+  TreeNodeIterator& operator-=(difference_type n) noexcept
+  {
+    m_it -= n;
+    return *this;
+  }
+
+  friend TreeNodeIterator
+  operator+(TreeNodeIterator it, difference_type n) noexcept
+  {
+    return it += n;
+  }
+  friend TreeNodeIterator
+  operator+(difference_type n, TreeNodeIterator it) noexcept
+  {
+    return it += n;
+  }
+  friend TreeNodeIterator
+  operator-(TreeNodeIterator it, difference_type n) noexcept
+  {
+    return it -= n;
+  }
+  friend difference_type
+  operator-(const TreeNodeIterator& lhs, const TreeNodeIterator& rhs) noexcept
+  {
+    return lhs.m_it - rhs.m_it;
+  }
+
+  friend bool
+  operator==(const TreeNodeIterator& lhs, const TreeNodeIterator& rhs) noexcept
+  {
+    return lhs.m_it == rhs.m_it;
+  }
+  friend bool
+  operator!=(const TreeNodeIterator& lhs, const TreeNodeIterator& rhs) noexcept
+  {
+    return lhs.m_it != rhs.m_it;
+  }
+  friend bool
+  operator<(const TreeNodeIterator& lhs, const TreeNodeIterator& rhs) noexcept
+  {
+    return lhs.m_it < rhs.m_it;
+  }
+  friend bool
+  operator>(const TreeNodeIterator& lhs, const TreeNodeIterator& rhs) noexcept
+  {
+    return lhs.m_it > rhs.m_it;
+  }
+  friend bool
+  operator<=(const TreeNodeIterator& lhs, const TreeNodeIterator& rhs) noexcept
+  {
+    return lhs.m_it <= rhs.m_it;
+  }
+  friend bool
+  operator>=(const TreeNodeIterator& lhs, const TreeNodeIterator& rhs) noexcept
+  {
+    return lhs.m_it >= rhs.m_it;
+  }
+
+private:
+  base_type m_it{};
+};
+
+/**
+ * @brief Storage of the children of a TreeNode.
+ *
+ * Each child is allocated separately so that pointers to nodes
+ * (e.g. in QModelIndex::internalPointer) stay valid when siblings are added
+ * or removed, while indexing is a lookup in an array.
+ * Each child also knows its row, which is kept up-to-date on insertion
+ * and removal: finding the index of a child does not need a search.
+ */
+template <typename Node>
+class TreeNodeChildren
+{
+  using impl_type = std::vector<std::unique_ptr<Node>>;
+
+public:
+  using value_type = Node;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = Node&;
+  using const_reference = const Node&;
+  using iterator = TreeNodeIterator<Node, false>;
+  using const_iterator = TreeNodeIterator<Node, true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  TreeNodeChildren() noexcept = default;
+  TreeNodeChildren(const TreeNodeChildren& other)
+  {
+    m_impl.reserve(other.size());
+    for (const auto& child : other.m_impl)
+      m_impl.push_back(std::make_unique<Node>(*child));
+    renumber(0);
+  }
+  TreeNodeChildren(TreeNodeChildren&& other) noexcept = default;
+
+  TreeNodeChildren& operator=(const TreeNodeChildren& other)
+  {
+    TreeNodeChildren copy{other};
+    m_impl.swap(copy.m_impl);
+    return *this;
+  }
+  TreeNodeChildren& operator=(TreeNodeChildren&& other) noexcept = default;
+
+  iterator begin() noexcept { return iterator{m_impl.data()}; }
+  iterator end() noexcept { return iterator{m_impl.data() + m_impl.size()}; }
+  const_iterator begin() const noexcept { return cbegin(); }
+  const_iterator end() const noexcept { return cend(); }
+  const_iterator cbegin() const noexcept
+  {
+    return const_iterator{m_impl.data()};
+  }
+  const_iterator cend() const noexcept
+  {
+    return const_iterator{m_impl.data() + m_impl.size()};
+  }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator{end()}; }
+  reverse_iterator rend() noexcept { return reverse_iterator{begin()}; }
+  const_reverse_iterator rbegin() const noexcept
+  {
+    return const_reverse_iterator{end()};
+  }
+  const_reverse_iterator rend() const noexcept
+  {
+    return const_reverse_iterator{begin()};
+  }
+
+  size_type size() const noexcept { return m_impl.size(); }
+  bool empty() const noexcept { return m_impl.empty(); }
+  void reserve(size_type s) { m_impl.reserve(s); }
+
+  Node& operator[](size_type i) noexcept { return *m_impl[i]; }
+  const Node& operator[](size_type i) const noexcept { return *m_impl[i]; }
+  Node& at(size_type i) noexcept
+  {
+    SCORE_ASSERT(i < m_impl.size());
+    return *m_impl[i];
+  }
+  const Node& at(size_type i) const noexcept
+  {
+    SCORE_ASSERT(i < m_impl.size());
+    return *m_impl[i];
+  }
+
+  Node& front() noexcept { return *m_impl.front(); }
+  const Node& front() const noexcept { return *m_impl.front(); }
+  Node& back() noexcept { return *m_impl.back(); }
+  const Node& back() const noexcept { return *m_impl.back(); }
+
+  template <typename... Args>
+  Node& emplace_back(Args&&... args)
+  {
+    auto& n = *m_impl.emplace_back(
+        std::make_unique<Node>(std::forward<Args>(args)...));
+    n.m_row = int(m_impl.size()) - 1;
+    return n;
+  }
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args)
+  {
+    const auto row = pos - cbegin();
+    m_impl.insert(
+        m_impl.begin() + row,
+        std::make_unique<Node>(std::forward<Args>(args)...));
+    renumber(row);
+    return begin() + row;
+  }
+
+  iterator insert(const_iterator pos, const Node& n) { return emplace(pos, n); }
+  iterator insert(const_iterator pos, Node&& n)
+  {
+    return emplace(pos, std::move(n));
+  }
+
+  iterator erase(const_iterator pos)
+  {
+    const auto row = pos - cbegin();
+    m_impl.erase(m_impl.begin() + row);
+    renumber(row);
+    return begin() + row;
+  }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    const auto row = first - cbegin();
+    m_impl.erase(m_impl.begin() + row, m_impl.begin() + (last - cbegin()));
+    renumber(row);
+    return begin() + row;
+  }
+
+  void resize(size_type s)
+  {
+    const auto old = m_impl.size();
+    m_impl.resize(s);
+    for (auto i = old; i < s; i++)
+      m_impl[i] = std::make_unique<Node>();
+    renumber(old);
+  }
+
+  void clear() noexcept { m_impl.clear(); }
+
+private:
+  void renumber(std::size_t from) noexcept
+  {
+    for (std::size_t i = from; i < m_impl.size(); i++)
+      m_impl[i]->m_row = int(i);
+  }
+
+  impl_type m_impl;
+};
+
 template <typename DataType>
 class TreeNode : public DataType
 {
 private:
+  friend class TreeNodeChildren<TreeNode>;
   TreeNode* m_parent{};
-  std::list<TreeNode> m_children;
-  using impl_type = std::list<TreeNode>;
+
+  // Row of this node in its parent, maintained by TreeNodeChildren
+  int m_row{};
+  TreeNodeChildren<TreeNode> m_children;
+  using impl_type = TreeNodeChildren<TreeNode>;
 
 public:
   using iterator = typename impl_type::iterator;
@@ -87,6 +360,7 @@ public:
       child.setParent(this);
   }
 
+  // The row is the one of the assigned node, not the one of the source.
   TreeNode& operator=(const TreeNode& source) noexcept
   {
     static_cast<DataType&>(*this) = static_cast<const DataType&>(source);
@@ -130,26 +404,20 @@ public:
 
   void push_back(const TreeNode& child) noexcept
   {
-    m_children.push_back(child);
-
-    auto& cld = m_children.back();
+    auto& cld = m_children.emplace_back(child);
     cld.setParent(this);
   }
 
   void push_back(TreeNode&& child) noexcept
   {
-    m_children.push_back(std::move(child));
-
-    auto& cld = m_children.back();
+    auto& cld = m_children.emplace_back(std::move(child));
     cld.setParent(this);
   }
 
   template <typename... Args>
   auto& emplace_back(Args&&... args) noexcept
   {
-    m_children.emplace_back(std::forward<Args>(args)...);
-
-    auto& cld = m_children.back();
+    auto& cld = m_children.emplace_back(std::forward<Args>(args)...);
     cld.setParent(this);
     return cld;
   }
@@ -177,28 +445,34 @@ public:
     return m_children.size() > index;
   }
 
-  TreeNode& childAt(int index) noexcept { return child_at(m_children, index); }
+  TreeNode& childAt(int index) noexcept
+  {
+    SCORE_ASSERT(index >= 0 && index < (int)m_children.size());
+    return m_children[index];
+  }
 
   const TreeNode& childAt(int index) const noexcept
   {
-    return child_at(m_children, index);
+    SCORE_ASSERT(index >= 0 && index < (int)m_children.size());
+    return m_children[index];
   }
 
   // returns -1 if not found
   int indexOfChild(const TreeNode* child) const noexcept
   {
-    return index_of_child(m_children, child);
+    if (!child)
+      return -1;
+
+    const int row = child->m_row;
+    if (row >= 0 && row < (int)m_children.size() && &m_children[row] == child)
+      return row;
+    return -1;
   }
 
   auto iterOfChild(const TreeNode* child) noexcept
   {
-    const auto end = m_children.end();
-    for (auto it = m_children.begin(); it != end; ++it)
-    {
-      if (&*it == child)
-        return it;
-    }
-    return end;
+    const int row = indexOfChild(child);
+    return row != -1 ? m_children.begin() + row : m_children.end();
   }
 
   int childCount() const noexcept { return m_children.size(); }
@@ -206,11 +480,13 @@ public:
   bool hasChildren() const noexcept { return !m_children.empty(); }
 
   const auto& children() const noexcept { return m_children; }
-  void reserve(std::size_t s) noexcept
+  void reserve(std::size_t s) noexcept { m_children.reserve(s); }
+  void resize(std::size_t s) noexcept
   {
-    // m_children.reserve(s);
+    m_children.resize(s);
+    for (auto& child : m_children)
+      child.setParent(this);
   }
-  void resize(std::size_t s) noexcept { m_children.resize(s); }
 
   auto erase(const_iterator it) noexcept { return m_children.erase(it); }
 
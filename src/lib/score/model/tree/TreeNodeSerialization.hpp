@@ -25,6 +25,8 @@ struct TSerializer<DataStream, TreeNode<T>>
 
     int childCount;
     s.stream() >> childCount;
+    if (childCount > 0)
+      n.reserve(childCount);
     for (int i = 0; i < childCount; ++i)
     {
       TreeNode<T> child;
@@ -36,6 +38,11 @@ struct TSerializer<DataStream, TreeNode<T>>
   }
 };
 
+template <typename T>
+struct TSerializer<JSONObject, TreeNodeChildren<T>> : ArraySerializer
+{
+};
+
 template <typename T>
 struct TSerializer<JSONObject, TreeNode<T>>
 {
@@ -58,6 +65,7 @@ struct TSerializer<JSONObject, TreeNode<T>>
     if (it != s.obj.constEnd())
     {
       const auto& children = it->toArray();
+      n.reserve(children.size());
       for (const auto& val : children)
       {
         TreeNode<T> child;
@@ -0,0 +1,105 @@
+#include <score/tools/CacheFolder.hpp>
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+
+#include <algorithm>
+#include <vector>
+
+namespace score
+{
+bool writeCacheFile(
+    const QString& path,
+    const std::function<bool(const QString& tmp_path)>& write)
+{
+  // The same file may be written by two threads or two processes at once
+  const QString tmp_path
+      = QStringLiteral("%1.%2.%3.tmp")
+            .arg(path)
+            .arg(QCoreApplication::applicationPid())
+            .arg(quintptr(QThread::currentThreadId()));
+
+  if (!write(tmp_path))
+  {
+    QFile::remove(tmp_path);
+    return false;
+  }
+
+  // QFile::rename does not overwrite
+  QFile::remove(path);
+  if (!QFile::rename(tmp_path, path))
+  {
+    QFile::remove(tmp_path);
+    return false;
+  }
+  return true;
+}
+
+bool touchCacheFile(const QString& path)
+{
+  // setFileTime only works on an open file, with write access on Windows
+  if (!QFile::exists(path))
+    return false;
+
+  QFile f{path};
+  if (!f.open(QIODevice::ReadWrite)
+      || !f.setFileTime(
+          QDateTime::currentDateTime(), QFileDevice::FileModificationTime))
+  {
+    qDebug() << "Cannot update the use time of" << path << f.errorString();
+    return false;
+  }
+  return true;
+}
+
+void evictCacheFolder(
+    const QString& folder,
+    const QStringList& filters,
+    qint64 max_size)
+{
+  if (folder.isEmpty())
+    return;
+
+  struct entry
+  {
+    QString path;
+    QDateTime used;
+    qint64 size;
+  };
+  std::vector<entry> entries;
+  qint64 total = 0;
+
+  QDirIterator it{folder, filters, QDir::Files};
+  while (it.hasNext())
+  {
+    it.next();
+    const auto info = it.fileInfo();
+    entries.push_back(
+        {info.absoluteFilePath(), info.lastModified(), info.size()});
+    total += info.size();
+  }
+
+  if (total <= max_size)
+    return;
+
+  // Oldest-used files first
+  std::sort(entries.begin(), entries.end(), [](const entry& lhs, const entry& rhs) {
+    return lhs.used < rhs.used;
+  });
+
+  // Go back to 3/4 of the maximum size to not evict at every launch
+  for (const auto& e : entries)
+  {
+    if (total <= max_size * 3 / 4)
+      break;
+    if (QFile::remove(e.path))
+      total -= e.size;
+  }
+}
+}
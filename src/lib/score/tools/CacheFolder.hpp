@@ -0,0 +1,38 @@
+#pragma once
+#include <QString>
+#include <QStringList>
+
+#include <score_lib_base_export.h>
+
+#include <functional>
+
+/**
+ * Helpers for the folders in which score keeps data computed from other
+ * files: baked shaders, waveforms, decoded audio...
+ *
+ * Such a folder may be shared by several instances of score and the player:
+ * files are written under a temporary name then renamed, so that a partial
+ * file is never read. The modification time of a file is the last time it
+ * was used, which is how evictCacheFolder chooses the files to remove.
+ */
+namespace score
+{
+//! Calls write with a temporary path, then moves the written file to path.
+//! The temporary file is removed if write returns false.
+SCORE_LIB_BASE_EXPORT
+bool writeCacheFile(
+    const QString& path,
+    const std::function<bool(const QString& tmp_path)>& write);
+
+//! Records that a cache file was just used.
+SCORE_LIB_BASE_EXPORT
+bool touchCacheFile(const QString& path);
+
+//! Removes the least recently used files of a cache folder to bring it back
+//! to three quarters of max_size once it goes over it.
+SCORE_LIB_BASE_EXPORT
+void evictCacheFolder(
+    const QString& folder,
+    const QStringList& filters,
+    qint64 max_size);
+}
@@ -1,11 +1,41 @@
 #pragma once
+#include <QRunnable>
 #include <QThread>
+#include <QThreadPool>
 
 #include <score_lib_base_export.h>
 
+#include <functional>
 #include <memory>
 namespace score
 {
+/**
+ * @brief Runs a function on a QThreadPool.
+ *
+ * Same as QThreadPool::start(std::function<void()>), which needs Qt 5.15.
+ */
+inline void
+startOnPool(QThreadPool& pool, std::function<void()> f, int priority = 0)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+  pool.start(std::move(f), priority);
+#else
+  struct Task final : QRunnable
+  {
+    explicit Task(std::function<void()> f)
+        : func{std::move(f)}
+    {
+      setAutoDelete(true);
+    }
+
+    void run() override { func(); }
+
+    std::function<void()> func;
+  };
+  pool.start(new Task{std::move(f)}, priority);
+#endif
+}
+
 class SCORE_LIB_BASE_EXPORT ThreadPool
 {
 public:
@@ -417,7 +417,7 @@ void DeviceInterface::updateAddress(
           auto it = m_callbacks.find(currentAddr);
           if (it != m_callbacks.end())
           {
-            it->second.first->remove_callback(it->second.second);
+            it->second.parameter->remove_callback(it->second.callback);
             m_callbacks.erase(it);
           }
 
@@ -457,7 +457,7 @@ void DeviceInterface::removeListening_impl(
   auto it = m_callbacks.find(addr);
   if (it != m_callbacks.end())
   {
-    it->second.first->remove_callback(it->second.second);
+    it->second.parameter->remove_callback(it->second.callback);
     m_callbacks.erase(it);
   }
 
@@ -479,7 +479,7 @@ void DeviceInterface::removeListening_impl(
   auto it = m_callbacks.find(addr);
   if (it != m_callbacks.end())
   {
-    it->second.first->remove_callback(it->second.second);
+    it->second.parameter->remove_callback(it->second.callback);
     m_callbacks.erase(it);
     vec.push_back(addr);
   }
@@ -529,14 +529,23 @@ void DeviceInterface::renameListening_impl(
   // Put things back after renaming
   for (auto&& p : std::move(saved_elts))
   {
-    p.second.first->replace_callback(
-        p.second.second, [this, addr = p.first](const ossia::value& val) {
-          valueUpdated(addr, val);
-        });
+    // The address of a slot never changes as it may be read concurrently
+    p.second.slot = std::make_shared<ListeningTable::Slot>(p.first);
+    p.second.parameter->replace_callback(
+        p.second.callback, listeningCallback(p.second.slot));
     m_callbacks.insert(std::move(p));
   }
 }
 
+ossia::value_callback
+DeviceInterface::listeningCallback(const ListeningTable::slot_ptr& slot) noexcept
+{
+  return [this, slot](const ossia::value& val) {
+    m_listeningTable.push(slot, val);
+    valueUpdated(slot->address, val);
+  };
+}
+
 namespace
 {
 struct in_sink final : public spdlog::sinks::sink
@@ -832,7 +841,7 @@ void DeviceInterface::setListening(const State::Address& addr, bool b)
     }
     else
     {
-      ossia_addr = cb_it->second.first;
+      ossia_addr = cb_it->second.parameter;
       if (!ossia_addr)
       {
         m_callbacks.erase(cb_it);
@@ -846,24 +855,31 @@ void DeviceInterface::setListening(const State::Address& addr, bool b)
     // and the address wasn't already listening
     if (b)
     {
+      ListeningTable::slot_ptr slot;
       if (cb_it == m_callbacks.end())
       {
+        slot = std::make_shared<ListeningTable::Slot>(addr);
         m_callbacks.insert(
             {addr,
              {ossia_addr,
-              ossia_addr->add_callback([=](const ossia::value& val) {
-                valueUpdated(addr, val);
-              })}});
+              ossia_addr->add_callback(listeningCallback(slot)),
+              slot}});
+      }
+      else
+      {
+        slot = cb_it->second.slot;
       }
 
-      valueUpdated(addr, ossia_addr->value());
+      const auto val = ossia_addr->value();
+      m_listeningTable.push(slot, val);
+      valueUpdated(addr, val);
     }
     else
     {
       // If we can disable listening
       if (cb_it != m_callbacks.end())
       {
-        ossia_addr->remove_callback(cb_it->second.second);
+        ossia_addr->remove_callback(cb_it->second.callback);
         m_callbacks.erase(cb_it);
       }
     }
@@ -886,6 +902,15 @@ std::vector<State::Address> DeviceInterface::listening() const
   return addrs;
 }
 
+uint32_t
+DeviceInterface::droppedListeningUpdates(const State::Address& addr) const
+{
+  auto it = m_callbacks.find(addr);
+  if (it == m_callbacks.end())
+    return 0;
+  return it->second.slot->dropped.load(std::memory_order_relaxed);
+}
+
 void DeviceInterface::addToListening(
     const std::vector<State::Address>& addresses)
 {
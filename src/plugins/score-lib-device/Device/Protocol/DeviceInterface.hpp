@@ -1,6 +1,7 @@
 #pragma once
 #include <Device/Node/DeviceNode.hpp>
 #include <Device/Protocol/DeviceSettings.hpp>
+#include <Device/Protocol/ListeningTable.hpp>
 
 #include <ossia-qt/device_metatype.hpp>
 #include <ossia/detail/callback_container.hpp>
@@ -94,6 +95,19 @@ public:
   void addToListening(const std::vector<State::Address>&);
   std::vector<State::Address> listening() const;
 
+  //! Calls f(address, value) with the latest value of each listened
+  //! address which changed since the previous call.
+  //! To be called from the GUI thread, at the rate it refreshes.
+  template <typename F>
+  void drainListening(F&& f)
+  {
+    m_listeningTable.drain(std::forward<F>(f));
+  }
+
+  //! Number of values of a listened address which were replaced
+  //! by a newer one before drainListening() could see them.
+  uint32_t droppedListeningUpdates(const State::Address&) const;
+
   virtual void addAddress(const Device::FullAddressSettings&);
   virtual void updateAddress(
       const State::Address& currentAddr,
@@ -124,6 +138,8 @@ public:
   void addressUpdated(const ossia::net::node_base&, ossia::string_view key);
   void addressRemoved(const ossia::net::parameter_base& addr);
 
+  //! Sent for every value received on a listened address,
+  //! from the thread of the protocol. For the GUI, use drainListening().
   Nano::Signal<void(const State::Address&, const ossia::value&)> valueUpdated;
 
 public:
@@ -160,10 +176,14 @@ protected:
   Device::DeviceSettings m_settings;
   DeviceCapas m_capas;
 
-  using callback_pair = std::pair<
-      ossia::net::parameter_base*,
-      ossia::callback_container<ossia::value_callback>::iterator>;
+  struct callback_pair
+  {
+    ossia::net::parameter_base* parameter{};
+    ossia::callback_container<ossia::value_callback>::iterator callback;
+    ListeningTable::slot_ptr slot;
+  };
   score::hash_map<State::Address, callback_pair> m_callbacks;
+  ListeningTable m_listeningTable;
 
   void removeListening_impl(ossia::net::node_base& node, State::Address addr);
   void removeListening_impl(
@@ -173,6 +193,8 @@ protected:
   void
   renameListening_impl(const State::Address& parent, const QString& newName);
   void setLogging_impl(DeviceLogging) const;
+  ossia::value_callback
+  listeningCallback(const ListeningTable::slot_ptr& slot) noexcept;
   void enableCallbacks();
   void disableCallbacks();
 
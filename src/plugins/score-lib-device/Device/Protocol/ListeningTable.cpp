@@ -0,0 +1,49 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "ListeningTable.hpp"
+
+namespace Device
+{
+ListeningTable::Slot::Slot(State::Address addr)
+    : address{std::move(addr)}
+{
+}
+
+ListeningTable::Slot::~Slot()
+{
+  delete latest.load();
+  delete spare.load();
+}
+
+ListeningTable::ListeningTable() = default;
+ListeningTable::~ListeningTable() = default;
+
+void ListeningTable::push(const slot_ptr& slot, const ossia::value& v) noexcept
+{
+  auto box = slot->spare.exchange(nullptr, std::memory_order_acquire);
+  if (box)
+    *box = v;
+  else
+    box = new ossia::value{v};
+
+  auto previous = slot->latest.exchange(box, std::memory_order_acq_rel);
+  if (previous)
+  {
+    // The GUI did not see the previous value: it is replaced by this one.
+    slot->dropped.fetch_add(1, std::memory_order_relaxed);
+    recycle(*slot, previous);
+  }
+  else
+  {
+    m_dirty.enqueue(slot);
+  }
+}
+
+void ListeningTable::recycle(Slot& slot, ossia::value* v) noexcept
+{
+  ossia::value* expected = nullptr;
+  if (!slot.spare.compare_exchange_strong(
+          expected, v, std::memory_order_release))
+    delete v;
+}
+}
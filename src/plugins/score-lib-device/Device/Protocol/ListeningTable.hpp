@@ -0,0 +1,84 @@
+#pragma once
+#include <State/Address.hpp>
+
+#include <ossia/network/value/value.hpp>
+
+#include <concurrentqueue.h>
+#include <score_lib_device_export.h>
+
+#include <atomic>
+#include <memory>
+
+namespace Device
+{
+/**
+ * @brief Latest value received for each listened address.
+ *
+ * The network threads only replace the value of an address; the GUI
+ * periodically drains the addresses which changed since its last visit.
+ * Thus when a sensor sends a thousand messages per second, the GUI still
+ * gets at most one update per address and per refresh, and the messages
+ * in-between are only counted.
+ *
+ * An address is queued when it goes from "no pending value" to
+ * "pending value", so the queue never holds more than one entry per address.
+ */
+class SCORE_LIB_DEVICE_EXPORT ListeningTable
+{
+public:
+  struct SCORE_LIB_DEVICE_EXPORT Slot
+  {
+    explicit Slot(State::Address addr);
+    ~Slot();
+    Slot(const Slot&) = delete;
+    Slot& operator=(const Slot&) = delete;
+
+    const State::Address address;
+
+    //! Value not yet seen by the GUI
+    std::atomic<ossia::value*> latest{};
+
+    //! Storage reused between updates, so that no allocation happens
+    //! once the address has received a few values
+    std::atomic<ossia::value*> spare{};
+
+    //! Values which were replaced before the GUI could see them
+    std::atomic<uint32_t> dropped{};
+  };
+  using slot_ptr = std::shared_ptr<Slot>;
+
+  ListeningTable();
+  ~ListeningTable();
+
+  //! Called from the network threads
+  void push(const slot_ptr& slot, const ossia::value& v) noexcept;
+
+  //! Called from the GUI thread.
+  //! f(const State::Address&, const ossia::value&) is called once per
+  //! address which received a value since the previous drain.
+  template <typename F>
+  void drain(F&& f)
+  {
+    slot_ptr slots[64];
+    std::size_t n{};
+    while ((n = m_dirty.try_dequeue_bulk(slots, 64)) > 0)
+    {
+      for (std::size_t i = 0; i < n; i++)
+      {
+        auto& slot = *slots[i];
+        if (auto v = slot.latest.exchange(nullptr, std::memory_order_acquire))
+        {
+          f(slot.address, *v);
+          recycle(slot, v);
+        }
+        slots[i].reset();
+      }
+    }
+  }
+
+private:
+  static void recycle(Slot& slot, ossia::value* v) noexcept;
+
+  moodycamel::ConcurrentQueue<slot_ptr> m_dirty;
+};
+}
@@ -0,0 +1,69 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "ControlMailbox.hpp"
+
+#include <algorithm>
+
+namespace Execution
+{
+ControlMailbox::~ControlMailbox() = default;
+
+ControlMailboxes::ControlMailboxes()
+    : m_capacity{256}
+{
+  m_mailboxes.reserve(m_capacity);
+}
+
+ControlMailboxes::~ControlMailboxes() = default;
+
+ControlMailboxes::storage_type ControlMailboxes::prepareAdd()
+{
+  storage_type storage;
+  if (++m_count > m_capacity)
+  {
+    m_capacity *= 2;
+    storage.reserve(m_capacity);
+  }
+  return storage;
+}
+
+void ControlMailboxes::prepareRemove() noexcept
+{
+  if (m_count > 0)
+    --m_count;
+}
+
+void ControlMailboxes::grow(storage_type& storage) noexcept
+{
+  for (auto& mb : m_mailboxes)
+    storage.push_back(std::move(mb));
+  std::swap(storage, m_mailboxes);
+}
+
+void ControlMailboxes::add(std::shared_ptr<ControlMailbox> mb) noexcept
+{
+  // prepareAdd made sure that this fits in the reserved storage
+  m_mailboxes.push_back(std::move(mb));
+}
+
+void ControlMailboxes::remove(const ControlMailbox* mb) noexcept
+{
+  // The command which removes the mailbox holds another reference to it,
+  // which it sends back to the GUI thread: it is never freed here.
+  auto it = std::find_if(
+      m_mailboxes.begin(), m_mailboxes.end(), [mb](const auto& ptr) {
+        return ptr.get() == mb;
+      });
+  if (it != m_mailboxes.end())
+  {
+    std::swap(*it, m_mailboxes.back());
+    m_mailboxes.pop_back();
+  }
+}
+
+void ControlMailboxes::clear() noexcept
+{
+  m_mailboxes.clear();
+  m_count = 0;
+}
+}
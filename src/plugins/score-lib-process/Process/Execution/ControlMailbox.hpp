@@ -0,0 +1,140 @@
+#pragma once
+#include <score_lib_process_export.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Execution
+{
+/**
+ * @brief Latest value of a control, written by the GUI and read by the
+ * execution thread.
+ *
+ * This is a triple buffer: the writer and the reader each own a buffer
+ * and swap it with the middle one, so neither ever waits for the other and
+ * values which are not trivially copyable (strings, ossia::value...) are
+ * supported. Intermediate values written between two reads are skipped.
+ */
+template <typename T>
+class ControlSlot
+{
+public:
+  //! GUI thread
+  void write(T v) noexcept(std::is_nothrow_move_assignable_v<T>)
+  {
+    m_buffers[m_back] = std::move(v);
+    m_back = m_middle.exchange(m_back | dirty, std::memory_order_acq_rel)
+             & index_mask;
+  }
+
+  //! Execution thread.
+  //! Returns the value written since the previous read, if any.
+  //! The value may be moved from.
+  T* read() noexcept
+  {
+    if (!(m_middle.load(std::memory_order_relaxed) & dirty))
+      return nullptr;
+
+    m_front = m_middle.exchange(m_front, std::memory_order_acq_rel)
+              & index_mask;
+    return &m_buffers[m_front];
+  }
+
+private:
+  static constexpr uint8_t index_mask = 0b011;
+  static constexpr uint8_t dirty = 0b100;
+
+  T m_buffers[3]{};
+  std::atomic<uint8_t> m_middle{1};
+  uint8_t m_back{0};
+  uint8_t m_front{2};
+};
+
+/**
+ * @brief Controls of a process, sent from the GUI to the execution thread.
+ *
+ * Moving a control used to enqueue one command per change on the
+ * execution queue; a mailbox instead keeps the latest value of each
+ * control and is read once per tick, so that it can neither grow nor
+ * overflow the queue.
+ *
+ * Implementations keep a ControlSlot per control, write to it and call
+ * markDirty() from the GUI thread, and apply the slots which changed in
+ * applyControls().
+ */
+class SCORE_LIB_PROCESS_EXPORT ControlMailbox
+{
+public:
+  virtual ~ControlMailbox();
+
+  //! Execution thread, at the beginning of a tick
+  void apply() noexcept
+  {
+    if (m_dirty.exchange(false, std::memory_order_acquire))
+      applyControls();
+  }
+
+protected:
+  //! GUI thread, after a slot was written
+  void markDirty() noexcept { m_dirty.store(true, std::memory_order_release); }
+
+  virtual void applyControls() noexcept = 0;
+
+private:
+  std::atomic_bool m_dirty{};
+};
+
+/**
+ * @brief The mailboxes of the processes currently executing.
+ *
+ * Only accessed from the execution thread: mailboxes are added and
+ * removed through the execution queue,
+ * see ProcessComponent::setControlMailbox.
+ *
+ * The storage never allocates in the execution thread: the GUI thread
+ * counts the mailboxes it sends and provides larger storage beforehand
+ * when they would not fit anymore.
+ */
+class SCORE_LIB_PROCESS_EXPORT ControlMailboxes
+{
+public:
+  using storage_type = std::vector<std::shared_ptr<ControlMailbox>>;
+
+  ControlMailboxes();
+  ~ControlMailboxes();
+
+  //! GUI thread, before sending a mailbox to add.
+  //! Returns the storage to pass to grow() if the current one is full,
+  //! otherwise empty storage.
+  storage_type prepareAdd();
+
+  //! GUI thread, before sending a mailbox to remove
+  void prepareRemove() noexcept;
+
+  //! Execution thread: moves the mailboxes to the storage, which gets the
+  //! previous one in exchange so that it can be freed in the GUI thread.
+  void grow(storage_type& storage) noexcept;
+
+  void add(std::shared_ptr<ControlMailbox> mb) noexcept;
+  void remove(const ControlMailbox* mb) noexcept;
+
+  //! When the execution is not running
+  void clear() noexcept;
+
+  void apply() noexcept
+  {
+    for (const auto& mb : m_mailboxes)
+      mb->apply();
+  }
+
+private:
+  storage_type m_mailboxes;
+
+  // GUI thread
+  std::size_t m_count{};
+  std::size_t m_capacity{};
+};
+}
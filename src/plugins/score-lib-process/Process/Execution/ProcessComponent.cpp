@@ -29,8 +29,37 @@ ProcessComponent::ProcessComponent(
 {
 }
 
+void ProcessComponent::setControlMailbox(std::shared_ptr<ControlMailbox> mb)
+{
+  auto& mailboxes = this->system().controlMailboxes;
+  auto& gcQueue = this->system().gcQueue;
+  if (auto old = std::move(m_controlMailbox))
+  {
+    // The mailbox and what it refers to are released in the GUI thread
+    mailboxes.prepareRemove();
+    in_exec([&mailboxes, &gcQueue, old = std::move(old)]() mutable {
+      mailboxes.remove(old.get());
+      gcQueue.enqueue(gc(std::move(old)));
+    });
+  }
+
+  m_controlMailbox = std::move(mb);
+  if (m_controlMailbox)
+  {
+    if (auto storage = mailboxes.prepareAdd(); storage.capacity() > 0)
+    {
+      in_exec([&mailboxes, &gcQueue, storage = std::move(storage)]() mutable {
+        mailboxes.grow(storage);
+        gcQueue.enqueue(gc(std::move(storage)));
+      });
+    }
+    in_exec([&mailboxes, mb = m_controlMailbox] { mailboxes.add(mb); });
+  }
+}
+
 void ProcessComponent::cleanup()
 {
+  setControlMailbox({});
   if (const auto& proc = m_ossia_process)
   {
     this->system().setup.unregister_node(process(), proc->node);
@@ -1,4 +1,5 @@
 #pragma once
+#include <Process/Execution/ControlMailbox.hpp>
 #include <Process/ExecutionComponent.hpp>
 #include <Process/ExecutionContext.hpp>
 #include <Process/Process.hpp>
@@ -89,7 +90,12 @@ public:
           commands)
 
 protected:
+  //! Sets the mailbox through which the values of the controls are sent
+  //! to the execution thread, replacing the previous one if any.
+  void setControlMailbox(std::shared_ptr<ControlMailbox> mb);
+
   std::shared_ptr<ossia::time_process> m_ossia_process;
+  std::shared_ptr<ControlMailbox> m_controlMailbox;
 };
 
 template <typename Process_T, typename OSSIA_Process_T>
@@ -54,6 +54,7 @@ class ProcessModel;
 namespace Execution
 {
 class ProcessComponent;
+class ControlMailboxes;
 class ProcessComponentFactory;
 class ProcessComponentFactoryList;
 struct SetupContext;
@@ -103,6 +104,7 @@ struct SCORE_LIB_PROCESS_EXPORT Context
   ExecutionCommandQueue& executionQueue;
   EditionCommandQueue& editionQueue;
   GCCommandQueue& gcQueue;
+  ControlMailboxes& controlMailboxes;
   SetupContext& setup;
 
   const std::shared_ptr<ossia::graph_interface>& execGraph;
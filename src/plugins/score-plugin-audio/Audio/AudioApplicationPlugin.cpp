@@ -18,6 +18,7 @@
 #include <ossia/audio/audio_engine.hpp>
 #include <ossia/audio/audio_protocol.hpp>
 
+#include <QDebug>
 #include <QToolBar>
 
 #include <Scenario/Application/ScenarioActions.hpp>
@@ -43,6 +44,24 @@ void ApplicationPlugin::initialize()
 
   auto& engines = score::GUIAppContext().interfaces<Audio::AudioFactoryList>();
 
+  // A driver given on the command line, e.g. --audio-driver dummy
+  if (const auto& name = context.applicationSettings.audioDriver;
+      !name.isEmpty())
+  {
+    bool found = false;
+    for (Audio::AudioFactory& fact : engines)
+    {
+      if (fact.prettyName().startsWith(name, Qt::CaseInsensitive))
+      {
+        set.setDriver(fact.concreteKey());
+        found = true;
+        break;
+      }
+    }
+    if (!found)
+      qDebug() << "Unknown audio driver:" << name;
+  }
+
   if (auto dev = engines.get(set.getDriver()))
   {
     dev->initialize(set, this->context);
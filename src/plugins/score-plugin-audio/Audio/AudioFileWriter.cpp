@@ -0,0 +1,565 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "AudioFileWriter.hpp"
+
+#include <ossia/audio/drwav_handle.hpp>
+
+#include <QCryptographicHash>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Audio
+{
+class AudioFileWriter::Encoder
+{
+public:
+  virtual ~Encoder() = default;
+  virtual bool write(const float* const* channels, int64_t frames) = 0;
+  virtual bool finish() = 0;
+
+  QString error;
+};
+
+namespace
+{
+class WavEncoder final : public AudioFileWriter::Encoder
+{
+public:
+  WavEncoder(QFile& file, int channels, int rate)
+      : m_channels{channels}
+  {
+    drwav_data_format format;
+    format.container = drwav_container_riff;
+    format.format = DR_WAVE_FORMAT_IEEE_FLOAT;
+    format.channels = channels;
+    format.sampleRate = rate;
+    format.bitsPerSample = 32;
+
+    // The sizes in the header are written when closing,
+    // as the length is not known in advance.
+    m_init = drwav_init_write(
+        &m_wav,
+        &format,
+        onWrite,
+        onSeek,
+        &file,
+        &ossia::drwav_handle::drwav_allocs);
+    if (!m_init)
+      error = QObject::tr("Could not initialize the wav writer");
+  }
+
+  ~WavEncoder() override
+  {
+    if (m_init)
+      drwav_uninit(&m_wav);
+  }
+
+  bool write(const float* const* channels, int64_t frames) override
+  {
+    if (!m_init)
+      return false;
+
+    m_interleaved.resize(frames * m_channels);
+    for (int64_t i = 0; i < frames; i++)
+      for (int c = 0; c < m_channels; c++)
+        m_interleaved[i * m_channels + c] = channels[c][i];
+
+    return int64_t(drwav_write_pcm_frames(&m_wav, frames, m_interleaved.data()))
+           == frames;
+  }
+
+  bool finish() override
+  {
+    if (!m_init)
+      return false;
+
+    m_init = false;
+    return drwav_uninit(&m_wav) == DRWAV_SUCCESS;
+  }
+
+private:
+  static size_t onWrite(void* file, const void* data, size_t bytes)
+  {
+    auto res = static_cast<QFile*>(file)->write(
+        reinterpret_cast<const char*>(data), bytes);
+    return res < 0 ? 0 : res;
+  }
+
+  static drwav_bool32 onSeek(void* file, int offset, drwav_seek_origin origin)
+  {
+    auto& f = *static_cast<QFile*>(file);
+    const qint64 base = origin == drwav_seek_origin_current ? f.pos() : 0;
+    return f.seek(base + offset);
+  }
+
+  drwav m_wav{};
+  int m_channels{};
+  bool m_init{};
+  std::vector<float> m_interleaved;
+};
+
+//! Bits are written most significant first, as FLAC expects
+class BitWriter
+{
+public:
+  void put(uint64_t value, int bits)
+  {
+    for (int i = bits - 1; i >= 0; i--)
+    {
+      m_cur = (m_cur << 1) | ((value >> i) & 1);
+      if (++m_count == 8)
+        flush();
+    }
+  }
+
+  void putSigned(int64_t value, int bits)
+  {
+    put(uint64_t(value) & ((uint64_t(1) << bits) - 1), bits);
+  }
+
+  void putUnary(uint64_t zeros)
+  {
+    // Whole zero bytes while aligned, then bit by bit
+    while (zeros > 0 && m_count != 0)
+    {
+      put(0, 1);
+      zeros--;
+    }
+    m_bytes.insert(m_bytes.end(), zeros / 8, 0);
+    put(0, zeros % 8);
+    put(1, 1);
+  }
+
+  void align()
+  {
+    if (m_count != 0)
+      put(0, 8 - m_count);
+  }
+
+  void clear()
+  {
+    m_bytes.clear();
+    m_cur = 0;
+    m_count = 0;
+  }
+
+  const std::vector<uint8_t>& bytes() const noexcept { return m_bytes; }
+
+private:
+  void flush()
+  {
+    m_bytes.push_back(m_cur);
+    m_cur = 0;
+    m_count = 0;
+  }
+
+  std::vector<uint8_t> m_bytes;
+  uint8_t m_cur{};
+  int m_count{};
+};
+
+static uint8_t crc8(const uint8_t* data, std::size_t len) noexcept
+{
+  uint8_t crc = 0;
+  for (std::size_t i = 0; i < len; i++)
+  {
+    crc ^= data[i];
+    for (int b = 0; b < 8; b++)
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+  }
+  return crc;
+}
+
+static uint16_t crc16(const uint8_t* data, std::size_t len) noexcept
+{
+  uint16_t crc = 0;
+  for (std::size_t i = 0; i < len; i++)
+  {
+    crc ^= uint16_t(data[i]) << 8;
+    for (int b = 0; b < 8; b++)
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x8005 : (crc << 1);
+  }
+  return crc;
+}
+
+/**
+ * Minimal FLAC encoder: fixed-size blocks, independent channels,
+ * and for each subframe the best of the constant, verbatim and
+ * fixed-predictor (order 0 to 4) encodings, with a single Rice partition.
+ *
+ * This compresses less than the reference encoder at its higher settings,
+ * but is fast and has no dependency.
+ */
+class FlacEncoder final : public AudioFileWriter::Encoder
+{
+public:
+  static constexpr int block_size = 4096;
+  static constexpr int bits_per_sample = 24;
+
+  FlacEncoder(QFile& file, int channels, int rate)
+      : m_file{file}
+      , m_channels{channels}
+      , m_rate{rate}
+      , m_block(std::size_t(channels) * block_size)
+  {
+    if (channels < 1 || channels > 8)
+    {
+      error = QObject::tr("FLAC supports between 1 and 8 channels");
+      return;
+    }
+
+    if (!writeHeader())
+      error = QObject::tr("Could not write the FLAC header");
+  }
+
+  bool write(const float* const* channels, int64_t frames) override
+  {
+    if (!error.isEmpty())
+      return false;
+
+    int64_t read = 0;
+    while (read < frames)
+    {
+      const int64_t n = std::min(frames - read, int64_t(block_size - m_blockFrames));
+      for (int c = 0; c < m_channels; c++)
+      {
+        int32_t* out = m_block.data() + c * block_size + m_blockFrames;
+        const float* in = channels[c] + read;
+        for (int64_t i = 0; i < n; i++)
+          out[i] = toInt(in[i]);
+      }
+      m_blockFrames += n;
+      read += n;
+
+      if (m_blockFrames == block_size && !writeFrame())
+        return false;
+    }
+    return true;
+  }
+
+  bool finish() override
+  {
+    if (!error.isEmpty())
+      return false;
+    if (m_blockFrames > 0 && !writeFrame())
+      return false;
+
+    // Now that the length and checksum are known
+    m_digest = m_md5.result();
+    return m_file.seek(0) && writeHeader();
+  }
+
+private:
+  static int32_t toInt(float f) noexcept
+  {
+    // std::clamp lets NaN through, and lrint(NaN) is out of range
+    if (std::isnan(f))
+      return 0;
+    constexpr float scale = (1 << (bits_per_sample - 1)) - 1;
+    return std::lrint(std::clamp(f, -1.f, 1.f) * scale);
+  }
+
+  bool writeHeader()
+  {
+    BitWriter w;
+    w.put('f', 8);
+    w.put('L', 8);
+    w.put('a', 8);
+    w.put('C', 8);
+
+    // STREAMINFO, the last metadata block
+    w.put(1, 1);
+    w.put(0, 7);
+    w.put(34, 24);
+
+    w.put(block_size, 16);
+    w.put(block_size, 16);
+    w.put(m_minFrameSize == UINT32_MAX ? 0 : m_minFrameSize, 24);
+    w.put(m_maxFrameSize, 24);
+    w.put(m_rate, 20);
+    w.put(m_channels - 1, 3);
+    w.put(bits_per_sample - 1, 5);
+    w.put(m_totalFrames >> 32, 4);
+    w.put(m_totalFrames & 0xFFFFFFFF, 32);
+
+    // Left to zero, i.e. unknown, until the end
+    for (int i = 0; i < 16; i++)
+      w.put(m_digest.size() == 16 ? uint8_t(m_digest[i]) : 0, 8);
+
+    const auto& bytes = w.bytes();
+    return m_file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size())
+           == qint64(bytes.size());
+  }
+
+  int sampleRateCode() const noexcept
+  {
+    switch (m_rate)
+    {
+      case 88200: return 0b0001;
+      case 176400: return 0b0010;
+      case 192000: return 0b0011;
+      case 8000: return 0b0100;
+      case 16000: return 0b0101;
+      case 22050: return 0b0110;
+      case 24000: return 0b0111;
+      case 32000: return 0b1000;
+      case 44100: return 0b1001;
+      case 48000: return 0b1010;
+      case 96000: return 0b1011;
+      default: return 0b0000; // Read from STREAMINFO
+    }
+  }
+
+  void putFrameNumber(BitWriter& w, uint64_t n)
+  {
+    // "UTF-8" coding of the frame number
+    if (n < 0x80)
+    {
+      w.put(n, 8);
+      return;
+    }
+
+    int extra = 1;
+    while (n >= (uint64_t(1) << (6 + 5 * extra)))
+      extra++;
+
+    const int leading = 0xFF00 >> (extra + 1);
+    w.put((leading & 0xFF) | (n >> (6 * extra)), 8);
+    for (int i = extra - 1; i >= 0; i--)
+      w.put(0x80 | ((n >> (6 * i)) & 0x3F), 8);
+  }
+
+  bool writeFrame()
+  {
+    const int n = m_blockFrames;
+
+    updateChecksum(n);
+
+    auto& w = m_bits;
+    w.clear();
+    w.put(0xFFF8, 16); // Sync code, fixed block size
+    w.put(0b0111, 4);  // Block size in 16 bits after the header
+    w.put(sampleRateCode(), 4);
+    w.put(m_channels - 1, 4);
+    w.put(0b110, 3); // 24 bits per sample
+    w.put(0, 1);
+    putFrameNumber(w, m_frameNumber);
+    w.put(n - 1, 16);
+    w.put(crc8(w.bytes().data(), w.bytes().size()), 8);
+
+    for (int c = 0; c < m_channels; c++)
+      writeSubframe(w, m_block.data() + c * block_size, n);
+
+    w.align();
+    const uint16_t crc = crc16(w.bytes().data(), w.bytes().size());
+    w.put(crc, 16);
+
+    const auto& bytes = w.bytes();
+    if (m_file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size())
+        != qint64(bytes.size()))
+    {
+      error = m_file.errorString();
+      return false;
+    }
+
+    m_minFrameSize = std::min(m_minFrameSize, uint32_t(bytes.size()));
+    m_maxFrameSize = std::max(m_maxFrameSize, uint32_t(bytes.size()));
+    m_totalFrames += n;
+    m_frameNumber++;
+    m_blockFrames = 0;
+    return true;
+  }
+
+  void updateChecksum(int n)
+  {
+    // The MD5 of the interleaved samples, in little-endian
+    m_md5Buffer.resize(std::size_t(n) * m_channels * 3);
+    char* out = m_md5Buffer.data();
+    for (int i = 0; i < n; i++)
+    {
+      for (int c = 0; c < m_channels; c++)
+      {
+        const int32_t s = m_block[c * block_size + i];
+        *out++ = char(s & 0xFF);
+        *out++ = char((s >> 8) & 0xFF);
+        *out++ = char((s >> 16) & 0xFF);
+      }
+    }
+    m_md5.addData(m_md5Buffer.data(), m_md5Buffer.size());
+  }
+
+  static int64_t predict(const int32_t* s, int i, int order) noexcept
+  {
+    switch (order)
+    {
+      case 0: return 0;
+      case 1: return s[i - 1];
+      case 2: return 2 * int64_t(s[i - 1]) - s[i - 2];
+      case 3: return 3 * int64_t(s[i - 1]) - 3 * int64_t(s[i - 2]) + s[i - 3];
+      default:
+        return 4 * int64_t(s[i - 1]) - 6 * int64_t(s[i - 2])
+               + 4 * int64_t(s[i - 3]) - s[i - 4];
+    }
+  }
+
+  static uint64_t zigzag(int64_t v) noexcept
+  {
+    return v >= 0 ? uint64_t(v) << 1 : (uint64_t(-v) << 1) - 1;
+  }
+
+  void writeSubframe(BitWriter& w, const int32_t* s, int n)
+  {
+    if (std::all_of(s, s + n, [v = s[0]](int32_t x) { return x == v; }))
+    {
+      w.put(0b00000000, 8); // CONSTANT
+      w.putSigned(s[0], bits_per_sample);
+      return;
+    }
+
+    // Find the fixed predictor and Rice parameter giving the smallest size
+    uint64_t best_bits = uint64_t(n) * bits_per_sample; // VERBATIM
+    int best_order = -1;
+    int best_param = 0;
+    for (int order = 0; order <= std::min(4, n - 1); order++)
+    {
+      auto& res = m_residuals[order];
+      res.resize(n - order);
+      for (int i = order; i < n; i++)
+        res[i - order] = zigzag(s[i] - predict(s, i, order));
+
+      for (int k = 0; k < 15; k++)
+      {
+        uint64_t bits = order * bits_per_sample + 2 + 4 + 4;
+        for (uint64_t u : res)
+          bits += (u >> k) + 1 + k;
+
+        if (bits < best_bits)
+        {
+          best_bits = bits;
+          best_order = order;
+          best_param = k;
+        }
+      }
+    }
+
+    if (best_order < 0)
+    {
+      w.put(0b00000010, 8); // VERBATIM
+      for (int i = 0; i < n; i++)
+        w.putSigned(s[i], bits_per_sample);
+      return;
+    }
+
+    w.put(0, 1);
+    w.put(0b001000 | best_order, 6); // FIXED
+    w.put(0, 1);
+    for (int i = 0; i < best_order; i++)
+      w.putSigned(s[i], bits_per_sample);
+
+    w.put(0b00, 2); // Rice coding with 4-bit parameters
+    w.put(0, 4);    // A single partition
+    w.put(best_param, 4);
+    const uint64_t mask = (uint64_t(1) << best_param) - 1;
+    for (uint64_t u : m_residuals[best_order])
+    {
+      w.putUnary(u >> best_param);
+      w.put(u & mask, best_param);
+    }
+  }
+
+  QFile& m_file;
+  int m_channels{};
+  int m_rate{};
+
+  // Planar samples of the current block
+  std::vector<int32_t> m_block;
+  int m_blockFrames{};
+
+  uint64_t m_frameNumber{};
+  uint64_t m_totalFrames{};
+  uint32_t m_minFrameSize{UINT32_MAX};
+  uint32_t m_maxFrameSize{};
+
+  QCryptographicHash m_md5{QCryptographicHash::Md5};
+  QByteArray m_digest;
+  std::vector<char> m_md5Buffer;
+
+  BitWriter m_bits;
+  std::vector<uint64_t> m_residuals[5];
+};
+}
+
+std::optional<AudioFileWriter::Format>
+AudioFileWriter::formatForPath(const QString& path) noexcept
+{
+  const auto ext = QFileInfo{path}.suffix().toLower();
+  if (ext == QStringLiteral("wav"))
+    return Wav;
+  if (ext == QStringLiteral("flac"))
+    return Flac;
+  return std::nullopt;
+}
+
+AudioFileWriter::AudioFileWriter() = default;
+
+AudioFileWriter::~AudioFileWriter()
+{
+  close();
+}
+
+bool AudioFileWriter::open(
+    const QString& path,
+    Format format,
+    int channels,
+    int rate)
+{
+  close();
+  m_encoder.reset();
+
+  m_file.setFileName(path);
+  if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    return false;
+
+  switch (format)
+  {
+    case Wav:
+      m_encoder = std::make_unique<WavEncoder>(m_file, channels, rate);
+      break;
+    case Flac:
+      m_encoder = std::make_unique<FlacEncoder>(m_file, channels, rate);
+      break;
+  }
+
+  return m_encoder->error.isEmpty();
+}
+
+bool AudioFileWriter::write(const float* const* channels, int64_t frames)
+{
+  return m_encoder && m_encoder->write(channels, frames);
+}
+
+bool AudioFileWriter::close()
+{
+  if (!m_encoder)
+    return false;
+
+  const bool ok = m_encoder->finish();
+  if (ok)
+    m_encoder.reset();
+  else if (m_encoder->error.isEmpty())
+    m_encoder->error = m_file.errorString();
+
+  m_file.close();
+  return ok && m_file.error() == QFile::NoError;
+}
+
+QString AudioFileWriter::errorString() const
+{
+  if (m_encoder && !m_encoder->error.isEmpty())
+    return m_encoder->error;
+  return m_file.errorString();
+}
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <QFile>
+#include <QString>
+
+#include <score_plugin_audio_export.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace Audio
+{
+/**
+ * @brief Writes audio to a file block by block, as it gets rendered.
+ *
+ * - .wav files are written in 32-bit float.
+ * - .flac files are written in 24-bit, losslessly compressed.
+ */
+class SCORE_PLUGIN_AUDIO_EXPORT AudioFileWriter
+{
+public:
+  enum Format
+  {
+    Wav,
+    Flac
+  };
+
+  //! The format matching the extension of a path, if it is supported.
+  static std::optional<Format> formatForPath(const QString& path) noexcept;
+
+  AudioFileWriter();
+  ~AudioFileWriter();
+  AudioFileWriter(const AudioFileWriter&) = delete;
+  AudioFileWriter& operator=(const AudioFileWriter&) = delete;
+
+  bool open(const QString& path, Format format, int channels, int rate);
+
+  //! channels[c] points to frames samples of the channel c.
+  bool write(const float* const* channels, int64_t frames);
+
+  //! Writes what remains and updates the headers.
+  bool close();
+
+  QString errorString() const;
+
+  class Encoder;
+
+private:
+  QFile m_file;
+  std::unique_ptr<Encoder> m_encoder;
+};
+}
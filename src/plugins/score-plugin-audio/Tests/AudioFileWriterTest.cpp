@@ -0,0 +1,100 @@
+#include <Audio/AudioFileWriter.hpp>
+
+#include <QTemporaryDir>
+
+#define DR_FLAC_IMPLEMENTATION
+#include <dr_flac.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN 1
+#if __has_include(<catch2/catch.hpp>)
+#include <catch2/catch.hpp>
+
+namespace
+{
+// What the encoder stores for a sample, before dr_flac scales it to 32 bits
+int32_t expected24(float f)
+{
+  if (std::isnan(f))
+    return 0;
+  constexpr float scale = (1 << 23) - 1;
+  return std::lrint(std::clamp(f, -1.f, 1.f) * scale);
+}
+}
+
+TEST_CASE("flac_roundtrip", "[AudioFileWriter]")
+{
+  QTemporaryDir dir;
+  REQUIRE(dir.isValid());
+  const QString path = dir.filePath("roundtrip.flac");
+
+  constexpr int channels = 2;
+  constexpr int rate = 48000;
+  // Not a multiple of the block size: the last frame is partial
+  constexpr int64_t frames = 3 * 4096 + 1234;
+
+  // Silence, a sine and noise, so that the constant, fixed and verbatim
+  // encodings are used, and values the encoder has to sanitize
+  std::vector<float> left(frames), right(frames);
+  std::mt19937 rng{1234};
+  std::uniform_real_distribution<float> noise{-1.f, 1.f};
+  for (int64_t i = 0; i < frames; i++)
+  {
+    const double phase = 2. * 3.14159265358979 * 440. * i / rate;
+    left[i] = i < 4096 ? 0.f : 0.5f * std::sin(phase);
+    right[i] = noise(rng);
+  }
+  right[10] = 2.f;
+  right[11] = -2.f;
+  right[12] = std::numeric_limits<float>::quiet_NaN();
+  right[13] = std::numeric_limits<float>::infinity();
+
+  {
+    Audio::AudioFileWriter writer;
+    REQUIRE(writer.open(path, Audio::AudioFileWriter::Flac, channels, rate));
+
+    // Written in uneven chunks, as the offline render would
+    for (int64_t i = 0; i < frames;)
+    {
+      const int64_t n = std::min(int64_t(1000), frames - i);
+      const float* data[channels]{left.data() + i, right.data() + i};
+      REQUIRE(writer.write(data, n));
+      i += n;
+    }
+    REQUIRE(writer.close());
+  }
+
+  unsigned int readChannels{};
+  unsigned int readRate{};
+  drflac_uint64 readFrames{};
+  drflac_int32* samples = drflac_open_file_and_read_pcm_frames_s32(
+      path.toLocal8Bit().constData(),
+      &readChannels,
+      &readRate,
+      &readFrames,
+      nullptr);
+  REQUIRE(samples);
+
+  CHECK(readChannels == channels);
+  CHECK(readRate == rate);
+  CHECK(readFrames == frames);
+
+  // dr_flac left-aligns the 24-bit samples on 32 bits
+  int64_t mismatches = 0;
+  for (int64_t i = 0; i < std::min(int64_t(readFrames), frames); i++)
+  {
+    if (samples[i * channels + 0] != expected24(left[i]) * 256)
+      mismatches++;
+    if (samples[i * channels + 1] != expected24(right[i]) * 256)
+      mismatches++;
+  }
+  CHECK(mismatches == 0);
+
+  drflac_free(samples, nullptr);
+}
+#endif
@@ -3,6 +3,7 @@
 #include "AutomationExecution.hpp"
 
 #include <Curve/CurveConversion.hpp>
+#include <Curve/Settings/CurveSettingsModel.hpp>
 #include <Device/Protocol/DeviceInterface.hpp>
 #include <Process/ExecutionContext.hpp>
 #include <Process/ExecutionFunctions.hpp>
@@ -172,6 +173,9 @@ Component::on_curveChanged_impl(const std::optional<ossia::destination>& d)
   auto segt_data = process().curve().sortedSegments();
   if (segt_data.size() != 0)
   {
+    if (system().doc.app.settings<Curve::Settings::Model>().getBakeCurves())
+      return Engine::score_to_ossia::bakedCurve<double, Y_T>(
+          scale_x, scale_y, segt_data, d);
     return Engine::score_to_ossia::curve<double, Y_T>(
         scale_x, scale_y, segt_data, d);
   }
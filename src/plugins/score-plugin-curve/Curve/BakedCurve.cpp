@@ -0,0 +1,112 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "BakedCurve.hpp"
+
+#include <Curve/Segment/CurveSegmentModel.hpp>
+
+#include <algorithm>
+
+namespace Curve
+{
+BakedCurve BakedCurve::fromSegments(
+    const std::vector<SegmentModel*>& segments,
+    double tolerance)
+{
+  if (segments.empty())
+    return {};
+
+  std::vector<double> knots;
+  std::vector<ossia::curve_segment<double>> funs;
+  knots.reserve(segments.size() + 1);
+  funs.reserve(segments.size());
+
+  knots.push_back(segments.front()->start().x());
+  for (SegmentModel* segt : segments)
+  {
+    knots.push_back(segt->end().x());
+    funs.push_back(segt->makeDoubleFunction());
+  }
+
+  return bake(
+      [&](std::size_t k, double x) {
+        const SegmentModel& segt = *segments[k];
+        const auto start = segt.start();
+        const auto end = segt.end();
+        const double w = end.x() - start.x();
+        const double ratio = w > 0. ? (x - start.x()) / w : 1.;
+        return funs[k](ratio, start.y(), end.y());
+      },
+      knots,
+      tolerance);
+}
+
+void BakedCurve::push(double x, double y)
+{
+  m_x.push_back(x);
+  m_y.push_back(y);
+}
+
+void BakedCurve::finish()
+{
+  const std::size_t n = pieces();
+  m_slope.assign(m_x.size(), 0.);
+  for (std::size_t i = 0; i < n; i++)
+  {
+    const double w = m_x[i + 1] - m_x[i];
+    if (w > 0.)
+      m_slope[i] = (m_y[i + 1] - m_y[i]) / w;
+  }
+
+  m_index.clear();
+  m_indexScale = 0.;
+  if (n == 0)
+    return;
+
+  // About two buckets per piece, so that a lookup seldom has to walk
+  const std::size_t buckets = std::clamp<std::size_t>(2 * n, 1, 1 << 16);
+  m_indexScale = buckets / (end() - start());
+  m_index.resize(buckets);
+
+  std::size_t piece = 0;
+  for (std::size_t b = 0; b < buckets; b++)
+  {
+    const double x = start() + b / m_indexScale;
+    while (piece + 1 < n && x >= m_x[piece + 1])
+      piece++;
+    m_index[b] = piece;
+  }
+}
+
+void BakedCurve::scale(double factor, double offset) noexcept
+{
+  for (double& y : m_y)
+    y = y * factor + offset;
+  for (double& s : m_slope)
+    s *= factor;
+}
+
+std::size_t BakedCurve::pieceAt(double x) const noexcept
+{
+  const std::size_t n = pieces();
+  const std::size_t b = std::min(
+      std::size_t((x - start()) * m_indexScale), m_index.size() - 1);
+
+  std::size_t piece = m_index[b];
+  while (piece + 1 < n && x >= m_x[piece + 1])
+    piece++;
+  return piece;
+}
+
+double BakedCurve::valueAt(double x) const noexcept
+{
+  if (m_x.empty())
+    return 0.;
+  if (!(x > m_x.front()))
+    return m_y.front();
+  if (x >= m_x.back())
+    return m_y.back();
+
+  const std::size_t i = pieceAt(x);
+  return m_y[i] + m_slope[i] * (x - m_x[i]);
+}
+}
@@ -0,0 +1,143 @@
+#pragma once
+#include <score_plugin_curve_export.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Curve
+{
+class SegmentModel;
+
+/**
+ * @brief A curve flattened into linear pieces.
+ *
+ * The pieces are chosen adaptively so that they do not deviate from the
+ * original curve by more than a tolerance: straight segments cost a single
+ * piece while steep power or easing segments get finer ones.
+ *
+ * The piece containing a position is found in constant time through an
+ * index of uniform buckets.
+ */
+class SCORE_PLUGIN_CURVE_EXPORT BakedCurve
+{
+public:
+  BakedCurve() = default;
+
+  //! Bakes segments sorted by position, as given by Model::sortedSegments.
+  static BakedCurve
+  fromSegments(const std::vector<SegmentModel*>& segments, double tolerance);
+
+  /**
+   * Bakes a function known between consecutive knots:
+   * fun(k, x) is the value at x in [knots[k]; knots[k+1]].
+   * The function can jump at the knots.
+   */
+  template <typename F>
+  static BakedCurve
+  bake(const F& fun, const std::vector<double>& knots, double tolerance);
+
+  bool empty() const noexcept { return m_x.empty(); }
+  std::size_t pieces() const noexcept
+  {
+    return m_x.size() > 1 ? m_x.size() - 1 : 0;
+  }
+
+  double start() const noexcept { return m_x.empty() ? 0. : m_x.front(); }
+  double end() const noexcept { return m_x.empty() ? 0. : m_x.back(); }
+
+  //! Maps the values to value * factor + offset
+  void scale(double factor, double offset) noexcept;
+
+  //! The value at x, clamped to the first and last values outside the curve
+  double valueAt(double x) const noexcept;
+
+  //! The value at start() + ratio * (end() - start())
+  double valueAtRatio(double ratio) const noexcept
+  {
+    return valueAt(start() + ratio * (end() - start()));
+  }
+
+private:
+  void push(double x, double y);
+  void finish();
+  std::size_t pieceAt(double x) const noexcept;
+
+  // Breakpoints, and slope of the piece after each of them
+  std::vector<double> m_x;
+  std::vector<double> m_y;
+  std::vector<double> m_slope;
+
+  // First piece overlapping each bucket
+  std::vector<uint32_t> m_index;
+  double m_indexScale{};
+};
+
+template <typename F>
+BakedCurve BakedCurve::bake(
+    const F& fun,
+    const std::vector<double>& knots,
+    double tolerance)
+{
+  // Each linear piece is checked on a few interior points,
+  // and split in two until it is close enough to the function.
+  static constexpr int probes = 8;
+  static constexpr int max_depth = 16;
+
+  struct Span
+  {
+    double x0, y0, x1, y1;
+    int depth;
+  };
+
+  BakedCurve c;
+  std::vector<Span> stack;
+  for (std::size_t k = 0; k + 1 < knots.size(); k++)
+  {
+    const double a = knots[k];
+    const double b = knots[k + 1];
+    if (!(b > a))
+      continue;
+
+    const double ya = fun(k, a);
+    if (c.m_x.empty() || c.m_y.back() != ya)
+      c.push(a, ya);
+
+    stack.push_back({a, ya, b, fun(k, b), 0});
+    while (!stack.empty())
+    {
+      const Span s = stack.back();
+      stack.pop_back();
+
+      bool close = true;
+      if (s.depth < max_depth)
+      {
+        for (int i = 1; i < probes && close; i++)
+        {
+          const double t = double(i) / probes;
+          const double x = s.x0 + t * (s.x1 - s.x0);
+          const double lin = s.y0 + t * (s.y1 - s.y0);
+          close = std::abs(fun(k, x) - lin) <= tolerance;
+        }
+      }
+
+      if (close)
+      {
+        c.push(s.x1, s.y1);
+      }
+      else
+      {
+        // The left half is on top so that the breakpoints come in order
+        const double mid = 0.5 * (s.x0 + s.x1);
+        const double ymid = fun(k, mid);
+        stack.push_back({mid, ymid, s.x1, s.y1, s.depth + 1});
+        stack.push_back({s.x0, s.y0, mid, ymid, s.depth + 1});
+      }
+    }
+  }
+
+  c.finish();
+  return c;
+}
+}
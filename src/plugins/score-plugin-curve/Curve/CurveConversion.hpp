@@ -1,9 +1,12 @@
 #pragma once
+#include <Curve/BakedCurve.hpp>
 #include <Curve/Segment/Linear/LinearSegment.hpp>
 #include <Curve/Segment/Power/PowerSegment.hpp>
 
 #include <ossia/editor/curve/curve.hpp>
 
+#include <type_traits>
+
 namespace Engine
 {
 namespace score_to_ossia
@@ -69,6 +72,55 @@ std::shared_ptr<ossia::curve<X_T, Y_T>> curve(
   return curve;
 }
 
+/**
+ * Same as curve(), but the segments are baked into a single one
+ * which looks its value up in a Curve::BakedCurve.
+ *
+ * Curves which start from the current value of their address,
+ * or not from the beginning, are not baked.
+ */
+template <
+    typename X_T,
+    typename Y_T,
+    typename XScaleFun,
+    typename YScaleFun,
+    typename Segments>
+std::shared_ptr<ossia::curve<X_T, Y_T>> bakedCurve(
+    XScaleFun scale_x,
+    YScaleFun scale_y,
+    const Segments& segments,
+    const std::optional<ossia::destination>& tween,
+    double tolerance = 1e-4)
+{
+  auto start = segments[0]->start();
+  if constexpr (std::is_floating_point_v<Y_T>)
+  {
+    if (!tween && start.x() == 0.)
+    {
+      // The segments are in [0; 1] and the scaling of the values is affine
+      const double y0 = scale_y(0.);
+      const double y1 = scale_y(1.);
+      auto baked = std::make_shared<Curve::BakedCurve>(
+          Curve::BakedCurve::fromSegments(segments, tolerance));
+      baked->scale(y1 - y0, y0);
+      auto end = segments.back()->end();
+
+      auto curve = std::make_shared<ossia::curve<X_T, Y_T>>();
+      curve->set_x0(scale_x(start.x()));
+      curve->set_y0(scale_y(start.y()));
+      curve->add_point(
+          [baked](double ratio, Y_T, Y_T) {
+            return Y_T(baked->valueAtRatio(ratio));
+          },
+          scale_x(end.x()),
+          scale_y(end.y()));
+      return curve;
+    }
+  }
+
+  return score_to_ossia::curve<X_T, Y_T>(scale_x, scale_y, segments, tween);
+}
+
 // Simpler curve, between [0; 1]
 template <typename Segments>
 ossia::curve<double, float> floatCurve(
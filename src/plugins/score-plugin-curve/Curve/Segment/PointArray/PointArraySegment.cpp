@@ -204,6 +204,24 @@ void PointArraySegment::simplify(double ratio)
   }
 }
 
+void PointArraySegment::replacePointsBefore(
+    double x,
+    const std::vector<std::pair<double, double>>& pts)
+{
+  std::vector<std::pair<double, double>> after(
+      m_points.lower_bound(x), m_points.end());
+
+  // Inserting in order only appends
+  m_points.clear();
+  for (const auto& pt : pts)
+    m_points.insert(m_points.end(), pt);
+  for (const auto& pt : after)
+    m_points.insert(m_points.end(), pt);
+
+  m_valid = false;
+  dataChanged();
+}
+
 std::vector<SegmentData> PointArraySegment::toLinearSegments() const
 {
   std::vector<SegmentData> vec;
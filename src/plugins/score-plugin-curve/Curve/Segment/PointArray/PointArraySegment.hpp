@@ -81,6 +81,12 @@ public:
   void addPoint(double, double);
   void addPointUnscaled(double, double);
   void simplify(double ratio); // 10 is a good ratio
+
+  //! Replaces the points before x by pts, sorted and before x.
+  //! The min / max are left unchanged.
+  void replacePointsBefore(
+      double x,
+      const std::vector<std::pair<double, double>>& pts);
   std::vector<SegmentData> toLinearSegments() const;
   std::vector<SegmentData> toPowerSegments() const;
 
@@ -23,11 +23,18 @@ SETTINGS_PARAMETER_IMPL(CurveMode){
 SETTINGS_PARAMETER_IMPL(PlayWhileRecording){
     QStringLiteral("score_plugin_curve/PlayWhileRecording"),
     true};
+SETTINGS_PARAMETER_IMPL(BakeCurves){
+    QStringLiteral("score_plugin_curve/BakeCurves"),
+    false};
 
 static auto list()
 {
   return std::tie(
-      SimplificationRatio, Simplify, CurveMode, PlayWhileRecording);
+      SimplificationRatio,
+      Simplify,
+      CurveMode,
+      PlayWhileRecording,
+      BakeCurves);
 }
 }
 
@@ -40,5 +47,6 @@ SCORE_SETTINGS_PARAMETER_CPP(int, Model, SimplificationRatio)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, Simplify)
 SCORE_SETTINGS_PARAMETER_CPP(Curve::Settings::Mode, Model, CurveMode)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, PlayWhileRecording)
+SCORE_SETTINGS_PARAMETER_CPP(bool, Model, BakeCurves)
 }
 }
@@ -45,17 +45,20 @@ public:
       SCORE_PLUGIN_CURVE_EXPORT,
       bool,
       PlayWhileRecording)
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_CURVE_EXPORT, bool, BakeCurves)
 
 private:
   int m_SimplificationRatio{};
   bool m_Simplify = true;
   Mode m_CurveMode = Mode::Parameter;
   bool m_PlayWhileRecording{};
+  bool m_BakeCurves{};
 };
 
 SCORE_SETTINGS_PARAMETER(Model, SimplificationRatio)
 SCORE_SETTINGS_PARAMETER(Model, Simplify)
 SCORE_SETTINGS_PARAMETER(Model, CurveMode)
 SCORE_SETTINGS_PARAMETER(Model, PlayWhileRecording)
+SCORE_SETTINGS_PARAMETER(Model, BakeCurves)
 }
 }
@@ -97,6 +97,22 @@ Presenter::Presenter(Model& m, View& v, QObject* parent)
     // initial value
     v.setPlayWhileRecording(m.getPlayWhileRecording());
   }
+
+  {
+    // view -> model
+    con(v, &View::bakeCurvesChanged, this, [&](auto val) {
+      if (val != m.getBakeCurves())
+      {
+        m_disp.submit<SetModelBakeCurves>(this->model(this), val);
+      }
+    });
+
+    // model -> view
+    con(m, &Model::BakeCurvesChanged, &v, &View::setBakeCurves);
+
+    // initial value
+    v.setBakeCurves(m.getBakeCurves());
+  }
 }
 
 QString Presenter::settingsName()
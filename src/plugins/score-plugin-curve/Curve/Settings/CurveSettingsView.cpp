@@ -91,6 +91,29 @@ View::View()
 
     lay->addRow(m_playWhileRecording);
   }
+
+  {
+    m_bakeCurves = new QCheckBox{tr("Bake curves for playback")};
+    m_bakeCurves->setToolTip(
+        tr("Automations and mappings are converted to lookup tables "
+           "when played, which is faster for complex curves"));
+
+    connect(m_bakeCurves, &QCheckBox::stateChanged, this, [&](int t) {
+      switch (t)
+      {
+        case Qt::Unchecked:
+          bakeCurvesChanged(false);
+          break;
+        case Qt::Checked:
+          bakeCurvesChanged(true);
+          break;
+        default:
+          break;
+      }
+    });
+
+    lay->addRow(m_bakeCurves);
+  }
 }
 
 void View::setSimplificationRatio(int val)
@@ -150,6 +173,23 @@ void View::setPlayWhileRecording(bool b)
   }
 }
 
+void View::setBakeCurves(bool b)
+{
+  switch (m_bakeCurves->checkState())
+  {
+    case Qt::Unchecked:
+      if (b)
+        m_bakeCurves->setChecked(true);
+      break;
+    case Qt::Checked:
+      if (!b)
+        m_bakeCurves->setChecked(false);
+      break;
+    default:
+      break;
+  }
+}
+
 QWidget* View::getWidget()
 {
   return m_widg;
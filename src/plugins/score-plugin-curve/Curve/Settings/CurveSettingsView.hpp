@@ -26,6 +26,7 @@ public:
   void setSimplify(bool);
   void setMode(Mode);
   void setPlayWhileRecording(bool);
+  void setBakeCurves(bool);
 
 public:
   void simplificationRatioChanged(double arg_1)
@@ -36,6 +37,8 @@ public:
       E_SIGNAL(SCORE_PLUGIN_CURVE_EXPORT, modeChanged, arg_1);
   void playWhileRecordingChanged(bool arg_1)
       E_SIGNAL(SCORE_PLUGIN_CURVE_EXPORT, playWhileRecordingChanged, arg_1);
+  void bakeCurvesChanged(bool arg_1)
+      E_SIGNAL(SCORE_PLUGIN_CURVE_EXPORT, bakeCurvesChanged, arg_1);
 
 private:
   QWidget* getWidget() override;
@@ -45,6 +48,7 @@ private:
   QCheckBox* m_simpl{};
   QCheckBox* m_mode{};
   QCheckBox* m_playWhileRecording{};
+  QCheckBox* m_bakeCurves{};
 };
 }
 }
@@ -12,6 +12,7 @@
 #include <Explorer/DocumentPlugin/DeviceDocumentPluginFactory.hpp>
 #include <Explorer/DocumentPlugin/NodeUpdateProxy.hpp>
 #include <Explorer/Listening/ListeningHandlerFactoryList.hpp>
+#include <Explorer/Settings/ExplorerModel.hpp>
 #include <State/Address.hpp>
 
 #include <score/application/ApplicationContext.hpp>
@@ -37,9 +38,11 @@
 #include <QObject>
 #include <QPushButton>
 #include <QString>
+#include <QTimerEvent>
 
 #include <wobjectimpl.h>
 
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 W_OBJECT_IMPL(Explorer::DeviceDocumentPlugin)
@@ -93,6 +96,33 @@ void DeviceDocumentPlugin::init()
     }
   }};
 #endif
+
+  // The values received on listened addresses are shown in batches,
+  // instead of updating the tree for each message.
+  auto& settings = context().app.settings<Explorer::Settings::Model>();
+  setListeningRate(settings.getListeningRate());
+  con(settings,
+      &Explorer::Settings::Model::ListeningRateChanged,
+      this,
+      &DeviceDocumentPlugin::setListeningRate);
+}
+
+void DeviceDocumentPlugin::setListeningRate(int rate)
+{
+  if (m_listeningTimer != -1)
+    killTimer(m_listeningTimer);
+
+  m_listeningTimer = startTimer(1000. / std::clamp(rate, 1, 1000));
+}
+
+void DeviceDocumentPlugin::drainListening()
+{
+  m_list.apply([this](Device::DeviceInterface& dev) {
+    dev.drainListening(
+        [this](const State::Address& addr, const ossia::value& v) {
+          updateProxy.updateLocalValue(State::AddressAccessor{addr}, v);
+        });
+  });
 }
 
 void DeviceDocumentPlugin::asyncConnect(Device::DeviceInterface& newdev)
@@ -134,6 +164,12 @@ void DeviceDocumentPlugin::asyncConnect(Device::DeviceInterface& newdev)
 
 void DeviceDocumentPlugin::timerEvent(QTimerEvent* event)
 {
+  if (event->timerId() == m_listeningTimer)
+  {
+    drainListening();
+    return;
+  }
+
 #if defined(__EMSCRIPTEN__)
   if (m_processMessages)
   {
@@ -313,7 +349,6 @@ ListeningHandler& DeviceDocumentPlugin::listening() const
 void DeviceDocumentPlugin::initDevice(Device::DeviceInterface& newdev)
 {
   asyncConnect(newdev);
-  newdev.valueUpdated.connect<&DeviceDocumentPlugin::on_valueUpdated>(*this);
 
   setupConnections(newdev, true);
 
@@ -438,11 +473,4 @@ void DeviceDocumentPlugin::reconnect(const QString& device)
   }
 }
 
-void DeviceDocumentPlugin::on_valueUpdated(
-    const State::Address& addr,
-    const ossia::value& v)
-{
-  updateProxy.updateLocalValue(State::AddressAccessor{addr}, v);
-}
-
 }
@@ -80,7 +80,8 @@ public:
 
 private:
   void initDevice(Device::DeviceInterface&);
-  void on_valueUpdated(const State::Address& addr, const ossia::value& v);
+  void setListeningRate(int rate);
+  void drainListening();
 
   Device::Node m_rootNode;
   Device::DeviceList m_list;
@@ -95,6 +96,8 @@ private:
       std::vector<QMetaObject::Connection>>
       m_connections;
 
+  int m_listeningTimer{-1};
+
   void asyncConnect(Device::DeviceInterface& newdev);
   void timerEvent(QTimerEvent* event) override;
 
@@ -16,10 +16,13 @@ SETTINGS_PARAMETER_IMPL(LocalTree){
 SETTINGS_PARAMETER_IMPL(LogLevel){
     QStringLiteral("score_plugin_engine/LogLevel"),
     DeviceLogLevel{}.logEverything};
+SETTINGS_PARAMETER_IMPL(ListeningRate){
+    QStringLiteral("score_plugin_deviceexplorer/ListeningRate"),
+    30};
 
 static auto list()
 {
-  return std::tie(LocalTree, LogLevel);
+  return std::tie(LocalTree, LogLevel, ListeningRate);
 }
 }
 
@@ -30,6 +33,7 @@ Model::Model(QSettings& set, const score::ApplicationContext& ctx)
 
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, LocalTree)
 SCORE_SETTINGS_PARAMETER_CPP(QString, Model, LogLevel)
+SCORE_SETTINGS_PARAMETER_CPP(int, Model, ListeningRate)
 }
 
 namespace Explorer::ProjectSettings
@@ -25,6 +25,7 @@ class SCORE_PLUGIN_DEVICEEXPLORER_EXPORT Model
 
   bool m_LocalTree = false;
   QString m_LogLevel;
+  int m_ListeningRate = 30;
 
 public:
   Model(QSettings& set, const score::ApplicationContext& ctx);
@@ -37,9 +38,14 @@ public:
       SCORE_PLUGIN_DEVICEEXPLORER_EXPORT,
       QString,
       LogLevel)
+  SCORE_SETTINGS_PARAMETER_HPP(
+      SCORE_PLUGIN_DEVICEEXPLORER_EXPORT,
+      int,
+      ListeningRate)
 };
 
 SCORE_SETTINGS_PARAMETER(Model, LogLevel)
+SCORE_SETTINGS_PARAMETER(Model, ListeningRate)
 SCORE_SETTINGS_DEFERRED_PARAMETER(Model, LocalTree)
 }
 
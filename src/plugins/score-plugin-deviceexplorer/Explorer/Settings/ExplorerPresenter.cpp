@@ -25,6 +25,7 @@ Presenter::Presenter(Model& m, View& v, QObject* parent)
     : score::GlobalSettingsPresenter{m, v, parent}
 {
   SETTINGS_PRESENTER(LogLevel);
+  SETTINGS_PRESENTER(ListeningRate);
 
   con(v, &View::localTreeChanged, this, [&](auto val) {
     if (val != m.getLocalTree())
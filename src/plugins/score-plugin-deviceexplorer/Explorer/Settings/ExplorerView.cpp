@@ -9,6 +9,7 @@
 
 #include <QCheckBox>
 #include <QFormLayout>
+#include <QSpinBox>
 namespace Explorer::Settings
 {
 View::View()
@@ -18,6 +19,10 @@ View::View()
 
   SETTINGS_UI_COMBOBOX_SETUP("Log level", LogLevel, DeviceLogLevel{});
 
+  // Rate at which the values of the listened addresses are shown
+  SETTINGS_UI_SPINBOX_SETUP("Listening refresh rate (Hz)", ListeningRate);
+  m_ListeningRate->setRange(1, 1000);
+
   m_cb = new QCheckBox{tr("Enable local tree")};
   lay->addRow(m_cb);
 
@@ -38,6 +43,7 @@ QWidget* View::getWidget()
 }
 
 SETTINGS_UI_COMBOBOX_IMPL(LogLevel)
+SETTINGS_UI_SPINBOX_IMPL(ListeningRate)
 }
 
 namespace Explorer::ProjectSettings
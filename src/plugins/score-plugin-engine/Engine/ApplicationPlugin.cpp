@@ -3,14 +3,20 @@
 /// http://www.viva64.com
 #include "ApplicationPlugin.hpp"
 
+#include <Audio/AudioFileWriter.hpp>
+#include <Audio/Settings/Model.hpp>
 #include <Execution/DocumentPlugin.hpp>
+#include <Execution/OfflineRender.hpp>
+#include <Execution/TickMetrics.hpp>
 #include <Explorer/DocumentPlugin/DeviceDocumentPlugin.hpp>
 #include <Explorer/Settings/ExplorerModel.hpp>
 #include <LocalTree/LocalTreeDocumentPlugin.hpp>
 
 #include <score/actions/ActionManager.hpp>
+#include <score/actions/Menu.hpp>
 #include <score/actions/ToolbarManager.hpp>
 #include <score/tools/Bind.hpp>
+#include <score/widgets/MessageBox.hpp>
 #include <score/widgets/SetIcons.hpp>
 #include <score/widgets/TimeSpinBox.hpp>
 
@@ -20,8 +26,13 @@
 
 #include <ossia-qt/invoke.hpp>
 
+#include <QCoreApplication>
+#include <QFileDialog>
+#include <QFileInfo>
 #include <QLabel>
 #include <QMainWindow>
+#include <QMenu>
+#include <QProgressDialog>
 #include <QTabWidget>
 #include <QTimer>
 #include <QToolBar>
@@ -32,6 +43,9 @@
 #include <Scenario/Settings/ScenarioSettingsModel.hpp>
 #include <wobjectimpl.h>
 
+#include <ctime>
+#include <iostream>
+
 namespace Engine
 {
 ApplicationPlugin::ApplicationPlugin(const score::GUIApplicationContext& ctx)
@@ -62,6 +76,7 @@ bool ApplicationPlugin::handleStartup()
       // TODO what happens if we load multiple documents ?
       QTimer::singleShot(
           context.applicationSettings.waitAfterLoad * 1000, &m_execution, [=] {
+            prepareAutoplay();
             m_execution.request_play_local(true);
           });
       return true;
@@ -71,6 +86,52 @@ bool ApplicationPlugin::handleStartup()
   return false;
 }
 
+void ApplicationPlugin::prepareAutoplay()
+{
+  auto doc = currentDocument();
+  if (!doc)
+    return;
+
+  const auto& set = context.applicationSettings;
+  auto& plug = doc->context().plugin<Execution::DocumentPlugin>();
+  if (set.printMetrics)
+  {
+    m_tickMetrics = std::make_unique<Execution::TickMetrics>(
+        context.settings<Audio::Settings::Model>().getRate());
+    plug.registerAction(*m_tickMetrics);
+  }
+
+  if (set.playDuration > 0.)
+  {
+    QTimer::singleShot(
+        std::chrono::milliseconds(int64_t(set.playDuration * 1000.)),
+        &m_execution,
+        [this] { m_execution.request_stop(); });
+  }
+
+  const auto cpu_start = std::clock();
+  const auto wall_start = std::chrono::steady_clock::now();
+  con(plug,
+      &Execution::DocumentPlugin::finished,
+      this,
+      [this, cpu_start, wall_start] {
+        if (m_tickMetrics)
+        {
+          const double wall = std::chrono::duration<double>(
+                                  std::chrono::steady_clock::now() - wall_start)
+                                  .count();
+          const double cpu = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+          std::cout << m_tickMetrics->summary() << "process cpu: "
+                    << (wall > 0. ? 100. * cpu / wall : 0.) << " %"
+                    << std::endl;
+        }
+
+        if (context.applicationSettings.exitAfterPlay)
+          qApp->exit(0);
+      },
+      Qt::QueuedConnection);
+}
+
 void ApplicationPlugin::initialize()
 {
   // Update the clock widget
@@ -222,9 +283,95 @@ score::GUIElements ApplicationPlugin::makeGUIElements()
     }
   }
 
+  {
+    auto export_audio = new QAction{tr("Export audio..."), this};
+    export_audio->setStatusTip(
+        tr("Render the score to a .wav or .flac file, faster than realtime"));
+    connect(
+        export_audio,
+        &QAction::triggered,
+        this,
+        &ApplicationPlugin::exportAudio);
+
+    score::Menu& menu = context.menus.get().at(score::Menus::Export());
+    menu.menu()->addAction(export_audio);
+  }
+
   return e;
 }
 
+void ApplicationPlugin::exportAudio()
+{
+  auto doc = currentDocument();
+  if (!doc)
+    return;
+
+  auto scenar = dynamic_cast<Scenario::ScenarioDocumentModel*>(
+      &doc->model().modelDelegate());
+  auto plug = doc->context().findPlugin<Execution::DocumentPlugin>();
+  if (!scenar || !plug)
+    return;
+
+  if (plug->isPlaying())
+  {
+    score::warning(
+        context.documentTabWidget,
+        tr("Export audio"),
+        tr("Stop the playback before exporting."));
+    return;
+  }
+
+  auto path = QFileDialog::getSaveFileName(
+      context.documentTabWidget,
+      tr("Export audio"),
+      QString{},
+      tr("Audio files (*.wav *.flac)"));
+  if (path.isEmpty())
+    return;
+  if (!Audio::AudioFileWriter::formatForPath(path))
+    path.append(".wav");
+
+  auto& audio = context.settings<Audio::Settings::Model>();
+  Execution::OfflineRenderSettings settings;
+  settings.path = path;
+  settings.rate = audio.getRate();
+  settings.bufferSize = audio.getBufferSize();
+  settings.outputs = std::max(1, audio.getDefaultOut());
+
+  QProgressDialog progress{
+      tr("Rendering %1...").arg(QFileInfo{path}.fileName()),
+      tr("Cancel"),
+      0,
+      1000,
+      context.documentTabWidget};
+  progress.setWindowTitle(tr("Export audio"));
+  progress.setWindowModality(Qt::ApplicationModal);
+  progress.setMinimumDuration(0);
+
+  const auto res = Execution::renderOffline(
+      *plug, scenar->baseInterval(), settings, [&progress](double done) {
+        progress.setValue(int(done * progress.maximum()));
+        return !progress.wasCanceled();
+      });
+  progress.close();
+
+  if (res.canceled)
+    return;
+  if (!res.ok)
+  {
+    score::warning(context.documentTabWidget, tr("Export audio"), res.error);
+    return;
+  }
+
+  score::information(
+      context.documentTabWidget,
+      tr("Export audio"),
+      tr("Rendered %1 seconds in %2 seconds (%3x realtime).")
+          .arg(double(res.frames) / settings.rate, 0, 'f', 2)
+          .arg(std::chrono::duration<double>(res.renderTime).count(), 0, 'f', 2)
+          .arg(res.speed(settings.rate), 0, 'f', 1));
+}
+
 void ApplicationPlugin::on_initDocument(score::Document& doc)
 {
   score::addDocumentPlugin<LocalTree::DocumentPlugin>(doc);
@@ -23,6 +23,7 @@ namespace Execution
 struct Context;
 class Clock;
 class BaseScenarioElement;
+class TickMetrics;
 }
 
 namespace LocalTree
@@ -64,9 +65,15 @@ public:
   Execution::ExecutionController& execution() { return m_execution; }
 
 private:
+  //! Sets up what the command-line asks for around the autoplay:
+  //! duration, exit when stopped, metrics
+  void prepareAutoplay();
+  void exportAudio();
+
   Execution::PlayContextMenu m_playActions;
   Execution::ExecutionController m_execution;
 
   Scenario::SpeedWidget* m_speedSlider{};
+  std::unique_ptr<Execution::TickMetrics> m_tickMetrics;
 };
 }
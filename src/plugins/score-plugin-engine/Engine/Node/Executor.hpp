@@ -16,59 +16,78 @@
 
 namespace Control
 {
+template <typename T>
+struct control_slots;
+template <typename... T>
+struct control_slots<std::tuple<T...>>
+{
+  using type = std::tuple<Execution::ControlSlot<T>...>;
+};
+
+//! Latest value of each control of the node, applied at each tick
+template <typename Info_T, typename Node_T>
+class control_mailbox final : public Execution::ControlMailbox
+{
+public:
+  explicit control_mailbox(std::shared_ptr<Node_T> node)
+      : m_node{std::move(node)}
+  {
+  }
+
+  template <std::size_t Idx, typename T>
+  void write(T&& v)
+  {
+    std::get<Idx>(m_slots).write(std::forward<T>(v));
+    markDirty();
+  }
+
+private:
+  void applyControls() noexcept override
+  {
+    using namespace ossia::safe_nodes;
+    constexpr auto control_count = info_functions<Info_T>::control_count;
+    ossia::for_each_in_range<control_count>([this](auto idx_t) {
+      constexpr auto idx = decltype(idx_t)::value;
+      if (auto v = std::get<idx>(m_slots).read())
+        std::get<idx>(m_node->controls) = std::move(*v);
+    });
+  }
+
+  std::shared_ptr<Node_T> m_node;
+  typename control_slots<typename Node_T::controls_values_type>::type m_slots;
+};
 
 template <typename Info_T, typename Node_T, typename Element>
 struct setup_Impl0
 {
+  using mailbox_type = control_mailbox<Info_T, Node_T>;
   Element& element;
-  const Execution::Context& ctx;
   const std::shared_ptr<Node_T>& node_ptr;
+  const std::shared_ptr<mailbox_type>& mailbox;
   QObject* parent;
 
   template <typename Idx_T>
   struct con_validated
   {
-    const Execution::Context& ctx;
-    std::weak_ptr<Node_T> weak_node;
+    std::shared_ptr<mailbox_type> mailbox;
     void operator()(const ossia::value& val)
     {
-      using namespace ossia::safe_nodes;
       constexpr auto idx = Idx_T::value;
-
-      using control_type = typename std::
-          tuple_element<idx, decltype(Info_T::Metadata::controls)>::type;
-      using control_value_type = typename control_type::type;
-
-      if (auto node = weak_node.lock())
-      {
-        constexpr const auto ctrl = std::get<idx>(Info_T::Metadata::controls);
-        if (auto v = ctrl.fromValue(val))
-          ctx.executionQueue.enqueue(control_updater<control_value_type>{
-              std::get<idx>(node->controls), std::move(*v)});
-      }
+      constexpr const auto ctrl = std::get<idx>(Info_T::Metadata::controls);
+      if (auto v = ctrl.fromValue(val))
+        mailbox->template write<idx>(std::move(*v));
     }
   };
 
   template <typename Idx_T>
   struct con_unvalidated
   {
-    const Execution::Context& ctx;
-    std::weak_ptr<Node_T> weak_node;
+    std::shared_ptr<mailbox_type> mailbox;
     void operator()(const ossia::value& val)
     {
-      using namespace ossia::safe_nodes;
       constexpr auto idx = Idx_T::value;
-
-      using control_type = typename std::
-          tuple_element<idx, decltype(Info_T::Metadata::controls)>::type;
-      using control_value_type = typename control_type::type;
-
-      if (auto node = weak_node.lock())
-      {
-        constexpr const auto ctrl = std::get<idx>(Info_T::Metadata::controls);
-        ctx.executionQueue.enqueue(control_updater<control_value_type>{
-            std::get<idx>(node->controls), ctrl.fromValue(val)});
-      }
+      constexpr const auto ctrl = std::get<idx>(Info_T::Metadata::controls);
+      mailbox->template write<idx>(ctrl.fromValue(val));
     }
   };
 
@@ -87,7 +106,6 @@ struct setup_Impl0
         element.inlets()[control_start + idx]);
 
     auto& node = *node_ptr;
-    std::weak_ptr<Node_T> weak_node = node_ptr;
 
     if constexpr (control_type::must_validate)
     {
@@ -98,7 +116,7 @@ struct setup_Impl0
           inlet,
           &Process::ControlInlet::valueChanged,
           parent,
-          con_validated<T>{ctx, weak_node});
+          con_validated<T>{mailbox});
     }
     else
     {
@@ -108,7 +126,7 @@ struct setup_Impl0
           inlet,
           &Process::ControlInlet::valueChanged,
           parent,
-          con_unvalidated<T>{ctx, weak_node});
+          con_unvalidated<T>{mailbox});
     }
   }
 };
@@ -207,8 +225,10 @@ struct ExecutorGuiUpdate
   }
 };
 
+//! Returns the mailbox through which the controls are sent to the node,
+//! if it has any.
 template <typename Info, typename Node_T, typename Element_T>
-void setup_node(
+std::shared_ptr<Execution::ControlMailbox> setup_node(
     const std::shared_ptr<Node_T>& node_ptr,
     Element_T& element,
     const Execution::Context& ctx,
@@ -216,14 +236,18 @@ void setup_node(
 {
   using namespace ossia::safe_nodes;
 
+  std::shared_ptr<Execution::ControlMailbox> res;
   (void)parent;
   if constexpr (info_functions<Info>::control_count > 0)
   {
     // Initialize all the controls in the node with the current value.
     //
     // And update the node when the UI changes
+    auto mailbox = std::make_shared<control_mailbox<Info, Node_T>>(node_ptr);
     ossia::for_each_in_range<info_functions<Info>::control_count>(
-        setup_Impl0<Info, Node_T, Element_T>{element, ctx, node_ptr, parent});
+        setup_Impl0<Info, Node_T, Element_T>{
+            element, node_ptr, mailbox, parent});
+    res = std::move(mailbox);
   }
 
   if constexpr (
@@ -238,6 +262,7 @@ void setup_node(
         ExecutorGuiUpdate<Info, Node_T, Element_T>{weak_node, element},
         Qt::QueuedConnection);
   }
+  return res;
 }
 
 template <typename Info>
@@ -278,7 +303,7 @@ public:
     this->node = node;
     this->m_ossia_process = std::make_shared<ossia::node_process>(this->node);
 
-    setup_node<Info>(node, element, ctx, this);
+    this->setControlMailbox(setup_node<Info>(node, element, ctx, this));
   }
 
   ~Executor() { }
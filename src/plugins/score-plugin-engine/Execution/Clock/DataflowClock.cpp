@@ -55,27 +55,9 @@ void Clock::resume_impl(Execution::BaseScenarioElement& bs)
 
   m_paused = false;
   m_default.resume(bs);
-  auto tick = m_plug.settings.getTick();
-  auto commit = m_plug.settings.getCommit();
-
-  ossia::tick_setup_options opt;
-  if (tick == Execution::Settings::TickPolicies{}.Buffer)
-    opt.tick = ossia::tick_setup_options::Buffer;
-  else if (tick == Execution::Settings::TickPolicies{}.ScoreAccurate)
-    opt.tick = ossia::tick_setup_options::ScoreAccurate;
-  else if (tick == Execution::Settings::TickPolicies{}.Precise)
-    opt.tick = ossia::tick_setup_options::Precise;
-
-  if (commit == Execution::Settings::CommitPolicies{}.Default)
-    opt.commit = ossia::tick_setup_options::Default;
-  else if (commit == Execution::Settings::CommitPolicies{}.Ordered)
-    opt.commit = ossia::tick_setup_options::Ordered;
-  else if (commit == Execution::Settings::CommitPolicies{}.Priorized)
-    opt.commit = ossia::tick_setup_options::Priorized;
-  else if (commit == Execution::Settings::CommitPolicies{}.Merged)
-    opt.commit = ossia::tick_setup_options::Merged;
-
-  if (m_plug.settings.getBench() && m_plug.bench)
+  const auto opt = Execution::tickSetupOptions(m_plug.settings);
+
+  if (m_plug.bench)
   {
     e->set_tick(Execution::makeBenchmarkTick(opt, m_plug, *m_cur));
   }
@@ -3,6 +3,7 @@
 #include "DocumentPlugin.hpp"
 
 #include "BaseScenarioComponent.hpp"
+#include "Profiler.hpp"
 
 #include <Audio/AudioApplicationPlugin.hpp>
 #include <Audio/AudioDevice.hpp>
@@ -31,6 +32,8 @@
 #include <ossia/network/common/path.hpp>
 
 #include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
 
 #include <Scenario/Application/ScenarioActions.hpp>
 #include <Scenario/Document/BaseScenario/BaseScenario.hpp>
@@ -38,6 +41,8 @@
 #include <Scenario/Document/ScenarioDocument/ScenarioDocumentModel.hpp>
 #include <Scenario/Document/State/StateExecution.hpp>
 #include <Scenario/Execution/score2OSSIA.hpp>
+
+#include <boost/core/demangle.hpp>
 #include <wobjectimpl.h>
 W_REGISTER_ARGTYPE(ossia::bench_map)
 W_OBJECT_IMPL(Execution::DocumentPlugin)
@@ -53,8 +58,8 @@ DocumentPlugin::DocumentPlugin(
     , m_gcQueue(1024)
     , m_ctx
 {
-  ctx, m_created, {}, {}, m_execQueue, m_editionQueue, m_gcQueue, m_setup_ctx,
-      execGraph, execState
+  ctx, m_created, {}, {}, m_execQueue, m_editionQueue, m_gcQueue,
+      m_controlMailboxes, m_setup_ctx, execGraph, execState
 #if (__cplusplus > 201703L) && !defined(_MSC_VER)
       ,
   {
@@ -142,14 +147,17 @@ void DocumentPlugin::on_finished()
     killTimer(m_tid);
     m_tid = -1;
 
-    {
-      ExecutionCommand cmd;
-      while (m_editionQueue.try_dequeue(cmd))
-        cmd();
-      GCCommand gc;
-      while (m_gcQueue.try_dequeue(gc))
-        ;
-    }
+    runEditionCommands();
+  }
+
+  if (profiler)
+  {
+    collectProfile();
+    const auto path = QDir::temp().filePath(
+        QStringLiteral("score-profile-%1.json")
+            .arg(QDateTime::currentDateTime().toString(
+                QStringLiteral("yyyyMMdd-hhmmss"))));
+    exportProfile(path);
   }
 
   clear();
@@ -176,6 +184,14 @@ void DocumentPlugin::on_finished()
 }
 
 void DocumentPlugin::timerEvent(QTimerEvent* event)
+{
+  runEditionCommands();
+
+  if (profiler)
+    collectProfile();
+}
+
+void DocumentPlugin::runEditionCommands()
 {
   ExecutionCommand cmd;
   while (m_editionQueue.try_dequeue(cmd))
@@ -185,9 +201,39 @@ void DocumentPlugin::timerEvent(QTimerEvent* event)
     ;
 }
 
+void DocumentPlugin::collectProfile()
+{
+  profiler->collect();
+
+  // Names have to be resolved while the processes are still alive
+  for (const auto& [node, proc] : m_setup_ctx.proc_map)
+  {
+    if (proc && !profiler->hasName(node))
+    {
+      const auto& m = proc->metadata();
+      profiler->setName(
+          node, m.getLabel().isEmpty() ? m.getName() : m.getLabel());
+    }
+  }
+  for (auto act : m_actions)
+  {
+    if (!profiler->hasName(act))
+      profiler->setName(
+          act,
+          QString::fromStdString(boost::core::demangle(typeid(*act).name())));
+  }
+}
+
+bool DocumentPlugin::exportProfile(const QString& path)
+{
+  if (!profiler)
+    return false;
+  return profiler->exportChromeTrace(path);
+}
+
 void DocumentPlugin::registerDevice(ossia::net::device_base* d)
 {
-  if (execState)
+  if (execState && m_externalDevices)
     execState->register_device(d);
 }
 
@@ -197,13 +243,12 @@ void DocumentPlugin::unregisterDevice(ossia::net::device_base* d)
     execState->unregister_device(d);
 }
 
-void DocumentPlugin::makeGraph()
+void DocumentPlugin::makeGraph(int rate, int bufferSize)
 {
   using namespace ossia;
   const score::DocumentContext& ctx = m_ctx.doc;
   auto& devlist
       = ctx.plugin<Explorer::DeviceDocumentPlugin>().list().devices();
-  auto& audiosettings = ctx.app.settings<Audio::Settings::Model>();
 
   static const Execution::Settings::SchedulingPolicies sched_t;
   static const Execution::Settings::OrderingPolicies order_t;
@@ -221,12 +266,10 @@ void DocumentPlugin::makeGraph()
 
   execState = std::make_shared<ossia::execution_state>();
 
-  execState->bufferSize = audiosettings.getBufferSize();
-  execState->sampleRate = audiosettings.getRate();
-  execState->modelToSamplesRatio
-      = audiosettings.getRate() / ossia::flicks_per_second<double>;
-  execState->samplesToModelRatio
-      = ossia::flicks_per_second<double> / audiosettings.getRate();
+  execState->bufferSize = bufferSize;
+  execState->sampleRate = rate;
+  execState->modelToSamplesRatio = rate / ossia::flicks_per_second<double>;
+  execState->samplesToModelRatio = ossia::flicks_per_second<double> / rate;
   execState->samples_since_start = 0;
   execState->start_date = 0; // TODO set it in the first callback
   execState->cur_date = execState->start_date;
@@ -244,12 +287,21 @@ void DocumentPlugin::makeGraph()
   opt.parallel = settings.getParallel();
   if (settings.getLogging())
     opt.log = ossia::logger_ptr();
-  if (settings.getBench())
+  if (settings.getBench() || settings.getProfile())
   {
     bench = std::make_shared<bench_map>();
     opt.bench = bench;
     opt.bench->clear();
   }
+  else
+  {
+    bench.reset();
+  }
+
+  if (settings.getProfile())
+    profiler = std::make_shared<Execution::Profiler>();
+  else
+    profiler.reset();
 
   if (sched == sched_t.StaticFixed)
     opt.scheduling = ossia::graph_setup_options::StaticFixed;
@@ -264,6 +316,16 @@ void DocumentPlugin::makeGraph()
 }
 
 void DocumentPlugin::reload(Scenario::IntervalModel& cst)
+{
+  auto& audiosettings = m_ctx.doc.app.settings<Audio::Settings::Model>();
+  reload(cst, audiosettings.getRate(), audiosettings.getBufferSize());
+}
+
+void DocumentPlugin::reload(
+    Scenario::IntervalModel& cst,
+    int rate,
+    int bufferSize,
+    bool externalDevices)
 {
   if (m_base.active())
   {
@@ -277,7 +339,8 @@ void DocumentPlugin::reload(Scenario::IntervalModel& cst)
   m_ctx.time = settings.makeTimeFunction(ctx);
   m_ctx.reverseTime = settings.makeReverseTimeFunction(ctx);
 
-  makeGraph();
+  m_externalDevices = externalDevices;
+  makeGraph(rate, bufferSize);
 
   auto parent = dynamic_cast<Scenario::ScenarioInterface*>(cst.parent());
   SCORE_ASSERT(parent);
@@ -319,6 +382,7 @@ void DocumentPlugin::clear()
     m_created = false;
     runAllCommands();
     runAllCommands();
+    m_controlMailboxes.clear();
 
     if (execGraph)
       execGraph->clear();
@@ -412,6 +476,7 @@ void DocumentPlugin::runAllCommands() const
   ExecutionCommand com;
   while (m_execQueue.try_dequeue(com))
     com();
+  m_controlMailboxes.apply();
 }
 
 void DocumentPlugin::registerAction(ExecutionAction& act)
@@ -2,6 +2,7 @@
 #include "BaseScenarioComponent.hpp"
 
 #include <Process/Dataflow/Port.hpp>
+#include <Process/Execution/ControlMailbox.hpp>
 #include <Process/ExecutionAction.hpp>
 #include <Process/ExecutionContext.hpp>
 #include <Process/ExecutionSetup.hpp>
@@ -53,6 +54,7 @@ class AudioDevice;
 namespace Execution
 {
 class ExecutionController;
+class Profiler;
 class SCORE_PLUGIN_ENGINE_EXPORT DocumentPlugin final
     : public score::DocumentPlugin
 {
@@ -64,6 +66,16 @@ public:
 
   ~DocumentPlugin() override;
   void reload(Scenario::IntervalModel& doc);
+
+  //! Reloads with a sample rate and buffer size which may differ from
+  //! the ones of the audio engine, e.g. for offline rendering.
+  //! Without external devices, only the audio and local devices are
+  //! reachable from the score.
+  void reload(
+      Scenario::IntervalModel& doc,
+      int rate,
+      int bufferSize,
+      bool externalDevices = true);
   void clear();
 
   void on_documentClosing() override;
@@ -80,6 +92,13 @@ public:
 
   void runAllCommands() const;
 
+  //! Runs the commands sent back by the execution thread
+  //! and frees what it does not use anymore.
+  void runEditionCommands();
+
+  //! Saves the timings recorded since the last play as a Chrome trace.
+  bool exportProfile(const QString& path);
+
   void registerAction(ExecutionAction& act);
   const std::vector<ExecutionAction*>& actions() const noexcept
   {
@@ -91,6 +110,7 @@ public:
   std::shared_ptr<ossia::graph_interface> execGraph;
   std::shared_ptr<ossia::execution_state> execState;
   std::shared_ptr<ossia::bench_map> bench;
+  std::shared_ptr<Execution::Profiler> profiler;
 
   QPointer<Dataflow::AudioDevice> audio_device{};
   QPointer<Device::DeviceInterface> local_device{};
@@ -110,16 +130,19 @@ private:
   void timerEvent(QTimerEvent* event) override;
   void registerDevice(ossia::net::device_base*);
   void unregisterDevice(ossia::net::device_base*);
-  void makeGraph();
+  void makeGraph(int rate, int bufferSize);
+  void collectProfile();
 
   mutable ExecutionCommandQueue m_execQueue;
   mutable EditionCommandQueue m_editionQueue;
   mutable GCCommandQueue m_gcQueue;
+  mutable ControlMailboxes m_controlMailboxes;
   Context m_ctx;
   SetupContext m_setup_ctx;
   BaseScenarioElement m_base;
   std::vector<ExecutionAction*> m_actions;
   std::atomic_bool m_created{};
+  bool m_externalDevices{true};
 
   int m_tid{};
 };
@@ -2,6 +2,8 @@
 #include <Execution/BaseScenarioComponent.hpp>
 #include <Execution/DocumentPlugin.hpp>
 #include <Execution/ExecutionController.hpp>
+#include <Execution/Profiler.hpp>
+#include <Execution/Settings/ExecutorModel.hpp>
 #include <Transport/TransportInterface.hpp>
 
 #include <ossia/audio/audio_protocol.hpp>
@@ -37,6 +39,7 @@ struct AudioTickHelper
       , m_plug{plug}
       , m_execQueue{plug.context().executionQueue}
       , m_gcQueue{plug.context().gcQueue}
+      , m_controlMailboxes{plug.context().controlMailboxes}
       , m_proto{plug.audioProto()}
   {
     m_actions = plug.actions();
@@ -75,6 +78,9 @@ struct AudioTickHelper
       {
       }
     }
+
+    // Then the latest value of the controls which changed
+    m_controlMailboxes.apply();
   }
 
   void main_tick(const ossia::audio_tick_state& t) const
@@ -151,11 +157,41 @@ struct AudioTickHelper
   {
   }
 
+  //! Same as main, but records the timings in the profiler
+  void main(const ossia::audio_tick_state& t, Profiler& prof) const
+  try
+  {
+    m_proto.setup_buffers(t);
+
+    for (auto act : m_actions)
+    {
+      const auto t0 = Profiler::now();
+      act->startTick(t);
+      prof.push(ProfilerEvent::StartTick, act, t0, Profiler::now());
+    }
+
+    const auto graph_start = Profiler::now();
+    main_tick(t);
+    if (m_plug.bench)
+      prof.pushGraph(*m_plug.bench, graph_start, Profiler::now());
+
+    for (auto act : m_actions)
+    {
+      const auto t0 = Profiler::now();
+      act->endTick(t);
+      prof.push(ProfilerEvent::EndTick, act, t0, Profiler::now());
+    }
+  }
+  catch (...)
+  {
+  }
+
   ossia::time_interval& m_itv;
   smallfun::function<void(unsigned long, double), 128> m_tick;
   DocumentPlugin& m_plug;
   ExecutionCommandQueue& m_execQueue;
   GCCommandQueue& m_gcQueue;
+  ControlMailboxes& m_controlMailboxes;
   ossia::audio_protocol& m_proto;
   std::vector<ExecutionAction*> m_actions;
 
@@ -163,6 +199,31 @@ struct AudioTickHelper
 };
 }
 
+ossia::tick_setup_options tickSetupOptions(const Settings::Model& settings)
+{
+  auto tick = settings.getTick();
+  auto commit = settings.getCommit();
+
+  ossia::tick_setup_options opt;
+  if (tick == Execution::Settings::TickPolicies{}.Buffer)
+    opt.tick = ossia::tick_setup_options::Buffer;
+  else if (tick == Execution::Settings::TickPolicies{}.ScoreAccurate)
+    opt.tick = ossia::tick_setup_options::ScoreAccurate;
+  else if (tick == Execution::Settings::TickPolicies{}.Precise)
+    opt.tick = ossia::tick_setup_options::Precise;
+
+  if (commit == Execution::Settings::CommitPolicies{}.Default)
+    opt.commit = ossia::tick_setup_options::Default;
+  else if (commit == Execution::Settings::CommitPolicies{}.Ordered)
+    opt.commit = ossia::tick_setup_options::Ordered;
+  else if (commit == Execution::Settings::CommitPolicies{}.Priorized)
+    opt.commit = ossia::tick_setup_options::Priorized;
+  else if (commit == Execution::Settings::CommitPolicies{}.Merged)
+    opt.commit = ossia::tick_setup_options::Merged;
+
+  return opt;
+}
+
 Audio::tick_fun makeExecutionTick(
     ossia::tick_setup_options opt,
     Execution::DocumentPlugin& plug,
@@ -192,6 +253,8 @@ Audio::tick_fun makeBenchmarkTick(
 
   int i = 0;
   return [helper = AudioTickHelper{opt, plug, scenar},
+          prof = plug.profiler,
+          show_bench = plug.settings.getBench(),
           i](const ossia::audio_tick_state& t) mutable {
     Audio::execution_status.store(ossia::transport_status::playing);
 
@@ -199,7 +262,28 @@ Audio::tick_fun makeBenchmarkTick(
     helper.dequeueCommands();
 
     auto& bench = *helper.m_plug.bench;
-    if (i % 50 == 0)
+    if (prof)
+    {
+      // Every tick is measured so that the timeline has no holes
+      bench.measure = true;
+      const auto t0 = Profiler::now();
+
+      helper.main(t, *prof);
+
+      const auto t1 = Profiler::now();
+      const auto rate = helper.m_plug.execState->sampleRate;
+      const int64_t deadline = rate > 0 ? int64_t(1e9 * t.frames / rate) : 0;
+      prof->pushTick(t0, t1, deadline);
+
+      if (show_bench && i % 50 == 0)
+        helper.m_plug.sig_bench(bench, t1 - t0);
+
+      for (auto& p : bench)
+      {
+        p.second = {};
+      }
+    }
+    else if (i % 50 == 0)
     {
       bench.measure = true;
       auto t0 = std::chrono::steady_clock::now();
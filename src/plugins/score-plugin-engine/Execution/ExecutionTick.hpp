@@ -7,11 +7,18 @@ namespace Execution
 {
 class DocumentPlugin;
 class BaseScenarioElement;
+namespace Settings
+{
+class Model;
+}
 }
 namespace Execution
 {
 using tick_fun = ossia::audio_engine::fun_type;
 
+//! The tick and commit policies chosen in the execution settings
+ossia::tick_setup_options tickSetupOptions(const Settings::Model& settings);
+
 tick_fun makeExecutionTick(
     ossia::tick_setup_options opt,
     Execution::DocumentPlugin& plug,
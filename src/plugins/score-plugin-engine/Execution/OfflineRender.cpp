@@ -0,0 +1,175 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "OfflineRender.hpp"
+
+#include <Audio/AudioApplicationPlugin.hpp>
+#include <Audio/AudioDevice.hpp>
+#include <Audio/AudioFileWriter.hpp>
+#include <Audio/AudioTick.hpp>
+#include <Execution/BaseScenarioComponent.hpp>
+#include <Execution/Clock/DefaultClock.hpp>
+#include <Execution/DocumentPlugin.hpp>
+#include <Execution/ExecutionTick.hpp>
+
+#include <ossia/audio/audio_engine.hpp>
+#include <ossia/audio/audio_protocol.hpp>
+#include <ossia/detail/flicks.hpp>
+
+#include <QEventLoop>
+#include <QFile>
+#include <QTimer>
+
+#include <Scenario/Document/Interval/IntervalModel.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <thread>
+
+namespace Execution
+{
+OfflineRenderResult renderOffline(
+    DocumentPlugin& plug,
+    Scenario::IntervalModel& itv,
+    const OfflineRenderSettings& settings,
+    const OfflineRenderProgress& progress)
+{
+  OfflineRenderResult res;
+  auto fail = [&res](QString err) {
+    res.error = std::move(err);
+    return res;
+  };
+
+  if (plug.isPlaying())
+    return fail(QObject::tr("Cannot render while the score is playing"));
+  if (!plug.audio_device)
+    return fail(QObject::tr("The document has no audio device"));
+  if (settings.rate <= 0 || settings.bufferSize <= 0 || settings.outputs <= 0)
+    return fail(QObject::tr("Invalid rate, buffer size or output count"));
+
+  std::vector<int> channels = settings.channels;
+  if (channels.empty())
+  {
+    channels.resize(settings.outputs);
+    std::iota(channels.begin(), channels.end(), 0);
+  }
+  for (int c : channels)
+    if (c < 0 || c >= settings.outputs)
+      return fail(QObject::tr("Invalid output: %1").arg(c));
+
+  const TimeVal duration = settings.duration > TimeVal::zero()
+                               ? settings.duration
+                               : itv.duration.defaultDuration();
+  if (duration.infinite() || duration <= TimeVal::zero())
+    return fail(QObject::tr("The duration to render is not set"));
+  const int64_t total = std::ceil(
+      duration.impl * settings.rate / ossia::flicks_per_second<double>);
+
+  const auto format = Audio::AudioFileWriter::formatForPath(settings.path);
+  if (!format)
+    return fail(QObject::tr("Unsupported file format: %1").arg(settings.path));
+
+  Audio::AudioFileWriter writer;
+  if (!writer.open(settings.path, *format, channels.size(), settings.rate))
+    return fail(writer.errorString());
+
+  // The ticks are called from here instead of the audio driver,
+  // with as many outputs as requested.
+  auto& engine = plug.context()
+                     .doc.app.guiApplicationPlugin<Audio::ApplicationPlugin>()
+                     .audio;
+  if (engine)
+    engine->stop();
+  plug.audioProto().setup_tree(0, settings.outputs);
+
+  plug.reload(itv, settings.rate, settings.bufferSize, false);
+
+  auto& bs = plug.baseScenario();
+  DefaultClock clock{plug.context()};
+  clock.play(TimeVal::zero(), bs);
+  auto tick = makeExecutionTick(tickSetupOptions(plug.settings), plug, bs);
+
+  std::vector<float> samples(
+      std::size_t(settings.outputs) * settings.bufferSize);
+  std::vector<float*> outputs(settings.outputs);
+  for (int i = 0; i < settings.outputs; i++)
+    outputs[i] = samples.data() + std::size_t(i) * settings.bufferSize;
+
+  std::vector<const float*> selected(channels.size());
+  for (std::size_t i = 0; i < channels.size(); i++)
+    selected[i] = outputs[channels[i]];
+
+  ossia::audio_tick_state t{};
+  t.outputs = outputs.data();
+  t.n_out = settings.outputs;
+  t.frames = settings.bufferSize;
+
+  res.ok = true;
+  std::atomic_bool cancel{};
+  std::atomic_bool done{};
+  std::atomic<int64_t> rendered{};
+  const auto t0 = std::chrono::steady_clock::now();
+
+  // The worker takes the place of the audio thread: the GUI thread keeps
+  // running the edition commands it sends back, as during a playback.
+  std::thread render{[&] {
+    int64_t frames = 0;
+    while (frames < total && !cancel.load(std::memory_order_relaxed))
+    {
+      t.seconds = double(frames) / settings.rate;
+      tick(t);
+
+      // The last buffer is rendered entirely but only written up to the end
+      const int64_t n = std::min(int64_t(settings.bufferSize), total - frames);
+      if (!writer.write(selected.data(), n))
+      {
+        res.ok = false;
+        res.error = writer.errorString();
+        break;
+      }
+      frames += n;
+      rendered.store(frames, std::memory_order_relaxed);
+    }
+    res.frames = frames;
+    done.store(true, std::memory_order_release);
+  }};
+
+  QEventLoop loop;
+  QTimer timer;
+  QObject::connect(&timer, &QTimer::timeout, &loop, [&] {
+    if (progress && !progress(double(rendered.load()) / total))
+      cancel = true;
+    if (done.load(std::memory_order_acquire))
+      loop.quit();
+  });
+  timer.start(16);
+  loop.exec();
+  render.join();
+
+  res.renderTime = std::chrono::steady_clock::now() - t0;
+
+  clock.stop(bs);
+  plug.finished();
+  Audio::execution_status.store(ossia::transport_status::stopped);
+
+  if (!writer.close() && res.ok)
+  {
+    res.ok = false;
+    res.error = writer.errorString();
+  }
+
+  if (cancel && res.frames < total)
+  {
+    QFile::remove(settings.path);
+    res.ok = false;
+    res.canceled = true;
+    res.error = QObject::tr("The render was canceled");
+  }
+
+  // Restores the tree of the realtime engine and restarts it
+  if (engine)
+    plug.audio_device->reconnect();
+
+  return res;
+}
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <Process/TimeValue.hpp>
+
+#include <QString>
+
+#include <score_plugin_engine_export.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Scenario
+{
+class IntervalModel;
+}
+namespace Execution
+{
+class DocumentPlugin;
+
+struct OfflineRenderSettings
+{
+  //! A .wav or .flac file
+  QString path;
+
+  int rate{44100};
+  int bufferSize{512};
+
+  //! Number of outputs of the audio device while rendering
+  int outputs{2};
+
+  //! The outputs written to the file, all of them if empty
+  std::vector<int> channels;
+
+  //! The duration of the interval if not set
+  TimeVal duration{TimeVal::zero()};
+};
+
+struct OfflineRenderResult
+{
+  bool ok{};
+  bool canceled{};
+  QString error;
+
+  int64_t frames{};
+  std::chrono::nanoseconds renderTime{};
+
+  //! How many times faster than realtime the rendering went
+  double speed(int rate) const noexcept
+  {
+    const double rendered = double(frames) / rate;
+    const double took = std::chrono::duration<double>(renderTime).count();
+    return took > 0. ? rendered / took : 0.;
+  }
+};
+
+/**
+ * Called periodically on the GUI thread during a render with the
+ * rendered fraction, from 0 to 1. Returning false cancels the render.
+ */
+using OfflineRenderProgress = std::function<bool(double)>;
+
+/**
+ * @brief Renders an interval to an audio file, as fast as possible.
+ *
+ * The execution tick is called in a loop on a worker thread instead of by
+ * the audio driver: the realtime engine is stopped meanwhile and restarted
+ * afterwards. The GUI thread keeps processing its events until the render
+ * is done. The graph is executed in parallel if it is enabled in the
+ * execution settings.
+ *
+ * The devices other than the audio and local ones are not reachable from
+ * the score during the render, so that they do not receive messages at
+ * the accelerated speed.
+ *
+ * Must be called from the GUI thread, while the document is not playing.
+ * The file is removed if the render is canceled.
+ */
+SCORE_PLUGIN_ENGINE_EXPORT
+OfflineRenderResult renderOffline(
+    DocumentPlugin& plug,
+    Scenario::IntervalModel& itv,
+    const OfflineRenderSettings& settings,
+    const OfflineRenderProgress& progress = {});
+}
@@ -0,0 +1,227 @@
+#include "Profiler.hpp"
+
+#include <ossia/dataflow/bench_map.hpp>
+
+#include <QFile>
+
+#include <chrono>
+
+namespace Execution
+{
+namespace
+{
+const auto profiler_epoch = std::chrono::steady_clock::now();
+
+// Chrome traces use microseconds
+void appendTime(QByteArray& out, int64_t ns)
+{
+  out.append(QByteArray::number(ns / 1000));
+  out.append('.');
+  out.append(QByteArray::number(ns % 1000).rightJustified(3, '0'));
+}
+
+QByteArray escape(const QString& str)
+{
+  QByteArray res = str.toUtf8();
+  res.replace('\\', "\\\\");
+  res.replace('"', "\\\"");
+  res.replace('\n', "\\n");
+  return res;
+}
+}
+
+Profiler::Profiler()
+    : m_queue(queue_size)
+{
+}
+
+Profiler::~Profiler() { }
+
+int64_t Profiler::now() noexcept
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - profiler_epoch)
+      .count();
+}
+
+void Profiler::push(
+    ProfilerEvent::Kind k,
+    const void* source,
+    int64_t start,
+    int64_t end) noexcept
+{
+  if (!m_queue.enqueue(ProfilerEvent{source, start, end, k}))
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::pushGraph(
+    const ossia::bench_map& b,
+    int64_t graph_start,
+    int64_t graph_end) noexcept
+{
+  push(ProfilerEvent::Graph, nullptr, graph_start, graph_end);
+  for (const auto& p : b)
+  {
+    if (p.second)
+      push(ProfilerEvent::Node, p.first, graph_start, graph_start + *p.second);
+  }
+}
+
+void Profiler::pushTick(
+    int64_t start,
+    int64_t end,
+    int64_t deadline_ns) noexcept
+{
+  push(ProfilerEvent::Tick, nullptr, start, end);
+  if (deadline_ns > 0 && (end - start) > deadline_ns)
+    push(ProfilerEvent::Overrun, nullptr, start, end);
+}
+
+void Profiler::collect()
+{
+  ProfilerEvent e;
+  while (m_queue.try_dequeue(e))
+  {
+    if (e.kind == ProfilerEvent::Overrun)
+      m_overruns++;
+
+    if (m_events.size() < max_events)
+    {
+      m_events.push_back(e);
+    }
+    else
+    {
+      m_events[m_head] = e;
+      m_head = (m_head + 1) % max_events;
+      m_overwritten++;
+    }
+  }
+}
+
+void Profiler::clear()
+{
+  collect();
+  m_events.clear();
+  m_head = 0;
+  m_overwritten = 0;
+  m_dropped = 0;
+  m_overruns = 0;
+}
+
+void Profiler::setName(const void* source, const QString& name)
+{
+  m_names[source] = name;
+}
+
+bool Profiler::hasName(const void* source) const noexcept
+{
+  return m_names.find(source) != m_names.end();
+}
+
+bool Profiler::exportChromeTrace(const QString& path) const
+{
+  QFile f{path};
+  if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    return false;
+
+  // One track per action, track 0 is the audio callback itself.
+  ossia::hash_map<const void*, int> tracks;
+  auto track = [&](const ProfilerEvent& e) {
+    if (!e.source)
+      return 0;
+    auto it = tracks.find(e.source);
+    if (it != tracks.end())
+      return it->second;
+    const int tid = int(tracks.size()) + 1;
+    tracks.insert({e.source, tid});
+    return tid;
+  };
+
+  // Only the duration of the nodes is known, not when they ran:
+  // they are exported as one counter per node rather than as slices.
+  ossia::hash_map<const void*, int> counters;
+  auto counter = [&](const ProfilerEvent& e) {
+    return counters.insert({e.source, int(counters.size())}).first->second;
+  };
+
+  QByteArray out;
+  out.reserve(1024 * 1024);
+  out.append("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  out.append(
+      "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,"
+      "\"args\":{\"name\":\"Audio tick\"}}");
+
+  forEachEvent([&](const ProfilerEvent& e) {
+    const bool is_node = e.kind == ProfilerEvent::Node;
+    const int tid = is_node ? counter(e) : track(e);
+    out.append(",\n{\"name\":\"");
+    switch (e.kind)
+    {
+      case ProfilerEvent::Tick:
+        out.append("tick\",\"cat\":\"tick\",\"ph\":\"X\"");
+        break;
+      case ProfilerEvent::StartTick:
+        out.append("startTick\",\"cat\":\"action\",\"ph\":\"X\"");
+        break;
+      case ProfilerEvent::EndTick:
+        out.append("endTick\",\"cat\":\"action\",\"ph\":\"X\"");
+        break;
+      case ProfilerEvent::Graph:
+        out.append("graph\",\"cat\":\"tick\",\"ph\":\"X\"");
+        break;
+      case ProfilerEvent::Node:
+      {
+        auto it = m_names.find(e.source);
+        out.append(it != m_names.end() ? escape(it->second) : "node");
+        out.append("\",\"cat\":\"node\",\"ph\":\"C\"");
+        break;
+      }
+      case ProfilerEvent::Overrun:
+        out.append("overrun\",\"cat\":\"overrun\",\"ph\":\"i\",\"s\":\"g\"");
+        break;
+    }
+    out.append(is_node ? ",\"pid\":0,\"id\":" : ",\"pid\":0,\"tid\":");
+    out.append(QByteArray::number(tid));
+    out.append(",\"ts\":");
+    appendTime(out, e.start);
+    if (e.kind != ProfilerEvent::Overrun && !is_node)
+    {
+      out.append(",\"dur\":");
+      appendTime(out, e.end - e.start);
+    }
+    else
+    {
+      out.append(",\"args\":{\"duration_us\":");
+      appendTime(out, e.end - e.start);
+      out.append('}');
+    }
+    out.append('}');
+
+    if (out.size() > 1024 * 1024)
+    {
+      f.write(out);
+      out.clear();
+    }
+  });
+
+  for (const auto& [source, tid] : tracks)
+  {
+    auto it = m_names.find(source);
+    out.append(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":");
+    out.append(QByteArray::number(tid));
+    out.append(",\"args\":{\"name\":\"");
+    out.append(it != m_names.end() ? escape(it->second) : QByteArray("?"));
+    out.append("\"}}");
+  }
+
+  out.append("\n],\"otherData\":{\"dropped_events\":");
+  out.append(QByteArray::number(qint64(dropped())));
+  out.append(",\"overwritten_events\":");
+  out.append(QByteArray::number(qint64(m_overwritten)));
+  out.append(",\"overruns\":");
+  out.append(QByteArray::number(qint64(m_overruns)));
+  out.append("}}\n");
+  f.write(out);
+  return true;
+}
+}
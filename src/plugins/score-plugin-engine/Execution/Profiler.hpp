@@ -0,0 +1,128 @@
+#pragma once
+#include <ossia/detail/hash_map.hpp>
+#include <ossia/detail/lockfree_queue.hpp>
+
+#include <QString>
+
+#include <score_plugin_engine_export.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace ossia
+{
+struct bench_map;
+}
+
+namespace Execution
+{
+/**
+ * @brief A single timed event recorded by the audio thread.
+ *
+ * Times are in nanoseconds since the creation of the Profiler.
+ */
+struct ProfilerEvent
+{
+  enum Kind : uint8_t
+  {
+    Tick,      //! A whole audio callback
+    StartTick, //! ExecutionAction::startTick
+    EndTick,   //! ExecutionAction::endTick
+    Graph,     //! The execution of the whole graph
+    Node,      //! A graph node (source is the ossia::graph_node)
+    Overrun    //! A tick which took longer than its buffer duration
+  };
+
+  const void* source{};
+  int64_t start{};
+  int64_t end{};
+  Kind kind{};
+};
+
+/**
+ * @brief Per-tick execution profiler.
+ *
+ * The audio thread pushes fixed-size events in a preallocated
+ * single-producer, single-consumer ring buffer: no allocation nor lock
+ * happens during the tick. If the buffer is full the events are dropped and
+ * counted.
+ *
+ * The GUI thread periodically calls collect() to move the events
+ * out of the ring buffer, and exportChromeTrace() to save them in the
+ * Chrome trace event format, which can be opened in chrome://tracing or
+ * https://ui.perfetto.dev.
+ *
+ * Only the most recent events are kept: once the history is full, the
+ * oldest ones are overwritten, and counted.
+ */
+class SCORE_PLUGIN_ENGINE_EXPORT Profiler
+{
+public:
+  Profiler();
+  ~Profiler();
+
+  static int64_t now() noexcept;
+
+  // Audio thread
+  void push(
+      ProfilerEvent::Kind k,
+      const void* source,
+      int64_t start,
+      int64_t end) noexcept;
+
+  //! Records the graph execution, and a node event for each measured entry
+  //! of the bench map. ossia only reports how long each node ran, not when:
+  //! node events are thus exported as per-node duration counters sampled at
+  //! graph_start, not as slices.
+  void pushGraph(
+      const ossia::bench_map& b,
+      int64_t graph_start,
+      int64_t graph_end) noexcept;
+
+  //! Records a whole tick, and an overrun if it exceeds the buffer duration
+  void pushTick(int64_t start, int64_t end, int64_t deadline_ns) noexcept;
+
+  // GUI thread
+  void collect();
+  void clear();
+
+  void setName(const void* source, const QString& name);
+  bool hasName(const void* source) const noexcept;
+
+  bool exportChromeTrace(const QString& path) const;
+
+  //! Calls f on each recorded event, from the oldest to the most recent
+  template <typename F>
+  void forEachEvent(F&& f) const
+  {
+    for (std::size_t i = m_head; i < m_events.size(); i++)
+      f(m_events[i]);
+    for (std::size_t i = 0; i < m_head; i++)
+      f(m_events[i]);
+  }
+
+  //! Events lost because the audio thread filled the queue
+  int64_t dropped() const noexcept { return m_dropped.load(); }
+  //! Old events overwritten by more recent ones in the history
+  int64_t overwritten() const noexcept { return m_overwritten; }
+  int64_t overruns() const noexcept { return m_overruns; }
+
+private:
+  // A 200-node graph at 64 frames / 48kHz pushes ~150k events per second:
+  // this holds ~0.4 s of them, collect() is called every 32 ms.
+  static constexpr std::size_t queue_size = 1 << 16;
+  // The last ~7 s of the same graph, ~32 MB.
+  static constexpr std::size_t max_events = 1 << 20;
+
+  ossia::spsc_queue<ProfilerEvent, queue_size> m_queue;
+  std::atomic<int64_t> m_dropped{};
+
+  // Ring buffer: once it holds max_events, m_head is the oldest event
+  std::vector<ProfilerEvent> m_events;
+  std::size_t m_head{};
+  int64_t m_overwritten{};
+  ossia::hash_map<const void*, QString> m_names;
+  int64_t m_overruns{};
+};
+}
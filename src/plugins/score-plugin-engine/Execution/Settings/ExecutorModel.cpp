@@ -52,6 +52,9 @@ SETTINGS_PARAMETER_IMPL(Logging){
 SETTINGS_PARAMETER_IMPL(Bench){
     QStringLiteral("score_plugin_engine/Bench"),
     false};
+SETTINGS_PARAMETER_IMPL(Profile){
+    QStringLiteral("score_plugin_engine/Profile"),
+    false};
 SETTINGS_PARAMETER_IMPL(ScoreOrder){
     QStringLiteral("score_plugin_engine/ScoreOrder"),
     false};
@@ -61,6 +64,9 @@ SETTINGS_PARAMETER_IMPL(ValueCompilation){
 SETTINGS_PARAMETER_IMPL(TransportValueCompilation){
     QStringLiteral("score_plugin_engine/TransportValueCompilation"),
     false};
+SETTINGS_PARAMETER_IMPL(ThreadedScripts){
+    QStringLiteral("score_plugin_engine/ThreadedScripts"),
+    false};
 
 static auto list()
 {
@@ -76,9 +82,11 @@ static auto list()
       ExecutionListening,
       Logging,
       Bench,
+      Profile,
       ScoreOrder,
       ValueCompilation,
-      TransportValueCompilation);
+      TransportValueCompilation,
+      ThreadedScripts);
 }
 }
 
@@ -151,8 +159,10 @@ SCORE_SETTINGS_PARAMETER_CPP(bool, Model, Parallel)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, ExecutionListening)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, Logging)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, Bench)
+SCORE_SETTINGS_PARAMETER_CPP(bool, Model, Profile)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, ScoreOrder)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, ValueCompilation)
 SCORE_SETTINGS_PARAMETER_CPP(bool, Model, TransportValueCompilation)
+SCORE_SETTINGS_PARAMETER_CPP(bool, Model, ThreadedScripts)
 }
 }
@@ -74,9 +74,11 @@ class SCORE_PLUGIN_ENGINE_EXPORT Model : public score::SettingsDelegateModel
   bool m_ExecutionListening{};
   bool m_Logging{};
   bool m_Bench{};
+  bool m_Profile{};
   bool m_ScoreOrder{};
   bool m_ValueCompilation{};
   bool m_TransportValueCompilation{};
+  bool m_ThreadedScripts{};
 
   const ClockFactoryList& m_clockFactories;
   const Transport::TransportInterfaceList& m_transportInterfaces;
@@ -110,6 +112,7 @@ public:
       ExecutionListening)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, bool, Logging)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, bool, Bench)
+  SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, bool, Profile)
   SCORE_SETTINGS_PARAMETER_HPP(SCORE_PLUGIN_ENGINE_EXPORT, bool, ScoreOrder)
   SCORE_SETTINGS_PARAMETER_HPP(
       SCORE_PLUGIN_ENGINE_EXPORT,
@@ -119,6 +122,10 @@ public:
       SCORE_PLUGIN_ENGINE_EXPORT,
       bool,
       TransportValueCompilation)
+  SCORE_SETTINGS_PARAMETER_HPP(
+      SCORE_PLUGIN_ENGINE_EXPORT,
+      bool,
+      ThreadedScripts)
 };
 
 SCORE_SETTINGS_PARAMETER(Model, Clock)
@@ -132,8 +139,10 @@ SCORE_SETTINGS_PARAMETER(Model, Parallel)
 SCORE_SETTINGS_PARAMETER(Model, ExecutionListening)
 SCORE_SETTINGS_PARAMETER(Model, Logging)
 SCORE_SETTINGS_PARAMETER(Model, Bench)
+SCORE_SETTINGS_PARAMETER(Model, Profile)
 SCORE_SETTINGS_PARAMETER(Model, ScoreOrder)
 SCORE_SETTINGS_PARAMETER(Model, ValueCompilation)
 SCORE_SETTINGS_PARAMETER(Model, TransportValueCompilation)
+SCORE_SETTINGS_PARAMETER(Model, ThreadedScripts)
 }
 }
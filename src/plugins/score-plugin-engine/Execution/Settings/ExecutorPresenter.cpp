@@ -31,10 +31,12 @@ Presenter::Presenter(Model& m, View& v, QObject* parent)
   SETTINGS_PRESENTER(Parallel);
   SETTINGS_PRESENTER(Logging);
   SETTINGS_PRESENTER(Bench);
+  SETTINGS_PRESENTER(Profile);
   SETTINGS_PRESENTER(ExecutionListening);
   SETTINGS_PRESENTER(ScoreOrder);
   SETTINGS_PRESENTER(ValueCompilation);
   SETTINGS_PRESENTER(TransportValueCompilation);
+  SETTINGS_PRESENTER(ThreadedScripts);
 
   // Clock used
   std::map<QString, ClockFactory::ConcreteKey> clockMap;
@@ -27,6 +27,7 @@ View::View()
         "Enable listening during execution", ExecutionListening);
     SETTINGS_UI_TOGGLE_SETUP("Logging", Logging);
     SETTINGS_UI_TOGGLE_SETUP("Benchmark", Bench);
+    SETTINGS_UI_TOGGLE_SETUP("Save execution profile", Profile);
     lay->addRow(group);
   }
   // advanced settings
@@ -48,6 +49,7 @@ View::View()
   SETTINGS_UI_TOGGLE_SETUP("Value compilation", ValueCompilation);
   SETTINGS_UI_TOGGLE_SETUP(
       "Transport value compilation", TransportValueCompilation);
+  SETTINGS_UI_TOGGLE_SETUP("Run scripts on worker threads", ThreadedScripts);
 }
 
 SETTINGS_UI_COMBOBOX_IMPL(Tick)
@@ -61,8 +63,10 @@ SETTINGS_UI_TOGGLE_IMPL(ScoreOrder)
 SETTINGS_UI_TOGGLE_IMPL(Parallel)
 SETTINGS_UI_TOGGLE_IMPL(Logging)
 SETTINGS_UI_TOGGLE_IMPL(Bench)
+SETTINGS_UI_TOGGLE_IMPL(Profile)
 SETTINGS_UI_TOGGLE_IMPL(ValueCompilation)
 SETTINGS_UI_TOGGLE_IMPL(TransportValueCompilation)
+SETTINGS_UI_TOGGLE_IMPL(ThreadedScripts)
 
 QWidget* View::getWidget()
 {
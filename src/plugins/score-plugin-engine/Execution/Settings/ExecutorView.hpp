@@ -28,11 +28,13 @@ public:
 
   SETTINGS_UI_TOGGLE_HPP(Logging)
   SETTINGS_UI_TOGGLE_HPP(Bench)
+  SETTINGS_UI_TOGGLE_HPP(Profile)
   SETTINGS_UI_TOGGLE_HPP(Parallel)
   SETTINGS_UI_TOGGLE_HPP(ExecutionListening)
   SETTINGS_UI_TOGGLE_HPP(ScoreOrder)
   SETTINGS_UI_TOGGLE_HPP(ValueCompilation)
   SETTINGS_UI_TOGGLE_HPP(TransportValueCompilation)
+  SETTINGS_UI_TOGGLE_HPP(ThreadedScripts)
 
 private:
   QWidget* getWidget() override;
@@ -0,0 +1,102 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "TickMetrics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace Execution
+{
+TickMetrics::TickMetrics(int sampleRate)
+    : m_histogram(bucket_count)
+    , m_rate{sampleRate}
+{
+}
+
+TickMetrics::~TickMetrics() = default;
+
+void TickMetrics::startTick(const ossia::audio_tick_state& st)
+{
+  m_tickStart = clock::now();
+}
+
+void TickMetrics::endTick(const ossia::audio_tick_state& st)
+{
+  const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         clock::now() - m_tickStart)
+                         .count();
+  const int64_t budget = m_rate > 0 ? int64_t(1e9 * st.frames / m_rate) : 0;
+
+  m_histogram[std::min(std::size_t(ns / bucket_ns), bucket_count - 1)]++;
+  m_ticks++;
+  if (ns > budget)
+    m_overruns++;
+  m_busyNs += ns;
+  m_budgetNs += budget;
+  m_maxNs = std::max(m_maxNs, ns);
+}
+
+void TickMetrics::reset() noexcept
+{
+  std::fill(m_histogram.begin(), m_histogram.end(), 0);
+  m_ticks = 0;
+  m_overruns = 0;
+  m_busyNs = 0;
+  m_budgetNs = 0;
+  m_maxNs = 0;
+}
+
+std::chrono::nanoseconds TickMetrics::percentile(double p) const noexcept
+{
+  if (m_ticks == 0)
+    return {};
+
+  const auto target = int64_t(std::ceil(std::clamp(p, 0., 1.) * m_ticks));
+  int64_t count = 0;
+  for (std::size_t i = 0; i < bucket_count - 1; i++)
+  {
+    count += m_histogram[i];
+    if (count >= target)
+    {
+      // Upper bound of the bucket, which cannot exceed what was measured
+      return std::chrono::nanoseconds{
+          std::min(int64_t(i + 1) * bucket_ns, m_maxNs)};
+    }
+  }
+  return maximum();
+}
+
+std::chrono::nanoseconds TickMetrics::maximum() const noexcept
+{
+  return std::chrono::nanoseconds{m_maxNs};
+}
+
+double TickMetrics::load() const noexcept
+{
+  return m_budgetNs > 0 ? double(m_busyNs) / m_budgetNs : 0.;
+}
+
+std::string TickMetrics::summary() const
+{
+  auto ms = [](std::chrono::nanoseconds ns) { return ns.count() / 1e6; };
+
+  char str[512];
+  std::snprintf(
+      str,
+      sizeof(str),
+      "ticks: %lld, overruns: %lld\n"
+      "tick duration (ms): p50 %.3f, p90 %.3f, p99 %.3f, p99.9 %.3f, "
+      "max %.3f\n"
+      "dsp load: %.1f %%\n",
+      (long long)m_ticks,
+      (long long)m_overruns,
+      ms(percentile(0.5)),
+      ms(percentile(0.9)),
+      ms(percentile(0.99)),
+      ms(percentile(0.999)),
+      ms(maximum()),
+      100. * load());
+  return str;
+}
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <Process/ExecutionAction.hpp>
+
+#include <score_plugin_engine_export.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Execution
+{
+/**
+ * @brief Timing statistics of the execution ticks.
+ *
+ * Each tick is measured against the duration of the buffer it computes.
+ * The durations are counted in a histogram allocated up-front, so that
+ * nothing is allocated in the audio thread.
+ *
+ * The statistics must only be read while the execution is stopped.
+ */
+class SCORE_PLUGIN_ENGINE_EXPORT TickMetrics final : public ExecutionAction
+{
+  SCORE_CONCRETE("61f822cd-1751-4c72-9942-9613ed842769")
+public:
+  explicit TickMetrics(int sampleRate);
+  ~TickMetrics() override;
+
+  void startTick(const ossia::audio_tick_state& st) override;
+  void endTick(const ossia::audio_tick_state& st) override;
+
+  void reset() noexcept;
+
+  int64_t ticks() const noexcept { return m_ticks; }
+
+  //! Ticks which took longer than the duration of their buffer
+  int64_t overruns() const noexcept { return m_overruns; }
+
+  //! Duration under which the fraction p of the ticks completed
+  std::chrono::nanoseconds percentile(double p) const noexcept;
+  std::chrono::nanoseconds maximum() const noexcept;
+
+  //! Time spent in the ticks over the duration of the audio they computed
+  double load() const noexcept;
+
+  std::string summary() const;
+
+private:
+  using clock = std::chrono::steady_clock;
+
+  // 10 µs precision, up to 100 ms; the last bucket counts the longer ticks
+  static constexpr int64_t bucket_ns = 10'000;
+  static constexpr std::size_t bucket_count = 10'001;
+
+  std::vector<uint32_t> m_histogram;
+  clock::time_point m_tickStart{};
+  int m_rate{};
+
+  int64_t m_ticks{};
+  int64_t m_overruns{};
+  int64_t m_busyNs{};
+  int64_t m_budgetNs{};
+  int64_t m_maxNs{};
+};
+}
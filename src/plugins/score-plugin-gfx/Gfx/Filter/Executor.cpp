@@ -18,16 +18,10 @@ namespace Gfx::Filter
 class filter_node final : public gfx_exec_node
 {
 public:
-  filter_node(
-      const isf::descriptor& isf,
-      const QShader& vert,
-      const QShader& frag,
-      GfxExecutionAction& ctx)
+  // Renders nothing until a script is set
+  explicit filter_node(GfxExecutionAction& ctx)
       : gfx_exec_node{ctx}
   {
-    auto n = std::make_unique<score::gfx::ISFNode>(isf, vert, frag);
-
-    id = exec_context->ui->register_node(std::move(n));
   }
 
   void set_script(
@@ -35,14 +29,23 @@ public:
       const QShader& vert,
       const QShader& frag)
   {
-    exec_context->ui->unregister_node(id);
+    clear_script();
 
     auto n = std::make_unique<score::gfx::ISFNode>(isf, vert, frag);
 
     id = exec_context->ui->register_node(std::move(n));
   }
 
-  ~filter_node() { exec_context->ui->unregister_node(id); }
+  void clear_script()
+  {
+    if (id != -1)
+    {
+      exec_context->ui->unregister_node(id);
+      id = -1;
+    }
+  }
+
+  ~filter_node() { clear_script(); }
 
   std::string label() const noexcept override { return "Gfx::filter_node"; }
 };
@@ -55,17 +58,15 @@ ProcessExecutorComponent::ProcessExecutorComponent(
 {
   try
   {
-    const auto& shader = element.processedProgram();
-    const auto& desc = shader.descriptor;
-
-    this->node = std::make_shared<filter_node>(
-        desc,
-        shader.compiledVertex,
-        shader.compiledFragment,
-        ctx.doc.plugin<DocumentPlugin>().exec);
+    // Shaders of a document being loaded are baked in parallel:
+    // the node renders nothing until the ones of this process are done.
+    this->node
+        = std::make_shared<filter_node>(ctx.doc.plugin<DocumentPlugin>().exec);
 
     Execution::Transaction commands{system()};
     setup_node(commands);
+    if (element.programCompiled())
+      set_script(commands);
     commands.run_all_in_exec();
 
     m_ossia_process = std::make_shared<ossia::node_process>(this->node);
@@ -74,29 +75,65 @@ ProcessExecutorComponent::ProcessExecutorComponent(
     m_oldOutlets = process().outlets();
 
     connect(&element, &Filter::Model::programChanged, this, &ProcessExecutorComponent::on_shaderChanged);
+    connect(&element, &Filter::Model::programBaked, this, &ProcessExecutorComponent::on_shaderBaked);
   }
   catch (...)
   {
   }
 }
 
+void ProcessExecutorComponent::set_script(Execution::Transaction& commands)
+{
+  auto n = std::dynamic_pointer_cast<filter_node>(this->node);
+  commands.push_back([n,
+                      shader = std::make_unique<ProcessedProgram>(process().processedProgram())] { n->set_script(shader->descriptor, shader->compiledVertex, shader->compiledFragment); });
+}
+
+void ProcessExecutorComponent::on_shaderBaked()
+{
+  if (!m_portsOutdated)
+  {
+    Execution::Transaction commands{system()};
+    set_script(commands);
+    commands.run_all();
+    return;
+  }
+
+  m_portsOutdated = false;
+  recreate_node();
+}
+
 void ProcessExecutorComponent::on_shaderChanged()
 {
   auto& setup = system().setup;
-  auto& element = this->process();
-  Execution::Transaction commands{system()};
-  auto n = std::dynamic_pointer_cast<filter_node>(this->node);
 
-  // 0. Unregister all the previous inlets / outlets
+  // The previous ports and script keep running until the new shaders are
+  // baked: on_shaderBaked then swaps them.
+  // The previous ports of the model are about to be deleted though.
   setup.unregister_node_soft(m_oldInlets, m_oldOutlets, node);
+  m_oldInlets.clear();
+  m_oldOutlets.clear();
+
+  if (!this->process().programCompiled())
+  {
+    m_portsOutdated = true;
+    return;
+  }
+
+  m_portsOutdated = false;
+  recreate_node();
+}
+
+void ProcessExecutorComponent::recreate_node()
+{
+  auto& setup = system().setup;
+  Execution::Transaction commands{system()};
 
   // 1. Recreate ports
   auto [inls, outls] = setup_node(commands);
 
   // 2. Change the script
-  const auto& shader = element.processedProgram();
-  commands.push_back([n,
-                      shader = std::make_unique<ProcessedProgram>(shader)] { n->set_script(shader->descriptor, shader->compiledVertex, shader->compiledFragment); });
+  set_script(commands);
 
   // 3. Register the inlets / outlets
   for (std::size_t i = 0; i < inls.size(); i++)
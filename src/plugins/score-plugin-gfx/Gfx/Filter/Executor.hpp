@@ -18,10 +18,18 @@ public:
       QObject* parent);
 
   void on_shaderChanged();
+  void on_shaderBaked();
   std::pair<ossia::inlets, ossia::outlets> setup_node(Execution::Transaction& transact);
+  void set_script(Execution::Transaction& transact);
 
   Process::Inlets m_oldInlets;
   Process::Outlets m_oldOutlets;
+
+private:
+  void recreate_node();
+
+  // The ports of the model changed but its shaders are still being baked
+  bool m_portsOutdated{};
 };
 
 using ProcessExecutorComponentFactory
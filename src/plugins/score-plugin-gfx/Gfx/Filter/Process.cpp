@@ -2,7 +2,6 @@
 
 #include <Gfx/Filter/PreviewWidget.hpp>
 #include <Gfx/Graph/Node.hpp>
-#include <Gfx/Graph/ShaderCache.hpp>
 #include <Gfx/TexturePort.hpp>
 #include <Process/Dataflow/Port.hpp>
 #include <Process/Dataflow/WidgetInlets.hpp>
@@ -102,7 +101,10 @@ void Model::setProgram(const ShaderProgram& f)
 {
   setVertex(f.vertex);
   setFragment(f.fragment);
-  if (const auto& [processed, error] = ProgramCache::instance().get(f);
+
+  // Only the ISF parsing is done here, the shaders are baked in the background:
+  // when loading a document, all the filters are thus compiled in parallel.
+  if (const auto& [processed, error] = ProgramCache::instance().prefetch(f);
       bool(processed))
   {
     auto inls = score::clearAndDeleteLater(m_inlets);
@@ -111,27 +113,43 @@ void Model::setProgram(const ShaderProgram& f)
     setupIsf(m_processedProgram.descriptor);
     inletsChanged();
     programChanged(m_program);
+
+    if (!programCompiled())
+    {
+      ProgramCache::instance().whenReady(
+          m_program, this, [this, program = m_program] {
+            on_programBaked(program);
+          });
+    }
   }
 }
 
-QString Model::prettyName() const noexcept
+void Model::on_programBaked(const ShaderProgram& program)
 {
-  return tr("GFX Filter");
-}
+  // The program may have been edited again in the meantime
+  if (program != m_program || programCompiled())
+    return;
 
-void Model::setupIsf(const isf::descriptor& desc)
-{
+  if (const auto& [processed, error] = ProgramCache::instance().get(m_program);
+      bool(processed))
   {
-    auto& [shader, error] = score::gfx::ShaderCache::get(
-        m_processedProgram.vertex.toLatin1(), QShader::Stage::VertexStage);
-    SCORE_ASSERT(error.isEmpty());
+    m_processedProgram.compiledVertex = processed->compiledVertex;
+    m_processedProgram.compiledFragment = processed->compiledFragment;
+    programBaked();
   }
+  else
   {
-    auto& [shader, error] = score::gfx::ShaderCache::get(
-        m_processedProgram.fragment.toLatin1(), QShader::Stage::FragmentStage);
-    SCORE_ASSERT(error.isEmpty());
+    errorMessage(error);
   }
+}
 
+QString Model::prettyName() const noexcept
+{
+  return tr("GFX Filter");
+}
+
+void Model::setupIsf(const isf::descriptor& desc)
+{
   int i = 0;
   using namespace isf;
   struct input_vis
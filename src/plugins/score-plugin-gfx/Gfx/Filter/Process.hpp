@@ -62,12 +62,24 @@ public:
     return m_processedProgram;
   }
 
+  //! True if the shaders of the current program are baked.
+  bool programCompiled() const noexcept
+  {
+    return m_processedProgram.compiledVertex.isValid()
+           && m_processedProgram.compiledFragment.isValid();
+  }
+
+  //! The shaders are baked in the background after programChanged:
+  //! this is emitted once they are available in processedProgram().
+  void programBaked() W_SIGNAL(programBaked);
+
   void errorMessage(const QString& arg_2) const W_SIGNAL(errorMessage, arg_2);
 
 private:
   void setupIsf(const isf::descriptor& d);
   //void setupNormalShader();
   QString prettyName() const noexcept override;
+  void on_programBaked(const ShaderProgram& program);
 
   ShaderProgram m_program;
   ProcessedProgram m_processedProgram;
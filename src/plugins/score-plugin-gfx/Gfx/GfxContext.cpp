@@ -1,5 +1,6 @@
 #include <Gfx/GfxContext.hpp>
 #include <Gfx/Graph/Graph.hpp>
+#include <Gfx/Graph/OutputNode.hpp>
 #include <Gfx/Settings/Model.hpp>
 
 #include <score/application/ApplicationContext.hpp>
@@ -72,7 +73,8 @@ void GfxContext::unregister_node(int32_t idx)
 
 void GfxContext::recompute_edges()
 {
-  m_graph->clearEdges();
+  std::vector<std::pair<score::gfx::Port*, score::gfx::Port*>> graph_edges;
+  graph_edges.reserve(edges.size());
 
   for (auto edge : edges)
   {
@@ -88,10 +90,12 @@ void GfxContext::recompute_edges()
       auto source_port = source_node_it->second->output[edge.first.port];
       auto sink_port = sink_node_it->second->input[edge.second.port];
 
-      m_graph->addEdge(source_port, sink_port);
+      graph_edges.emplace_back(source_port, sink_port);
     }
     }
   }
+
+  m_graph->updateEdges(graph_edges);
 }
 
 void GfxContext::recompute_graph()
@@ -137,13 +141,10 @@ void GfxContext::recompute_graph()
 
 void GfxContext::recompute_connections()
 {
-  recompute_graph();
-  // FIXME for more performance
-  /*
+  // Only the renderers affected by the change are recreated:
+  // the outputs keep rendering without interruption.
   recompute_edges();
-  // m_graph->setupOutputs(m_api);
   m_graph->relinkGraph();
-  */
 }
 
 void GfxContext::update_inputs()
@@ -164,6 +165,7 @@ void GfxContext::run_commands()
   std::vector<std::unique_ptr<score::gfx::Node>> nursery;
 
   bool recompute = false;
+  bool outputs_changed = false;
   Command cmd;
   while(tick_commands.try_dequeue(cmd))
   {
@@ -172,6 +174,8 @@ void GfxContext::run_commands()
       case Command::ADD_NODE:
       {
         m_graph->addNode(cmd.node.get());
+        if (dynamic_cast<score::gfx::OutputNode*>(cmd.node.get()))
+          outputs_changed = true;
         nodes[cmd.index] = {std::move(cmd.node)};
 
         recompute = true;
@@ -192,6 +196,8 @@ void GfxContext::run_commands()
         if (it != nodes.end())
         {
           m_graph->removeNode(it->second.get());
+          if (dynamic_cast<score::gfx::OutputNode*>(it->second.get()))
+            outputs_changed = true;
 
           // Needed because when removing edges in recompute_graph,
           // they remove themselves from the nodes / ports in their dtor
@@ -212,10 +218,14 @@ void GfxContext::run_commands()
 
   }
 
-  if(recompute)
+  if(outputs_changed)
   {
     recompute_graph();
   }
+  else if(recompute)
+  {
+    recompute_connections();
+  }
 
   nursery.clear();
 }
@@ -132,6 +132,10 @@ void Graph::createAllRenderLists(GraphicsApi graphicsApi)
   m_renderers.clear();
   m_outputs.clear();
 
+  // Everything gets recreated
+  m_changedSources.clear();
+  deleteRemovedEdges();
+
   for (auto node : m_nodes)
     if (auto out = dynamic_cast<OutputNode*>(node))
       m_outputs.push_back(out);
@@ -200,63 +204,98 @@ void Graph::relinkGraph()
 {
   for (auto& rptr : m_renderers)
   {
-    auto& r = *rptr;
-    for (auto& node : m_nodes)
-      node->addedToGraph = false;
+    relinkRenderList(*rptr);
+  }
+
+  m_changedSources.clear();
+  deleteRemovedEdges();
+}
+
+void Graph::relinkRenderList(RenderList& r)
+{
+  for (auto& node : m_nodes)
+    node->addedToGraph = false;
+
+  std::vector<score::gfx::Node*> model_nodes;
+  model_nodes.push_back(&r.output);
 
-    assert(!r.nodes.empty());
+  // In which order do we want to render stuff
+  graphwalk(model_nodes);
 
-    auto out = r.nodes.back();
-    r.nodes.clear();
-    r.nodes.push_back(out);
+  // Renderers are only initialized when there is something to render
+  const bool wasRendering = r.nodes.size() > 1;
+  const bool rendering = model_nodes.size() > 1;
 
-    r.renderers.clear();
+  // Release the renderers of the nodes which do not affect this output anymore
+  for (auto node : r.nodes)
+  {
+    if (ossia::contains(model_nodes, node))
+      continue;
 
-    auto& model_nodes = r.nodes;
+    if (auto it = node->renderedNodes.find(&r); it != node->renderedNodes.end())
     {
-      // In which order do we want to render stuff
-      graphwalk(model_nodes);
+      it->second->release(r);
+      delete it->second;
+      node->renderedNodes.erase(it);
+    }
+  }
 
-      if (model_nodes.size() > 1)
-      {
-        for (auto node : model_nodes)
-        {
-          score::gfx::NodeRenderer* rn{};
-          auto it = node->renderedNodes.find(&r);
-          if(it == node->renderedNodes.end())
-          {
-            rn = node->createRenderer(r);
-            SCORE_ASSERT(rn);
+  auto output_it = r.output.renderedNodes.find(&r);
+  SCORE_ASSERT(output_it != r.output.renderedNodes.end());
+  if (!rendering)
+  {
+    if (wasRendering)
+      output_it->second->release(r);
 
-            node->renderedNodes.emplace(&r, rn);
-            //rn->init(r);
-          }
-          else
-          {
-            rn = it->second;
-            SCORE_ASSERT(rn);
-            rn->release(r);
-            //rn->init(r);
-          }
-          SCORE_ASSERT(rn);
-          r.renderers.push_back(rn);
-        }
+    r.nodes = std::move(model_nodes);
+    r.renderers.assign(1, output_it->second);
+    r.output.onRendererChange();
+    return;
+  }
 
-        for (auto node : r.renderers)
-        {
-          node->init(r);
-        }
+  // The sinks come before their sources in model_nodes:
+  // when we reach a node, the render targets it renders to are final.
+  std::vector<score::gfx::Node*> rebuilt;
+  std::vector<Edge*> invalid;
+  r.renderers.clear();
+  for (auto node : model_nodes)
+  {
+    invalid.clear();
+    for (auto port : node->output)
+      for (auto edge : port->edges)
+        if (ossia::contains(rebuilt, edge->sink->node))
+          invalid.push_back(edge);
+
+    score::gfx::NodeRenderer* rn{};
+    if (auto it = node->renderedNodes.find(&r); it == node->renderedNodes.end())
+    {
+      rn = node->createRenderer(r);
+      SCORE_ASSERT(rn);
+      node->renderedNodes.emplace(&r, rn);
+
+      rn->init(r);
+      rebuilt.push_back(node);
+    }
+    else
+    {
+      rn = it->second;
+      SCORE_ASSERT(rn);
+      if (!wasRendering)
+      {
+        rn->init(r);
+        rebuilt.push_back(node);
       }
-      else if (model_nodes.size() == 1)
+      else if (!invalid.empty() || ossia::contains(m_changedSources, node))
       {
-        SCORE_ASSERT(model_nodes[0]->renderedNodes.find(&r) != model_nodes[0]->renderedNodes.end());
-        auto rn = model_nodes[0]->renderedNodes.find(&r)->second;
-        SCORE_ASSERT(rn);
-        rn->release(r);
+        if (rn->relink(r, invalid))
+          rebuilt.push_back(node);
       }
     }
-    r.output.onRendererChange();
+    r.renderers.push_back(rn);
   }
+
+  r.nodes = std::move(model_nodes);
+  r.output.onRendererChange();
 }
 
 void Graph::setVSyncCallback(std::function<void()> cb)
@@ -354,6 +393,50 @@ void Graph::clearEdges()
     delete edge;
   }
   m_edges.clear();
+  deleteRemovedEdges();
+}
+
+void Graph::updateEdges(const std::vector<std::pair<Port*, Port*>>& edges)
+{
+  // Detach the edges which are gone
+  for (auto it = m_edges.begin(); it != m_edges.end();)
+  {
+    Edge* edge = *it;
+    if (!ossia::contains(edges, std::make_pair(edge->source, edge->sink)))
+    {
+      ossia::remove_erase(edge->source->edges, edge);
+      ossia::remove_erase(edge->sink->edges, edge);
+      m_changedSources.push_back(edge->source->node);
+      m_removedEdges.push_back(edge);
+      it = m_edges.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  // Add the new ones
+  for (const auto& [source, sink] : edges)
+  {
+    auto same = [source = source, sink = sink](Edge* e) {
+      return e->source == source && e->sink == sink;
+    };
+    if (ossia::none_of(m_edges, same))
+    {
+      m_edges.push_back(new Edge{source, sink});
+      m_changedSources.push_back(source->node);
+    }
+  }
+}
+
+void Graph::deleteRemovedEdges()
+{
+  for (auto edge : m_removedEdges)
+  {
+    delete edge;
+  }
+  m_removedEdges.clear();
 }
 
 void Graph::addEdge(Port* source, Port* sink)
@@ -41,13 +41,27 @@ struct SCORE_PLUGIN_GFX_EXPORT Graph
    */
   void clearEdges();
 
+  /**
+   * @brief Replace the edges of the graph by a new set of edges.
+   *
+   * The edges which were already there are kept as-is, so that the renderers
+   * can keep the passes they created for them in relinkGraph.
+   */
+  void updateEdges(const std::vector<std::pair<Port*, Port*>>& edges);
+
   /**
    * @brief For each output node, create the sequence of render events that will be called.
    */
   void createAllRenderLists(GraphicsApi graphicsApi);
 
   /**
-   * @brief Recreate the connections between renderers when edges changed.
+   * @brief Update the render lists after nodes or edges changed.
+   *
+   * Unlike createAllRenderLists, this does not tear down the outputs:
+   * only the renderers of the nodes which were added are created,
+   * the ones of the nodes which are not rendered anymore are released,
+   * and the renderers whose outgoing edges changed recreate the affected passes.
+   * The set of output nodes must not have changed.
    */
   void relinkGraph();
 
@@ -71,9 +85,19 @@ private:
   std::vector<std::shared_ptr<Window>> m_unused_windows;
   std::function<void()> m_vsync_callback;
 
+  void relinkRenderList(RenderList& r);
+  void deleteRemovedEdges();
+
   std::vector<score::gfx::Node*> m_nodes;
   std::vector<Edge*> m_edges;
 
+  // Edges removed by updateEdges: they are detached from their ports
+  // but kept alive until the renderers have forgotten them.
+  std::vector<Edge*> m_removedEdges;
+
+  // Nodes whose outgoing edges changed since the last relink
+  std::vector<score::gfx::Node*> m_changedSources;
+
   std::vector<OutputNode*> m_outputs;
 };
 }
@@ -4,6 +4,7 @@
 #include <Gfx/Graph/RenderState.hpp>
 #include <ossia/network/value/value_conversion.hpp>
 
+#include <Gfx/Images/ImageCache.hpp>
 #include <Gfx/Images/Process.hpp>
 
 
@@ -110,15 +111,6 @@ void ImagesNode::process(const Message& msg)
         {
           auto sink = ossia::gfx::port_index{msg.node_id, p };
           std::visit([this, sink] (const auto& v) { ProcessNode::process(sink.port, v); }, std::move(m));
-
-          if(linearImages.size() > 0)
-          {
-            const int idx = imageIndex(ubo.currentImageIndex, linearImages.size());
-            auto sz = linearImages[idx]->size();
-            ubo.imageSize[0] = sz.width();
-            ubo.imageSize[1] = sz.height();
-          }
-
           break;
         }
         case 1: // Opacity
@@ -151,25 +143,17 @@ void ImagesNode::process(const Message& msg)
         case 5: // Images
         {
           {
-            linearImages.clear();
-            Gfx::releaseImages(images);
-            images = Gfx::getImages(*val);
-            for(auto& img : images)
+            // Decoded in the background, as the renderers ask for the frames
+            frames.clear();
+            for(auto& path : Gfx::getImagePaths(*val))
             {
-              for(auto& frame : img.frames)
+              const int count = Gfx::ImageCache::frameCount(path);
+              for(int i = 0; i < count; i++)
               {
-                linearImages.push_back(&frame);
+                frames.push_back({path, i});
               }
             }
 
-            if(linearImages.size() > 0)
-            {
-              const int idx = imageIndex(ubo.currentImageIndex, linearImages.size());
-              auto sz = linearImages[idx]->size();
-              ubo.imageSize[0] = sz.width();
-              ubo.imageSize[1] = sz.height();
-            }
-
             ++this->imagesChanged;
           }
           break;
@@ -184,11 +168,15 @@ void ImagesNode::process(const Message& msg)
 
 ImagesNode::~ImagesNode()
 {
-  Gfx::releaseImages(images);
   m_materialData.release();
 }
 
 #include <Gfx/Qt5CompatPush> // clang-format: keep
+/**
+ * Only the frames around the current one have a texture:
+ * they are uploaded as soon as the ImageCache has decoded them,
+ * a few per update, and their mipmaps are generated once.
+ */
 class ImagesNode::Renderer : public GenericNodeRenderer
 {
 public:
@@ -197,29 +185,14 @@ public:
 private:
   ~Renderer() { }
 
-  int imagesChanged = -1;
-
-  void recreateTextures(QRhi& rhi)
-  {
-    auto& n = static_cast<const ImagesNode&>(this->node);
+  // Frames kept on the GPU around the current one
+  static constexpr int frames_before = 2;
+  static constexpr int frames_after = 8;
 
-    const int limits_min = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMin);
-    const int limits_max = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMax);
+  // New textures uploaded in one update, besides the current frame
+  static constexpr int max_uploads = 2;
 
-    for (const QImage* frame : n.linearImages)
-    {
-      const QSize sz = frame->size();
-      auto tex = rhi.newTexture(
-          QRhiTexture::BGRA8,
-          resizeTextureSize(QSize{sz.width(), sz.height()}, limits_min, limits_max),
-          1,
-          QRhiTexture::Flag{});
-
-      tex->setName("ImagesNode::tex");
-      tex->create();
-      m_textures.push_back(tex);
-    }
-  }
+  int imagesChanged = -1;
 
   TextureRenderTarget renderTargetForInput(const Port& p) override { return { }; }
   void init(RenderList& renderer) override
@@ -229,89 +202,141 @@ private:
     processUBOInit(renderer);
     m_material.init(renderer, node.input, m_samplers);
 
-    m_prev_ubo.currentImageIndex = -1;
-    QRhi& rhi = *renderer.state.rhi;
-
-    // Create GPU textures for each image
-    recreateTextures(rhi);
+    m_current = -1;
 
     // Create the sampler in which we are going to put the texture
     {
+      auto& rhi = *renderer.state.rhi;
       auto sampler = rhi.newSampler(
           QRhiSampler::Linear,
           QRhiSampler::Linear,
-          QRhiSampler::None,
+          QRhiSampler::Linear,
           QRhiSampler::Mirror,
           QRhiSampler::Mirror);
 
       sampler->setName("ImagesNode::sampler");
       sampler->create();
-      auto tex = m_textures.empty() ? &renderer.emptyTexture() : m_textures.front();
-      m_samplers.push_back({sampler, tex});
+      m_samplers.push_back({sampler, &renderer.emptyTexture()});
     }
 
     defaultPassesInit(renderer, mesh);
   }
 
+  QRhiTexture* texture(int frame) const noexcept
+  {
+    for (auto& [k, tex] : m_textures)
+      if (k == frame)
+        return tex;
+    return nullptr;
+  }
+
+  // Does nothing until the frame is decoded
+  void upload(RenderList& renderer, QRhiResourceUpdateBatch& res, int frame)
+  {
+    auto& n = static_cast<const ImagesNode&>(this->node);
+    auto& f = n.frames[frame];
+    auto img = Gfx::ImageCache::instance().tryAcquire(f.path);
+    if (!img || img->frames.empty())
+      return;
+
+    auto& rhi = *renderer.state.rhi;
+    const int limits_min = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMin);
+    const int limits_max = rhi.resourceLimit(QRhi::ResourceLimit::TextureSizeMax);
+
+    const QImage& image
+        = img->frames[std::min(f.index, int(img->frames.size()) - 1)];
+    auto tex = rhi.newTexture(
+        QRhiTexture::BGRA8,
+        resizeTextureSize(image.size(), limits_min, limits_max),
+        1,
+        QRhiTexture::MipMapped | QRhiTexture::UsedWithGenerateMips);
+
+    tex->setName("ImagesNode::tex");
+    tex->create();
+
+    res.uploadTexture(tex, resizeTexture(image, limits_min, limits_max));
+    res.generateMips(tex);
+    m_textures.emplace_back(frame, tex);
+  }
+
+  void releaseTextures()
+  {
+    for (auto& [k, tex] : m_textures)
+      tex->deleteLater();
+    m_textures.clear();
+  }
+
+  void bind(QRhiTexture* tex)
+  {
+    auto& sampler = m_samplers[0].sampler;
+    for(auto& pass : m_p)
+    {
+      score::gfx::replaceTexture(*pass.second.srb, sampler, tex);
+    }
+    m_samplers[0].texture = tex;
+  }
+
   void
   update(RenderList& renderer, QRhiResourceUpdateBatch& res) override
   {
     auto& n = static_cast<const ImagesNode&>(this->node);
-    bool updateCurrentTexture = false;
     if(n.imagesChanged > imagesChanged)
     {
       imagesChanged = n.imagesChanged;
-      for(auto tex : m_textures)
-      {
-        tex->deleteLater();
-      }
-      m_textures.clear();
-
-      recreateTextures(*renderer.state.rhi);
-      m_uploaded = false;
+      bind(&renderer.emptyTexture());
+      releaseTextures();
+      m_current = -1;
     }
 
-    // If images haven't been uploaded yet, upload them.
-    if (!m_uploaded)
+    const int count = n.frames.size();
+    if (count > 0)
     {
-      const int limits_min = renderer.state.rhi->resourceLimit(QRhi::ResourceLimit::TextureSizeMin);
-      const int limits_max = renderer.state.rhi->resourceLimit(QRhi::ResourceLimit::TextureSizeMax);
-
-      std::size_t k = 0;
-      for (const QImage* frame : n.linearImages)
+      const int idx = imageIndex(n.ubo.currentImageIndex, count);
+
+      // Frames out of the window around the current one are released
+      auto out_of_window = [=](int frame) {
+        const int d = (frame - idx + count) % count;
+        return d > frames_after && d < count - frames_before;
+      };
+      for (auto it = m_textures.begin(); it != m_textures.end();)
       {
-        res.uploadTexture(m_textures[k], resizeTexture(*frame, limits_min, limits_max));
-        k++;
+        if (out_of_window(it->first) && it->second != m_samplers[0].texture)
+        {
+          it->second->deleteLater();
+          it = m_textures.erase(it);
+        }
+        else
+        {
+          ++it;
+        }
       }
-      m_uploaded = true;
-      updateCurrentTexture = true;
-    }
 
-
-    // If the current image being displayed by this renderer (in m_prev_ubo)
-    // is out of date with the image in the data model, we switch the texture
-    if (updateCurrentTexture || m_prev_ubo.currentImageIndex != n.ubo.currentImageIndex)
-    {
-      auto& sampler = m_samplers[0].sampler;
-      if (!m_textures.empty())
+      // The current frame, then the next ones, then the previous ones
+      int uploads = 0;
+      for (int d = 0; d <= frames_after + frames_before; d++)
       {
-        const int idx = imageIndex(n.ubo.currentImageIndex, m_textures.size());
+        const int frame = d <= frames_after
+                              ? (idx + d) % count
+                              : (idx - (d - frames_after) + count) % count;
+        if (texture(frame))
+          continue;
+        if (d > 0 && uploads >= max_uploads)
+          break;
 
-        for(auto& pass : m_p)
-        {
-          score::gfx::replaceTexture(
-              *pass.second.srb, sampler, m_textures[idx]);
-        }
+        const auto textures = m_textures.size();
+        upload(renderer, res, frame);
+        uploads += m_textures.size() - textures;
       }
-      else
+
+      // Until it is decoded, the previous frame stays displayed
+      if (idx != m_current)
       {
-        for(auto& pass : m_p)
+        if (auto tex = texture(idx))
         {
-          score::gfx::replaceTexture(
-              *pass.second.srb, sampler, &renderer.emptyTexture());
+          bind(tex);
+          m_current = idx;
         }
       }
-      m_prev_ubo.currentImageIndex = n.ubo.currentImageIndex;
     }
 
     defaultUBOUpdate(renderer, res);
@@ -329,18 +354,13 @@ private:
 
   void release(RenderList& r) override
   {
-    for (auto tex : m_textures)
-    {
-      tex->deleteLater();
-    }
-    m_textures.clear();
+    releaseTextures();
 
     defaultRelease(r);
   }
 
-  struct ImagesNode::UBO m_prev_ubo;
-  std::vector<QRhiTexture*> m_textures;
-  bool m_uploaded = false;
+  std::vector<std::pair<int, QRhiTexture*>> m_textures;
+  int m_current{-1};
 };
 #include <Gfx/Qt5CompatPop> // clang-format: keep
 
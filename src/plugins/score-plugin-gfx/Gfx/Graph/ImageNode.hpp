@@ -32,8 +32,13 @@ public:
 private:
   void process(const Message& msg) override;
 
-  std::vector<score::gfx::Image> images;
-  std::vector<QImage*> linearImages;
+  //! A frame of one of the image files
+  struct Frame
+  {
+    QString path;
+    int index{};
+  };
+  std::vector<Frame> frames;
 };
 struct FullScreenImageNode : NodeModel
 {
@@ -36,8 +36,12 @@ void GenericNodeRenderer::processUBOInit(RenderList& renderer)
 
 void GenericNodeRenderer::defaultPassesInit(RenderList& renderer, const Mesh& mesh)
 {
+  m_passesMesh = &mesh;
   for(Edge* edge : this->node.output[0]->edges)
   {
+    if(ossia::find_if(m_p, [edge] (const auto& p){ return p.first == edge; }) != m_p.end())
+      continue;
+
     auto rt = renderer.renderTargetForOutput(*edge);
     if(rt.renderTarget)
     {
@@ -108,6 +112,39 @@ void GenericNodeRenderer::defaultRelease(RenderList&)
   m_meshBuffer = nullptr;
 }
 
+bool GenericNodeRenderer::relink(RenderList& renderer, const std::vector<Edge*>& invalid)
+{
+  // Renderer which does not use the default passes
+  if(!m_passesMesh)
+    return NodeRenderer::relink(renderer, invalid);
+
+  // Release the pipelines of the edges which are gone or whose sink changed
+  const auto& edges = this->node.output[0]->edges;
+  for(auto it = m_p.begin(); it != m_p.end(); )
+  {
+    if(!ossia::contains(edges, it->first) || ossia::contains(invalid, it->first))
+    {
+      it->second.release();
+      it = m_p.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  // Create the missing ones; samplers, UBOs and the other pipelines are kept
+  defaultPassesInit(renderer, *m_passesMesh);
+  return false;
+}
+
+bool NodeRenderer::relink(RenderList& renderer, const std::vector<Edge*>& invalid)
+{
+  release(renderer);
+  init(renderer);
+  return true;
+}
+
 void NodeRenderer::runInitialPasses(
     RenderList&,
     QRhiCommandBuffer& commands,
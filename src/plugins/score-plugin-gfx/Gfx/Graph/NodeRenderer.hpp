@@ -31,6 +31,18 @@ public:
       Edge& edge);
 
   virtual void release(RenderList&) = 0;
+
+  /**
+   * @brief Update the passes of this renderer after the graph was edited.
+   *
+   * Called when edges going out of the node were added or removed,
+   * or when the sinks of the edges in @p invalid got new render targets.
+   *
+   * Renderers which only recreate the affected passes, and thus keep their
+   * own input render targets, return false.
+   * The default implementation rebuilds the whole renderer and returns true.
+   */
+  virtual bool relink(RenderList& renderer, const std::vector<Edge*>& invalid);
 };
 
 /**
@@ -60,6 +72,7 @@ public:
 
   // Pipeline
   ossia::small_vector<std::pair<Edge*, Pipeline>, 2> m_p;
+  const Mesh* m_passesMesh{};
 
   QRhiBuffer* m_meshBuffer{};
   QRhiBuffer* m_idxBuffer{};
@@ -81,6 +94,8 @@ public:
   void defaultRelease(RenderList&);
   void release(RenderList&) override;
 
+  bool relink(RenderList& renderer, const std::vector<Edge*>& invalid) override;
+
   void defaultRenderPass(
       RenderList&,
       const Mesh& mesh,
@@ -21,6 +21,54 @@ static void storeTextureRectUniform(char* buffer, int& cur_pos, QSize texSize)
   cur_pos += 16;
 }
 
+static const constexpr auto final_pass_vertex_shader = R"_(#version 450
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texcoord;
+
+layout(binding = 3) uniform sampler2D y_tex;
+layout(location = 0) out vec2 v_texcoord;
+
+layout(std140, binding = 0) uniform renderer_t {
+  mat4 clipSpaceCorrMatrix;
+  vec2 texcoordAdjust;
+  vec2 renderSize;
+};
+
+out gl_PerVertex { vec4 gl_Position; };
+
+void main()
+{
+  v_texcoord = texcoord;
+  gl_Position = clipSpaceCorrMatrix * vec4(position.xy, 0.0, 1.);
+}
+)_";
+
+static const constexpr auto final_pass_fragment_shader = R"_(#version 450
+layout(std140, binding = 0) uniform renderer_t {
+  mat4 clipSpaceCorrMatrix;
+  vec2 texcoordAdjust;
+  vec2 renderSize;
+};
+
+layout(binding=3) uniform sampler2D y_tex;
+
+layout(location = 0) in vec2 v_texcoord;
+layout(location = 0) out vec4 fragColor;
+
+void main ()
+{
+  vec2 factor = textureSize(y_tex, 0) / renderSize;
+  vec2 ifactor = renderSize / textureSize(y_tex, 0);
+  vec2 texcoord = vec2(v_texcoord.x, texcoordAdjust.y + texcoordAdjust.x * v_texcoord.y);
+  fragColor = texture(y_tex, texcoord);
+}
+)_";
+
+std::pair<QByteArray, QByteArray> isfFinalPassShaders()
+{
+  return {final_pass_vertex_shader, final_pass_fragment_shader};
+}
+
 RenderedISFNode::~RenderedISFNode() { }
 PassOutput RenderedISFNode::initPassSampler(
     ISFNode& n,
@@ -205,55 +253,13 @@ RenderedISFNode::createFinalPass(RenderList& renderer, ossia::small_vector<PassO
 {
   std::pair<Pass, Pass> ret;
 
-  static const constexpr auto vertex_shader = R"_(#version 450
-layout(location = 0) in vec2 position;
-layout(location = 1) in vec2 texcoord;
-
-layout(binding = 3) uniform sampler2D y_tex;
-layout(location = 0) out vec2 v_texcoord;
-
-layout(std140, binding = 0) uniform renderer_t {
-  mat4 clipSpaceCorrMatrix;
-  vec2 texcoordAdjust;
-  vec2 renderSize;
-};
-
-out gl_PerVertex { vec4 gl_Position; };
-
-void main()
-{
-  v_texcoord = texcoord;
-  gl_Position = clipSpaceCorrMatrix * vec4(position.xy, 0.0, 1.);
-}
-)_";
-
-  static const constexpr auto fragment_shader = R"_(#version 450
-layout(std140, binding = 0) uniform renderer_t {
-  mat4 clipSpaceCorrMatrix;
-  vec2 texcoordAdjust;
-  vec2 renderSize;
-};
-
-layout(binding=3) uniform sampler2D y_tex;
-
-layout(location = 0) in vec2 v_texcoord;
-layout(location = 0) out vec4 fragColor;
-
-void main ()
-{
-  vec2 factor = textureSize(y_tex, 0) / renderSize;
-  vec2 ifactor = renderSize / textureSize(y_tex, 0);
-  vec2 texcoord = vec2(v_texcoord.x, texcoordAdjust.y + texcoordAdjust.x * v_texcoord.y);
-  fragColor = texture(y_tex, texcoord);
-}
-)_";
-
-  auto [vertexS, vertexError]
-      = score::gfx::ShaderCache::get(vertex_shader, QShader::VertexStage);
+  // Baked along with the program by Gfx::ProgramCache
+  auto [vertexS, vertexError] = score::gfx::ShaderCache::get(
+      final_pass_vertex_shader, QShader::VertexStage);
   SCORE_ASSERT (vertexError.isEmpty());
 
   auto [fragmentS, fragmentError] = score::gfx::ShaderCache::get(
-      fragment_shader, QShader::FragmentStage);
+      final_pass_fragment_shader, QShader::FragmentStage);
   SCORE_ASSERT(fragmentError.isEmpty());
 
   SCORE_ASSERT(vertexS.isValid() && fragmentS.isValid());
@@ -1087,6 +1093,41 @@ void SimpleRenderedISFNode::release(RenderList& r)
   m_meshBuffer = nullptr;
 }
 
+bool SimpleRenderedISFNode::relink(RenderList& renderer, const std::vector<Edge*>& invalid)
+{
+  // Release the passes of the edges which are gone or whose sink changed
+  const auto& edges = n.output[0]->edges;
+  for(auto it = m_passes.begin(); it != m_passes.end(); )
+  {
+    if(!ossia::contains(edges, it->first) || ossia::contains(invalid, it->first))
+    {
+      it->second.p.release();
+      if(it->second.processUBO)
+        it->second.processUBO->deleteLater();
+      it = m_passes.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  // Create the passes for the new edges.
+  // The input render targets and the samplers are kept.
+  for(Edge* edge : edges)
+  {
+    if(ossia::find_if(m_passes, [edge] (const auto& p) { return p.first == edge; }) != m_passes.end())
+      continue;
+
+    auto rt = renderer.renderTargetForOutput(*edge);
+    if(rt.renderTarget)
+    {
+      initPass(rt, renderer, *edge);
+    }
+  }
+  return false;
+}
+
 void SimpleRenderedISFNode::runInitialPasses(
     RenderList& renderer,
     QRhiCommandBuffer& cb,
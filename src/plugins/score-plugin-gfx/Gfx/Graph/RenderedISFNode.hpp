@@ -22,6 +22,14 @@ struct PersistSampler
 };
 using PassOutput = std::variant<PersistSampler, TextureRenderTarget>;
 
+/**
+ * @brief Vertex and fragment shaders of the pass which copies the last
+ * persistent pass of an ISF shader to its render target.
+ *
+ * They are the same for every ISF shader.
+ */
+std::pair<QByteArray, QByteArray> isfFinalPassShaders();
+
 struct AudioTextureUpload
 {
   explicit AudioTextureUpload();
@@ -139,6 +147,7 @@ struct SimpleRenderedISFNode : score::gfx::NodeRenderer
   void init(RenderList& renderer) override;
   void update(RenderList& renderer, QRhiResourceUpdateBatch& res) override;
   void release(RenderList& r) override;
+  bool relink(RenderList& renderer, const std::vector<Edge*>& invalid) override;
 
   void runInitialPasses(
       RenderList&,
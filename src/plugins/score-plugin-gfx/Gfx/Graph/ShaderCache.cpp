@@ -0,0 +1,305 @@
+#include <Gfx/Graph/ShaderCache.hpp>
+
+#include <score/tools/CacheFolder.hpp>
+#include <score/tools/ThreadPool.hpp>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+#include <QThread>
+
+#include <algorithm>
+#include <vector>
+
+namespace score::gfx
+{
+namespace
+{
+// Bump when the format of the cache files changes
+static constexpr int shader_cache_format = 1;
+static constexpr quint32 shader_cache_magic = 0x53435348; // SCSH
+
+// Evicted on startup when above this size, oldest-used files first
+static constexpr qint64 shader_cache_max_size = 256 * 1024 * 1024;
+}
+
+ShaderCache::ShaderCache()
+{
+  QShaderVersion::Flags glFlag = m_caps.type == QSurfaceFormat::OpenGLES
+                                     ? QShaderVersion::GlslEs
+                                     : QShaderVersion::Flag{};
+  m_targets = {
+    {QShader::SpirvShader, 100},
+        {QShader::GlslShader, QShaderVersion(m_caps.shaderVersion, glFlag)},
+#if defined(_WIN32)
+        {QShader::HlslShader, QShaderVersion(50)},
+#endif
+#if defined(__APPLE__)
+        {QShader::MslShader, QShaderVersion(12)},
+#endif
+  };
+
+  // Part of the key which depends on the machine:
+  // the same source may give different results with another GL version.
+  for (const auto& target : m_targets)
+  {
+    m_targetsKey += QByteArray::number(int(target.first)) + ':'
+                    + QByteArray::number(target.second.version()) + ':'
+                    + QByteArray::number(int(target.second.flags())) + ';';
+  }
+
+  // glslang is CPU-bound: leave a core for the GUI and render threads
+  m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+
+  evict();
+}
+
+ShaderCache& ShaderCache::instance()
+{
+  static ShaderCache self;
+  return self;
+}
+
+const std::pair<QShader, QString>&
+ShaderCache::get(const QByteArray& shader, QShader::Stage stage)
+{
+  auto& self = instance();
+  std::shared_future<std::pair<QShader, QString>> pending;
+  {
+    std::lock_guard lock{self.m_mutex};
+    if (auto it = self.shaders.find(shader); it != self.shaders.end())
+      return it->second;
+    if (auto it = self.m_pending.find(shader); it != self.m_pending.end())
+      pending = it->second;
+  }
+
+  if (pending.valid())
+  {
+    // The worker stores its result in the cache before completing
+    pending.wait();
+    std::lock_guard lock{self.m_mutex};
+    if (auto it = self.shaders.find(shader); it != self.shaders.end())
+      return it->second;
+  }
+
+  auto res = self.bake(shader, stage);
+
+  std::lock_guard lock{self.m_mutex};
+  return self.shaders.insert({shader, std::move(res)}).first->second;
+}
+
+std::shared_future<std::pair<QShader, QString>>
+ShaderCache::getAsync(const QByteArray& shader, QShader::Stage stage)
+{
+  auto& self = instance();
+  std::lock_guard lock{self.m_mutex};
+  if (auto it = self.shaders.find(shader); it != self.shaders.end())
+  {
+    std::promise<std::pair<QShader, QString>> ready;
+    ready.set_value(it->second);
+    return ready.get_future().share();
+  }
+
+  if (auto it = self.m_pending.find(shader); it != self.m_pending.end())
+    return it->second;
+
+  auto promise = std::make_shared<std::promise<std::pair<QShader, QString>>>();
+  auto future = promise->get_future().share();
+  self.m_pending.insert({shader, future});
+  score::startOnPool(self.m_pool, [&self, shader, stage, promise] {
+    auto res = self.bake(shader, stage);
+
+    std::vector<std::function<void()>> continuations;
+    {
+      std::lock_guard lock{self.m_mutex};
+      self.shaders.insert({shader, res});
+      self.m_pending.erase(shader);
+      if (auto it = self.m_continuations.find(shader);
+          it != self.m_continuations.end())
+      {
+        continuations = std::move(it->second);
+        self.m_continuations.erase(it);
+      }
+    }
+
+    promise->set_value(std::move(res));
+    self.m_bakeCount.fetch_add(1, std::memory_order_release);
+    for (auto& f : continuations)
+      f();
+  });
+  return future;
+}
+
+void ShaderCache::whenBaked(
+    const QByteArray& shader,
+    QShader::Stage stage,
+    std::function<void()> onBaked)
+{
+  auto& self = instance();
+  getAsync(shader, stage);
+  {
+    // The continuations are taken along with the insertion of the result
+    std::lock_guard lock{self.m_mutex};
+    if (self.shaders.find(shader) == self.shaders.end())
+    {
+      self.m_continuations[shader].push_back(std::move(onBaked));
+      return;
+    }
+  }
+  onBaked();
+}
+
+const std::pair<QShader, QString>*
+ShaderCache::tryGet(const QByteArray& shader, QShader::Stage stage)
+{
+  auto& self = instance();
+  {
+    std::lock_guard lock{self.m_mutex};
+    if (auto it = self.shaders.find(shader); it != self.shaders.end())
+      return &it->second;
+  }
+  getAsync(shader, stage);
+  return nullptr;
+}
+
+int64_t ShaderCache::bakeCount() noexcept
+{
+  return instance().m_bakeCount.load(std::memory_order_acquire);
+}
+
+std::pair<QShader, QString>
+ShaderCache::bake(const QByteArray& shader, QShader::Stage stage) const
+{
+  const QByteArray key = diskKey(shader, stage);
+
+  std::pair<QShader, QString> res;
+  if (!load(key, res))
+  {
+    auto& baker = threadBaker();
+    baker.setSourceString(shader, stage);
+    res = {baker.bake(), baker.errorMessage()};
+    save(key, res);
+  }
+  return res;
+}
+
+QShaderBaker& ShaderCache::threadBaker() const
+{
+  // QShaderBaker is not reentrant: each thread which bakes gets its own.
+  thread_local QShaderBaker baker;
+  thread_local bool configured = false;
+  if (!configured)
+  {
+    baker.setGeneratedShaders(m_targets);
+    baker.setGeneratedShaderVariants({
+      QShader::Variant{}, QShader::Variant{},
+#if defined(_WIN32)
+          QShader::Variant{},
+#endif
+#if defined(__APPLE__)
+          QShader::Variant{},
+#endif
+    });
+    configured = true;
+  }
+  return baker;
+}
+
+QString ShaderCache::diskCachePath()
+{
+  // Generic location so that the cache is shared between score and the player
+  auto caches
+      = QStandardPaths::standardLocations(QStandardPaths::GenericCacheLocation);
+  if (caches.empty())
+    caches = QStandardPaths::standardLocations(QStandardPaths::TempLocation);
+  if (caches.empty())
+    return {};
+
+  return QStringLiteral("%1/ossia-score/shaders/%2-%3")
+      .arg(caches.front())
+      .arg(shader_cache_format)
+      .arg(QStringLiteral(QT_VERSION_STR));
+}
+
+void ShaderCache::clearDiskCache()
+{
+  // The memory cache is kept: get() hands out references into it
+  const auto path = diskCachePath();
+  if (path.isEmpty())
+    return;
+
+  // Also removes the caches of previous formats / Qt versions
+  QDir dir{path};
+  if (dir.cdUp())
+    dir.removeRecursively();
+}
+
+QByteArray
+ShaderCache::diskKey(const QByteArray& shader, QShader::Stage stage) const
+{
+  QCryptographicHash h{QCryptographicHash::Sha1};
+  h.addData(m_targetsKey);
+  h.addData(QByteArray::number(int(stage)));
+  h.addData(shader);
+  return h.result().toHex();
+}
+
+bool ShaderCache::load(
+    const QByteArray& key,
+    std::pair<QShader, QString>& res) const
+{
+  const auto path = diskCachePath();
+  if (path.isEmpty())
+    return false;
+
+  QFile f{path + "/" + key};
+  if (!f.open(QIODevice::ReadOnly))
+    return false;
+
+  QDataStream s{&f};
+  quint32 magic{};
+  QByteArray serialized;
+  QString error;
+  s >> magic >> serialized >> error;
+  if (s.status() != QDataStream::Ok || magic != shader_cache_magic)
+    return false;
+
+  QShader shader = QShader::fromSerialized(serialized);
+  if (!shader.isValid() && error.isEmpty())
+    return false;
+
+  score::touchCacheFile(f.fileName());
+
+  res = {std::move(shader), std::move(error)};
+  return true;
+}
+
+void ShaderCache::save(
+    const QByteArray& key,
+    const std::pair<QShader, QString>& res) const
+{
+  const auto path = diskCachePath();
+  if (path.isEmpty())
+    return;
+
+  if (!QDir{}.mkpath(path))
+    return;
+
+  score::writeCacheFile(path + "/" + key, [&](const QString& tmp_path) {
+    QFile f{tmp_path};
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+      return false;
+
+    QDataStream s{&f};
+    s << shader_cache_magic << res.first.serialized() << res.second;
+    return s.status() == QDataStream::Ok;
+  });
+}
+
+void ShaderCache::evict() const
+{
+  score::evictCacheFolder(diskCachePath(), {}, shader_cache_max_size);
+}
+}
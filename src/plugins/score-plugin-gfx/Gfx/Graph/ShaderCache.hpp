@@ -7,14 +7,35 @@
 #include <QtShaderTools/private/qshaderbaker_p.h>
 #endif
 
+#include <QThreadPool>
+
+#include <score_plugin_gfx_export.h>
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace score::gfx
 {
 /**
  * @brief Cache of baked QShader instances
+ *
+ * Baked shaders are kept in memory, and also stored on disk so that
+ * the next launches of score or of the player do not have to bake them again.
+ *
+ * The disk cache is keyed by a hash of the source, the stage, the
+ * generated shader targets and the Qt version.
+ * Files which have not been used for a while are evicted on startup
+ * if the cache grows too large.
+ *
+ * Shaders can also be baked in the background on a dedicated thread pool
+ * with getAsync: this is used to compile many shaders in parallel,
+ * e.g. when loading a document, without blocking the calling thread.
  */
-struct ShaderCache
+struct SCORE_PLUGIN_GFX_EXPORT ShaderCache
 {
 public:
   /**
@@ -23,48 +44,76 @@ public:
    * @return If there is an error message, it will be in the QString part of the pair.
    */
   static const std::pair<QShader, QString>&
-  get(const QByteArray& shader, QShader::Stage stage)
-  {
-    static ShaderCache self;
-    if (auto it = self.shaders.find(shader); it != self.shaders.end())
-      return it->second;
-
-    self.baker.setSourceString(shader, stage);
-    auto res = self.shaders.insert(
-        {shader, {self.baker.bake(), self.baker.errorMessage()}});
-    return res.first->second;
-  }
+  get(const QByteArray& shader, QShader::Stage stage);
+
+  /**
+   * @brief Bake a QShader on a worker thread.
+   *
+   * If the shader is already being baked, the existing future is returned.
+   * get() called with the same source waits for the background bake
+   * instead of starting another one.
+   */
+  static std::shared_future<std::pair<QShader, QString>>
+  getAsync(const QByteArray& shader, QShader::Stage stage);
+
+  /**
+   * @brief Calls onBaked once the shader is baked, starting the bake if needed.
+   *
+   * onBaked is called on the thread which bakes the shader, or directly if
+   * the shader is already baked: it must only hand the result over.
+   */
+  static void whenBaked(
+      const QByteArray& shader,
+      QShader::Stage stage,
+      std::function<void()> onBaked);
+
+  /**
+   * @brief Get a QShader only if it is already baked.
+   *
+   * Otherwise the shader is baked in the background and nullptr is returned:
+   * bakeCount() changes once the bake is done. Used by the render thread.
+   */
+  static const std::pair<QShader, QString>*
+  tryGet(const QByteArray& shader, QShader::Stage stage);
+
+  //! Number of shaders baked in the background so far.
+  static int64_t bakeCount() noexcept;
+
+  //! Folder where the baked shaders are stored.
+  static QString diskCachePath();
+
+  //! Removes every shader stored on disk.
+  //! The shaders already in memory stay valid until the application exits.
+  static void clearDiskCache();
 
 private:
-  score::GLCapabilities m_caps;
-  ShaderCache()
-  {
-    QShaderVersion::Flags glFlag = m_caps.type == QSurfaceFormat::OpenGLES
-                                       ? QShaderVersion::GlslEs
-                                       : QShaderVersion::Flag{};
-    baker.setGeneratedShaders({
-      {QShader::SpirvShader, 100},
-          {QShader::GlslShader, QShaderVersion(m_caps.shaderVersion, glFlag)},
-#if defined(_WIN32)
-          {QShader::HlslShader, QShaderVersion(50)},
-#endif
-#if defined(__APPLE__)
-          {QShader::MslShader, QShaderVersion(12)},
-#endif
-    });
+  ShaderCache();
+  static ShaderCache& instance();
 
-    baker.setGeneratedShaderVariants({
-      QShader::Variant{}, QShader::Variant{},
-#if defined(_WIN32)
-          QShader::Variant{},
-#endif
-#if defined(__APPLE__)
-          QShader::Variant{},
-#endif
-    });
-  }
+  std::pair<QShader, QString>
+  bake(const QByteArray& shader, QShader::Stage stage) const;
+  QShaderBaker& threadBaker() const;
+
+  QByteArray diskKey(const QByteArray& shader, QShader::Stage stage) const;
+  bool load(const QByteArray& key, std::pair<QShader, QString>& res) const;
+  void save(const QByteArray& key, const std::pair<QShader, QString>& res) const;
+  void evict() const;
 
-  QShaderBaker baker;
+  score::GLCapabilities m_caps;
+  QVector<QShaderBaker::GeneratedShader> m_targets;
+  QByteArray m_targetsKey;
+
+  std::mutex m_mutex;
   std::unordered_map<QByteArray, std::pair<QShader, QString>> shaders;
+  std::unordered_map<
+      QByteArray,
+      std::shared_future<std::pair<QShader, QString>>>
+      m_pending;
+  std::unordered_map<QByteArray, std::vector<std::function<void()>>>
+      m_continuations;
+  std::atomic<int64_t> m_bakeCount{};
+
+  // Last so that it is destroyed first: waits for the running bakes
+  QThreadPool m_pool;
 };
 }
@@ -6,6 +6,16 @@
 #include <Gfx/Graph/RenderState.hpp>
 #include <Gfx/Graph/Uniforms.hpp>
 
+#include <score/tools/ThreadPool.hpp>
+
+#include <QThread>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+
 namespace score::gfx
 {
 
@@ -60,15 +70,44 @@ struct TexgenNode : NodeModel
     float position[2];
   } ubo;
 
+  // Shared by all the texgen renderers
+  struct TexgenPool final : QThreadPool
+  {
+    TexgenPool()
+    {
+      setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+    }
+
+    static TexgenPool& instance()
+    {
+      static TexgenPool self;
+      return self;
+    }
+  };
+
 #include <Gfx/Qt5CompatPush> // clang-format: keep
+  /**
+   * Frames are generated on the TexgenPool, in bands of rows when the
+   * function supports it, in one of two buffers: the next frame is generated
+   * while the last one is uploaded.
+   * Until a frame is done, the texture keeps the previous one.
+   */
   struct Rendered : GenericNodeRenderer
   {
     using GenericNodeRenderer::GenericNodeRenderer;
 
-    bool m_uploaded = false;
     ~Rendered() { }
 
+    struct Frame
+    {
+      QImage image;
+      std::atomic_int remaining{};
+    };
+
     QRhiTexture* texture{};
+    std::shared_ptr<Frame> frames[2];
+    int generating{-1};
+
     void init(RenderList& renderer) override
     {
       const TexturedTriangle& mesh = TexturedTriangle::instance();
@@ -96,26 +135,84 @@ struct TexgenNode : NodeModel
         sampler->create();
         m_samplers.push_back({sampler, texture});
       }
+
+      for (auto& f : frames)
+      {
+        f = std::make_shared<Frame>();
+        f->image = QImage{n.image.size(), n.image.format()};
+      }
+      generating = -1;
+
       defaultPassesInit(renderer, mesh);
     }
 
+    // Returns false if there is no function to run
+    bool generate(const TexgenNode& n, const std::shared_ptr<Frame>& frame)
+    {
+      const auto tile = n.tileFunction.load();
+      const auto func = n.function.load();
+      if (!tile && !func)
+        return false;
+
+      // Copies the image if its last upload still references it
+      uchar* bits = frame->image.bits();
+      const int w = frame->image.width();
+      const int h = frame->image.height();
+      const int time = t++;
+
+      auto& pool = TexgenPool::instance();
+      if (tile)
+      {
+        const int bands = std::min(h, 4 * pool.maxThreadCount());
+        frame->remaining.store(bands, std::memory_order_relaxed);
+        for (int b = 0; b < bands; b++)
+        {
+          const int y0 = h * b / bands;
+          const int y1 = h * (b + 1) / bands;
+          score::startOnPool(pool, [=] {
+            tile(bits, w, h, y0, y1, time);
+            frame->remaining.fetch_sub(1, std::memory_order_release);
+          });
+        }
+      }
+      else
+      {
+        frame->remaining.store(1, std::memory_order_relaxed);
+        score::startOnPool(pool, [=] {
+          func(bits, w, h, time);
+          frame->remaining.fetch_sub(1, std::memory_order_release);
+        });
+      }
+      return true;
+    }
+
     void
     update(RenderList& renderer, QRhiResourceUpdateBatch& res) override
     {
       defaultUBOUpdate(renderer, res);
       auto& n = static_cast<const TexgenNode&>(this->node);
-      if (func_t f = n.function.load())
+
+      int next = 0;
+      if (generating >= 0)
       {
-        f(const_cast<uchar*>(n.image.bits()),
-          n.image.width(),
-          n.image.height(),
-          t++);
-        res.uploadTexture(texture, n.image);
+        auto& frame = *frames[generating];
+        if (frame.remaining.load(std::memory_order_acquire) > 0)
+          return;
+
+        res.uploadTexture(texture, frame.image);
+        next = 1 - generating;
       }
+
+      generating = generate(n, frames[next]) ? next : -1;
     }
 
     void release(RenderList& r) override
     {
+      // The tasks still running keep their frame alive
+      for (auto& f : frames)
+        f.reset();
+      generating = -1;
+
       texture->deleteLater();
       texture = nullptr;
 
@@ -137,8 +234,18 @@ struct TexgenNode : NodeModel
   virtual ~TexgenNode() { m_materialData.release(); }
 
   using func_t = void (*)(unsigned char* rgb, int width, int height, int t);
+  using tile_func_t = void (*)(
+      unsigned char* rgb,
+      int width,
+      int height,
+      int y_begin,
+      int y_end,
+      int t);
   std::atomic<func_t> function{};
 
+  //! Preferred to function when set
+  std::atomic<tile_func_t> tileFunction{};
+
   score::gfx::NodeRenderer*
   createRenderer(RenderList& r) const noexcept override
   {
@@ -225,15 +225,16 @@ Pipeline buildPipeline(
   return buildPipeline(renderer, mesh, vertexS, fragmentS, rt, bindings);
 }
 
-std::pair<QShader, QShader> makeShaders(QString vert, QString frag)
+static std::pair<QShader, QShader> checkShaders(
+    const std::pair<QShader, QString>& vertex,
+    const std::pair<QShader, QString>& fragment,
+    const QString& frag)
 {
-  auto [vertexS, vertexError]
-      = ShaderCache::get(vert.toUtf8(), QShader::VertexStage);
+  const auto& [vertexS, vertexError] = vertex;
   if (!vertexError.isEmpty())
     qDebug() << vertexError;
 
-  auto [fragmentS, fragmentError]
-      = ShaderCache::get(frag.toUtf8(), QShader::FragmentStage);
+  const auto& [fragmentS, fragmentError] = fragment;
   if (!fragmentError.isEmpty())
   {
     qDebug() << fragmentError;
@@ -248,6 +249,25 @@ std::pair<QShader, QShader> makeShaders(QString vert, QString frag)
   return {vertexS, fragmentS};
 }
 
+std::pair<QShader, QShader> makeShaders(QString vert, QString frag)
+{
+  return checkShaders(
+      ShaderCache::get(vert.toUtf8(), QShader::VertexStage),
+      ShaderCache::get(frag.toUtf8(), QShader::FragmentStage),
+      frag);
+}
+
+std::pair<QShader, QShader> tryMakeShaders(QString vert, QString frag)
+{
+  // Both are requested first so that they are baked in parallel
+  auto vertex = ShaderCache::tryGet(vert.toUtf8(), QShader::VertexStage);
+  auto fragment = ShaderCache::tryGet(frag.toUtf8(), QShader::FragmentStage);
+  if (!vertex || !fragment)
+    return {};
+
+  return checkShaders(*vertex, *fragment, frag);
+}
+
 // TODO move to ShaderCache
 QShader makeCompute(QString compute)
 {
@@ -208,6 +208,16 @@ Pipeline buildPipeline(
 SCORE_PLUGIN_GFX_EXPORT
 std::pair<QShader, QShader> makeShaders(QString vert, QString frag);
 
+/**
+ * @brief Same as makeShaders, without waiting for the shaders to be baked.
+ *
+ * While they are baked in the background, the returned shaders are invalid
+ * and ShaderCache::bakeCount() tells when to try again.
+ * Used on the render thread.
+ */
+SCORE_PLUGIN_GFX_EXPORT
+std::pair<QShader, QShader> tryMakeShaders(QString vert, QString frag);
+
 /**
  * @brief Compile a compute shader.
  *
@@ -1,10 +1,12 @@
 #include <Gfx/Graph/VideoNodeRenderer.hpp>
 
+#include <Gfx/Graph/ShaderCache.hpp>
+
 #include <Gfx/Graph/decoders/GPUVideoDecoder.hpp>
 #include <Gfx/Graph/decoders/HAP.hpp>
+#include <Gfx/Graph/decoders/PlanarYUV.hpp>
 #include <Gfx/Graph/decoders/RGBA.hpp>
-#include <Gfx/Graph/decoders/YUV420.hpp>
-#include <Gfx/Graph/decoders/YUV422.hpp>
+#include <Gfx/Graph/decoders/SemiPlanarYUV.hpp>
 #include <Gfx/Graph/decoders/YUYV422.hpp>
 
 #include <ossia/detail/flicks.hpp>
@@ -38,19 +40,48 @@ TextureRenderTarget VideoNodeRenderer::renderTargetForInput(const Port& input)
   return {};
 }
 
-void VideoNodeRenderer::createGpuDecoder()
+void VideoNodeRenderer::createGpuDecoder(RenderList& r)
 {
   auto& model = (VideoNode&)(node);
   auto& filter = model.m_filter;
+
+  // Formats above 8 bits per component go in R16 textures, which some
+  // backends (GLES2, some GL drivers) lack: convert them on the CPU instead.
+  const bool r16 = r.state.rhi->isTextureFormatSupported(QRhiTexture::R16);
   switch (m_currentFormat)
   {
     case AV_PIX_FMT_YUV420P:
     case AV_PIX_FMT_YUVJ420P:
-      m_gpu = std::make_unique<YUV420Decoder>(*m_decoder);
-      break;
-    case AV_PIX_FMT_YUVJ422P:
     case AV_PIX_FMT_YUV422P:
-      m_gpu = std::make_unique<YUV422Decoder>(*m_decoder);
+    case AV_PIX_FMT_YUVJ422P:
+    case AV_PIX_FMT_YUV444P:
+    case AV_PIX_FMT_YUVJ444P:
+    case AV_PIX_FMT_YUVA420P:
+      m_gpu = std::make_unique<PlanarYUVDecoder>(*m_decoder);
+      break;
+    case AV_PIX_FMT_YUV420P10LE:
+    case AV_PIX_FMT_YUV420P12LE:
+    case AV_PIX_FMT_YUV422P10LE:
+    case AV_PIX_FMT_YUV422P12LE:
+    case AV_PIX_FMT_YUV444P10LE:
+    case AV_PIX_FMT_YUV444P12LE:
+      if (r16)
+        m_gpu = std::make_unique<PlanarYUVDecoder>(*m_decoder);
+      else
+        m_gpu = std::make_unique<SwsRGBADecoder>(
+            m_currentFormat, *m_decoder, filter);
+      break;
+    case AV_PIX_FMT_NV12:
+    case AV_PIX_FMT_NV21:
+      m_gpu = std::make_unique<SemiPlanarYUVDecoder>(*m_decoder);
+      break;
+    case AV_PIX_FMT_P010LE:
+    case AV_PIX_FMT_P016LE:
+      if (r16)
+        m_gpu = std::make_unique<SemiPlanarYUVDecoder>(*m_decoder);
+      else
+        m_gpu = std::make_unique<SwsRGBADecoder>(
+            m_currentFormat, *m_decoder, filter);
       break;
     case AV_PIX_FMT_UYVY422:
       m_gpu = std::make_unique<UYVY422Decoder>(*m_decoder);
@@ -128,19 +159,36 @@ void VideoNodeRenderer::setupGpuDecoder(RenderList& r)
     m_p.clear();
   }
 
-  createGpuDecoder();
+  createGpuDecoder(r);
+  createPipelines(r);
+}
 
-  if (m_gpu)
+void VideoNodeRenderer::createPipelines(RenderList& r)
+{
+  m_waitingForShaders.reset();
+  if (!m_gpu)
+    return;
+
+  // Read before init so that a bake which ends meanwhile is not missed
+  const int64_t bakes = ShaderCache::bakeCount();
+  auto shaders = m_gpu->init(r);
+  if (!shaders.first.isValid() || !shaders.second.isValid())
+  {
+    // Nothing is drawn until the decoder is set up again, in update()
+    m_waitingForShaders = bakes;
+    return;
+  }
+
+  SCORE_ASSERT(m_p.empty());
+  auto& mesh = TexturedTriangle::instance();
+  for (Edge* edge : this->node.output[0]->edges)
   {
-    auto shaders = m_gpu->init(r);
-    SCORE_ASSERT(m_p.empty());
-    for(Edge* edge : this->node.output[0]->edges)
+    auto rt = r.renderTargetForOutput(*edge);
+    if (rt.renderTarget)
     {
-      auto rt = r.renderTargetForOutput(*edge);
-      if(rt.renderTarget)
-      {
-        auto& mesh = TexturedTriangle::instance();
-        m_p.emplace_back(edge, score::gfx::buildPipeline(
+      m_p.emplace_back(
+          edge,
+          score::gfx::buildPipeline(
               r,
               mesh,
               shaders.first,
@@ -149,7 +197,6 @@ void VideoNodeRenderer::setupGpuDecoder(RenderList& r)
               m_processUBO,
               nullptr,
               m_gpu->samplers));
-      }
     }
   }
 }
@@ -187,29 +234,17 @@ void VideoNodeRenderer::init(RenderList& renderer)
 
   if (!m_gpu)
   {
-    createGpuDecoder();
+    createGpuDecoder(renderer);
   }
 
-  if (m_gpu)
-  {
-    auto shaders = m_gpu->init(renderer);
-
-    SCORE_ASSERT(m_p.empty());
-    for(Edge* edge : this->node.output[0]->edges)
-    {
-      auto rt = renderer.renderTargetForOutput(*edge);
-      if(rt.renderTarget)
-      {
-        m_p.emplace_back(edge, score::gfx::buildPipeline(renderer, mesh, shaders.first, shaders.second, rt, m_processUBO, nullptr, m_gpu->samplers));
-      }
-    }
-  }
+  createPipelines(renderer);
 }
 
 QRhiResourceUpdateBatch* VideoNodeRenderer::runRenderPass(RenderList& renderer, QRhiCommandBuffer& cb, Edge& edge)
 {
   auto it = ossia::find_if(m_p, [ptr=&edge] (const auto& p){ return p.first == ptr; });
-  SCORE_ASSERT(it != m_p.end());
+  if (it == m_p.end())
+    return nullptr;
   {
     const auto sz = renderer.state.size;
     cb.setGraphicsPipeline(it->second.pipeline);
@@ -242,6 +277,9 @@ void VideoNodeRenderer::update(RenderList& renderer, QRhiResourceUpdateBatch& re
     decoder.release_frame(frame);
   m_framesToFree.clear();
 
+  if (m_waitingForShaders && *m_waitingForShaders != ShaderCache::bakeCount())
+    setupGpuDecoder(renderer);
+
   // TODO
   auto mustReadFrame = [this, &decoder, &nodem] {
     double tempoRatio = 1.;
@@ -3,6 +3,8 @@
 #include <Gfx/Graph/NodeRenderer.hpp>
 #include <Video/VideoInterface.hpp>
 
+#include <optional>
+
 namespace score::gfx
 {
 class GPUVideoDecoder;
@@ -16,7 +18,7 @@ public:
 
   TextureRenderTarget renderTargetForInput(const Port& input) override;
 
-  void createGpuDecoder();
+  void createGpuDecoder(RenderList& r);
   void setupGpuDecoder(RenderList& r);
   void checkFormat(RenderList& r, AVPixelFormat fmt, int w, int h);
 
@@ -32,6 +34,8 @@ public:
 
 
 private:
+  void createPipelines(RenderList& r);
+
   const VideoNode& node;
 
   std::vector<std::pair<Edge*, Pipeline>> m_p;
@@ -41,6 +45,8 @@ private:
 
 
   std::unique_ptr<GPUVideoDecoder> m_gpu;
+  // ShaderCache::bakeCount() when the shaders of m_gpu were not baked yet
+  std::optional<int64_t> m_waitingForShaders;
   std::shared_ptr<Video::VideoInterface> m_decoder;
   std::vector<AVFrame*> m_framesToFree;
   AVPixelFormat m_currentFormat = AVPixelFormat(-1);
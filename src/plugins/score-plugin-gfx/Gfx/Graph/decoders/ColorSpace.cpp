@@ -0,0 +1,113 @@
+#include <Gfx/Graph/decoders/ColorSpace.hpp>
+
+extern "C"
+{
+#include <libavutil/pixdesc.h>
+}
+
+namespace score::gfx
+{
+namespace
+{
+struct LumaCoefficients
+{
+  double kr{}, kb{};
+};
+
+LumaCoefficients coefficients(const Video::VideoMetadata& video) noexcept
+{
+  switch (video.color_space)
+  {
+    case AVCOL_SPC_BT709:
+      return {0.2126, 0.0722};
+    case AVCOL_SPC_BT2020_NCL:
+    case AVCOL_SPC_BT2020_CL:
+      return {0.2627, 0.0593};
+    case AVCOL_SPC_SMPTE240M:
+      return {0.212, 0.087};
+    case AVCOL_SPC_FCC:
+      return {0.30, 0.11};
+    case AVCOL_SPC_BT470BG:
+    case AVCOL_SPC_SMPTE170M:
+      return {0.299, 0.114};
+    default:
+      // Same guess as most players: HD videos are BT.709
+      if (video.height > 576)
+        return {0.2126, 0.0722};
+      return {0.299, 0.114};
+  }
+}
+
+bool fullRange(const Video::VideoMetadata& video) noexcept
+{
+  switch (video.pixel_format)
+  {
+    case AV_PIX_FMT_YUVJ420P:
+    case AV_PIX_FMT_YUVJ422P:
+    case AV_PIX_FMT_YUVJ444P:
+      return true;
+    default:
+      return video.color_range == AVCOL_RANGE_JPEG;
+  }
+}
+
+QString number(double v)
+{
+  return QString::number(v, 'f', 8);
+}
+}
+
+QString convertToRGB(const Video::VideoMetadata& video)
+{
+  // Sampled values are normalized over the whole size of the component:
+  // 10 bits stored in 16 are rescaled to [0; 1].
+  int depth = 8;
+  double sample_scale = 1.;
+  if (auto desc = av_pix_fmt_desc_get(video.pixel_format))
+  {
+    const auto& c = desc->comp[0];
+    depth = c.depth;
+    if (c.depth > 8)
+      sample_scale = 65535. / (((1 << c.depth) - 1) << c.shift);
+  }
+
+  const double max = (1 << depth) - 1;
+  const double unit = 1 << (depth - 8);
+  const double chroma_offset = 128. * unit / max;
+  double luma_offset = 0., luma_scale = 1., chroma_scale = 1.;
+  if (!fullRange(video))
+  {
+    luma_offset = 16. * unit / max;
+    luma_scale = max / (219. * unit);
+    chroma_scale = max / (224. * unit);
+  }
+
+  // With u and v in [-0.5; 0.5]
+  const auto [kr, kb] = coefficients(video);
+  const double kg = 1. - kr - kb;
+  const double r_v = 2. * (1. - kr);
+  const double g_u = -2. * kb * (1. - kb) / kg;
+  const double g_v = -2. * kr * (1. - kr) / kg;
+  const double b_u = 2. * (1. - kb);
+
+  return QStringLiteral(
+             "const vec3 yuv_offset = vec3(%1, %2, %2);\n"
+             "const vec3 yuv_scale = vec3(%3, %4, %4);\n"
+             "const mat3 yuv_matrix = mat3(1.0, 1.0, 1.0,\n"
+             "                             0.0, %5, %6,\n"
+             "                             %7, %8, 0.0);\n"
+             "vec3 convert_to_rgb(vec3 yuv) {\n"
+             "  yuv = (yuv * %9 - yuv_offset) * yuv_scale;\n"
+             "  return clamp(yuv_matrix * yuv, 0.0, 1.0);\n"
+             "}\n")
+      .arg(number(luma_offset))
+      .arg(number(chroma_offset))
+      .arg(number(luma_scale))
+      .arg(number(chroma_scale))
+      .arg(number(g_u))
+      .arg(number(b_u))
+      .arg(number(r_v))
+      .arg(number(g_v))
+      .arg(number(sample_scale));
+}
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include <Video/VideoInterface.hpp>
+
+#include <QString>
+
+namespace score::gfx
+{
+/**
+ * @brief GLSL conversion of the YUV samples of a video to RGB.
+ *
+ * Returns the code of `vec3 convert_to_rgb(vec3 yuv)`, which takes the
+ * values as sampled from the textures of the planes: it accounts for the bit
+ * depth of the pixel format, the matrix (BT.601, BT.709, BT.2020) and the
+ * range (limited or full) of the video.
+ */
+QString convertToRGB(const Video::VideoMetadata& video);
+}
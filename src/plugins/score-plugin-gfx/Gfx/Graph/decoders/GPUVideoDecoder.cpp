@@ -39,7 +39,7 @@ QRhiTextureSubresourceUploadDescription GPUVideoDecoder::createTextureUpload(
   }
   else
   {
-    QByteArray data{w * h, Qt::Uninitialized};
+    QByteArray data{rowBytes * h, Qt::Uninitialized};
     for (int r = 0; r < h; r++)
     {
       const char* input = reinterpret_cast<const char*>(pixels + stride * r);
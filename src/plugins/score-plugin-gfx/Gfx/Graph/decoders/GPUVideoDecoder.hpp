@@ -25,7 +25,7 @@ struct VideoNode;
  * - Create relevant shaders, samplers & textures in the init method.
  * - When exec is called, copy the data from the AVFrame to the QRhiTextures.
  *
- * See RGB0Decoder for an example with a single texture, YUV420Decoder for an
+ * See RGB0Decoder for an example with a single texture, PlanarYUVDecoder for an
  * example with multiple textures.
  */
 class GPUVideoDecoder
@@ -41,7 +41,9 @@ public:
    * - Create samplers and textures for the video format.
    * - Create shaders that will render the data put into these textures.
    *
-   * It returns a {vertex, fragment} shader pair.
+   * It returns a {vertex, fragment} shader pair, made with tryMakeShaders:
+   * both are invalid while they are baked in the background, and init is
+   * called again once they may be ready.
    */
   [[nodiscard]]
   virtual std::pair<QShader, QShader> init(RenderList& r) = 0;
@@ -93,7 +95,7 @@ struct EmptyDecoder : GPUVideoDecoder
 
   std::pair<QShader, QShader> init(RenderList& r) override
   {
-    return score::gfx::makeShaders(TexturedTriangle::instance().defaultVertexShader(), hashtag_no_filter);
+    return score::gfx::tryMakeShaders(TexturedTriangle::instance().defaultVertexShader(), hashtag_no_filter);
   }
 
   void exec(
@@ -2,9 +2,6 @@
 #include <Gfx/Graph/decoders/GPUVideoDecoder.hpp>
 #include <Gfx/Qt5CompatPush> // clang-format: keep
 
-#include <hap/source/hap.h>
-#include <snappy.h>
-
 namespace score::gfx
 {
 /**
@@ -12,93 +9,19 @@ namespace score::gfx
  */
 struct HAPDecoder : GPUVideoDecoder
 {
-  struct HAPSection
-  {
-    static HAPSection read(const uint8_t* bytes)
-    {
-      HAPSection s;
-
-      s.type = bytes[3];
-
-      if (bytes[0] == 0 && bytes[1] == 0 && bytes[2] == 0)
-      {
-        // bytes 4,5,6,7 hold the size
-        s.size += bytes[7] << 24;
-        s.size += bytes[6] << 16;
-        s.size += bytes[5] << 8;
-        s.size += bytes[4];
-        s.data = bytes + 8;
-      }
-      else
-      {
-        // bytes 0, 1, 2 hold the size
-        s.size += bytes[2] << 16;
-        s.size += bytes[1] << 8;
-        s.size += bytes[0];
-        s.data = bytes + 4;
-      }
-
-      return s;
-    }
-
-    uint32_t type{};
-    uint32_t size{};
-    const uint8_t* data{};
-  };
-
+  // The frames are decompressed by decompressHAP on the decoding threads
   void exec(
       RenderList&,
       QRhiResourceUpdateBatch& res,
       AVFrame& frame) override
   {
-    auto section = HAPSection::read(frame.data[0]);
-    if (section.type == 0x0D)
-      return;
-
-    switch (section.type >> 4)
-    {
-      case 0xA:
-        setPixels_noEncoding(res, section.data, section.size);
-        break;
-      case 0xB:
-        setPixels_snappy(res, section.data, section.size);
-        break;
-      case 0xC:
-      {
-
-        HapDecodeCallback cb = [](HapDecodeWorkFunction function,
-                                  void* p,
-                                  unsigned int count,
-                                  void* info) {
-          for (std::size_t i = 0; i < count; i++)
-            function(p, i);
-        };
-        void* ctx = nullptr;
-        void* output = m_buffer.get();
-        unsigned long outBytes = buffer_size;
-        unsigned long outBytesUsed{};
-        unsigned int outFormat{};
-        auto r = HapDecode(
-            frame.data[0],
-            frame.linesize[0],
-            0,
-            cb,
-            ctx,
-            output,
-            outBytes,
-            &outBytesUsed,
-            &outFormat);
-        if (r == HapResult_No_Error)
-          setPixels_noEncoding(res, (const uint8_t*)output, outBytesUsed);
-        else
-          qDebug() << r;
-        break;
-      }
-    }
+    if (frame.data[1])
+      setPixels(res, samplers[0].texture, frame.data[1], frame.linesize[1]);
   }
 
-  void setPixels_noEncoding(
+  static void setPixels(
       QRhiResourceUpdateBatch& res,
+      QRhiTexture* tex,
       const uint8_t* data_start,
       std::size_t size)
   {
@@ -108,34 +31,8 @@ struct HAPDecoder : GPUVideoDecoder
 
     QRhiTextureUploadDescription desc{entry};
 
-    auto y_tex = samplers[0].texture;
-    res.uploadTexture(y_tex, desc);
-  }
-
-  void setPixels_snappy(
-      QRhiResourceUpdateBatch& res,
-      const uint8_t* data_start,
-      std::size_t size)
-  {
-    size_t uncomp_size{};
-    snappy::GetUncompressedLength((const char*)data_start, size, &uncomp_size);
-
-    QByteArray data(uncomp_size, Qt::Uninitialized);
-    snappy::RawUncompress((const char*)data_start, size, data.data());
-
-    QRhiTextureSubresourceUploadDescription sub;
-    sub.setData(std::move(data));
-    QRhiTextureUploadEntry entry{0, 0, sub};
-
-    QRhiTextureUploadDescription desc{entry};
-
-    auto y_tex = samplers[0].texture;
-    res.uploadTexture(y_tex, desc);
+    res.uploadTexture(tex, desc);
   }
-
-  static constexpr int buffer_size = 1024 * 1024 * 16;
-  std::unique_ptr<char[]> m_buffer
-      = std::make_unique<char[]>(1024 * 1024 * 16);
 };
 
 /**
@@ -199,7 +96,7 @@ void main ()
   std::pair<QShader, QShader> init(RenderList& r) override
   {
     auto& rhi = *r.state.rhi;
-    auto shaders = score::gfx::makeShaders(
+    auto shaders = score::gfx::tryMakeShaders(
         TexturedTriangle::instance().defaultVertexShader(), QString(fragment).arg(filter));
 
     const auto w = decoder.width, h = decoder.height;
@@ -277,7 +174,7 @@ void main ()
   std::pair<QShader, QShader> init(RenderList& r) override
   {
     auto& rhi = *r.state.rhi;
-    auto shaders = score::gfx::makeShaders(
+    auto shaders = score::gfx::tryMakeShaders(
         TexturedTriangle::instance().defaultVertexShader(), QString(fragment).arg(filter));
 
     const auto w = decoder.width, h = decoder.height;
@@ -321,81 +218,12 @@ void main ()
       QRhiResourceUpdateBatch& res,
       AVFrame& frame) override
   {
-    HapDecodeCallback cb = [](HapDecodeWorkFunction function,
-                              void* p,
-                              unsigned int count,
-                              void* info) {
-      for (std::size_t i = 0; i < count; i++)
-        function(p, i);
-    };
-    void* ctx = nullptr;
-    void* ycocg_output = m_buffer.get();
-    unsigned long ycocg_outBytes = buffer_size;
-    unsigned long ycocg_outBytesUsed{};
-    unsigned int ycocg_outFormat{};
-    auto r = HapDecode(
-        frame.data[0],
-        frame.linesize[0],
-        0,
-        cb,
-        ctx,
-        ycocg_output,
-        ycocg_outBytes,
-        &ycocg_outBytesUsed,
-        &ycocg_outFormat);
-    if (r == HapResult_No_Error)
+    if (frame.data[1] && frame.data[2])
     {
-      void* alpha_output = m_alphaBuffer.get();
-      unsigned long alpha_outBytes = buffer_size;
-      unsigned long alpha_outBytesUsed{};
-      unsigned int alpha_outFormat{};
-      r = HapDecode(
-          frame.data[0],
-          frame.linesize[0],
-          1,
-          cb,
-          ctx,
-          alpha_output,
-          alpha_outBytes,
-          &alpha_outBytesUsed,
-          &alpha_outFormat);
-      if (r == HapResult_No_Error)
-      {
-        setPixels(
-            res,
-            samplers[0].texture,
-            (const uint8_t*)ycocg_output,
-            ycocg_outBytesUsed);
-        setPixels(
-            res,
-            samplers[1].texture,
-            (const uint8_t*)alpha_output,
-            alpha_outBytesUsed);
-      }
+      setPixels(res, samplers[0].texture, frame.data[1], frame.linesize[1]);
+      setPixels(res, samplers[1].texture, frame.data[2], frame.linesize[2]);
     }
-    else
-    {
-      qDebug() << r;
-    }
-  }
-
-  static void setPixels(
-      QRhiResourceUpdateBatch& res,
-      QRhiTexture* tex,
-      const uint8_t* ycocg_start,
-      std::size_t ycocg_size)
-  {
-    QRhiTextureSubresourceUploadDescription sub;
-    sub.setData(QByteArray::fromRawData((const char*)ycocg_start, ycocg_size));
-    QRhiTextureUploadEntry entry{0, 0, sub};
-
-    QRhiTextureUploadDescription desc{entry};
-
-    res.uploadTexture(tex, desc);
   }
-
-  std::unique_ptr<char[]> m_alphaBuffer
-      = std::make_unique<char[]>(1024 * 1024 * 16);
 };
 
 #include <Gfx/Qt5CompatPop> // clang-format: keep
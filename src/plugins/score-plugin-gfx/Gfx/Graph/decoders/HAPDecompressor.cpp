@@ -0,0 +1,234 @@
+#include <Gfx/Graph/decoders/HAPDecompressor.hpp>
+
+#include <hap/source/hap.h>
+
+#include <QDebug>
+#include <QThread>
+
+extern "C"
+{
+#include <libavutil/buffer.h>
+}
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <condition_variable>
+
+namespace score::gfx
+{
+namespace
+{
+/**
+ * Runs the chunks of the frames being decompressed.
+ *
+ * The thread which decompresses a frame also runs its chunks, so that a
+ * frame progresses even when the workers are busy with other frames.
+ */
+class ChunkPool
+{
+public:
+  static ChunkPool& instance()
+  {
+    static ChunkPool self;
+    return self;
+  }
+
+  ~ChunkPool()
+  {
+    {
+      std::lock_guard lock{m_mutex};
+      m_stop = true;
+    }
+    m_work.notify_all();
+
+    for (auto& t : m_threads)
+      t.join();
+  }
+
+  void run(HapDecodeWorkFunction function, void* p, unsigned int count)
+  {
+    Job job{function, p, count};
+    {
+      std::lock_guard lock{m_mutex};
+      m_jobs.push_back(&job);
+    }
+    m_work.notify_all();
+
+    std::unique_lock lock{m_mutex};
+    while (run_one(job, lock))
+      ;
+    m_done.wait(lock, [&] { return job.done == job.count; });
+  }
+
+private:
+  ChunkPool()
+  {
+    const int threads = std::max(QThread::idealThreadCount() - 1, 1);
+    for (int i = 0; i < threads; i++)
+      m_threads.emplace_back([this] { work(); });
+  }
+
+  struct Job
+  {
+    HapDecodeWorkFunction function{};
+    void* p{};
+    unsigned int count{};
+    unsigned int next{};
+    unsigned int done{};
+  };
+
+  // Called and returns with the lock held.
+  // The job stays alive until its last chunk is done.
+  bool run_one(Job& job, std::unique_lock<std::mutex>& lock)
+  {
+    if (job.next == job.count)
+    {
+      auto it = std::find(m_jobs.begin(), m_jobs.end(), &job);
+      if (it != m_jobs.end())
+        m_jobs.erase(it);
+      return false;
+    }
+
+    const unsigned int chunk = job.next++;
+    lock.unlock();
+    job.function(job.p, chunk);
+    lock.lock();
+
+    if (++job.done == job.count)
+      m_done.notify_all();
+    return true;
+  }
+
+  void work()
+  {
+    std::unique_lock lock{m_mutex};
+    for (;;)
+    {
+      m_work.wait(lock, [&] { return m_stop || !m_jobs.empty(); });
+      if (m_stop)
+        return;
+
+      run_one(*m_jobs.front(), lock);
+    }
+  }
+
+  std::mutex m_mutex;
+  std::condition_variable m_work;
+  std::condition_variable m_done;
+  std::vector<Job*> m_jobs;
+  std::vector<std::thread> m_threads;
+  bool m_stop{};
+};
+
+void decodeChunks(
+    HapDecodeWorkFunction function,
+    void* p,
+    unsigned int count,
+    void* info)
+{
+  if (count == 1)
+    function(p, 0);
+  else
+    ChunkPool::instance().run(function, p, count);
+}
+
+// The videos of a document only have a few different sizes:
+// a pool is kept for the last ones, and its buffers go back to it
+// when the frames holding them are released.
+AVBufferRef* getBuffer(int size)
+{
+  static constexpr std::size_t max_pools = 8;
+  static std::mutex mutex;
+  static std::vector<std::pair<int, AVBufferPool*>> pools;
+
+  std::lock_guard lock{mutex};
+  auto it = std::find_if(pools.begin(), pools.end(), [=](const auto& p) {
+    return p.first == size;
+  });
+
+  if (it == pools.end())
+  {
+    if (pools.size() == max_pools)
+    {
+      // Freed once its last buffer is released
+      av_buffer_pool_uninit(&pools.front().second);
+      pools.erase(pools.begin());
+    }
+
+    pools.emplace_back(size, av_buffer_pool_init(size, nullptr));
+    it = pools.end() - 1;
+  }
+
+  return it->second ? av_buffer_pool_get(it->second) : nullptr;
+}
+
+int textureSize(unsigned int format, int width, int height) noexcept
+{
+  const int blocks = ((width + 3) / 4) * ((height + 3) / 4);
+  switch (format)
+  {
+    case HapTextureFormat_RGB_DXT1:
+    case HapTextureFormat_A_RGTC1:
+      return blocks * 8;
+    default:
+      return blocks * 16;
+  }
+}
+}
+
+void decompressHAP(AVFrame& frame) noexcept
+{
+  const void* input = frame.data[0];
+  const unsigned long inputSize = frame.linesize[0];
+
+  int textures{};
+  if (HapGetFrameTextureCount(input, inputSize, &textures)
+      != HapResult_No_Error)
+    return;
+
+  // HAP-M: color and alpha
+  textures = std::min(textures, 2);
+  for (int i = 0; i < textures; i++)
+  {
+    unsigned int format{};
+    if (HapGetFrameTextureFormat(input, inputSize, i, &format)
+        != HapResult_No_Error)
+      return;
+
+    const int size = textureSize(format, frame.width, frame.height);
+    if (size <= 0)
+      return;
+
+    AVBufferRef* buf = getBuffer(size);
+    if (!buf)
+      return;
+
+    unsigned long used{};
+    unsigned int outFormat{};
+    auto r = HapDecode(
+        input,
+        inputSize,
+        i,
+        decodeChunks,
+        nullptr,
+        buf->data,
+        size,
+        &used,
+        &outFormat);
+    if (r != HapResult_No_Error)
+    {
+      qDebug() << "HAP: cannot decode frame:" << r;
+      av_buffer_unref(&buf);
+      return;
+    }
+
+    frame.buf[i + 1] = buf;
+    frame.data[i + 1] = buf->data;
+    frame.linesize[i + 1] = used;
+  }
+}
+}
@@ -0,0 +1,20 @@
+#pragma once
+extern "C"
+{
+#include <libavutil/frame.h>
+}
+
+namespace score::gfx
+{
+/**
+ * @brief Decompresses a HAP frame on the thread which decodes the video.
+ *
+ * The chunks of a frame are decompressed in parallel, into buffers which
+ * are reused once the frame is released.
+ * The DXT data of the texture i is then in frame.data[i + 1], and its size
+ * in frame.linesize[i + 1]: the HAP decoders only upload it.
+ *
+ * On failure, the frame is left as is and will not be displayed.
+ */
+void decompressHAP(AVFrame& frame) noexcept;
+}
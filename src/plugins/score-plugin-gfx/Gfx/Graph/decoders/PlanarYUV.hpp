@@ -0,0 +1,134 @@
+#pragma once
+#include <Gfx/Graph/decoders/ColorSpace.hpp>
+#include <Gfx/Graph/decoders/GPUVideoDecoder.hpp>
+
+namespace score::gfx
+{
+#include <Gfx/Qt5CompatPush> // clang-format: keep
+
+/**
+ * @brief Decodes planar YUV videos: 4:2:0, 4:2:2, 4:4:4, with an optional
+ * alpha plane, in 8 bits or more.
+ *
+ * Each plane goes in its own R8 or R16 texture; the chroma textures
+ * are smaller when the chroma is subsampled.
+ */
+struct PlanarYUVDecoder : GPUVideoDecoder
+{
+  static const constexpr auto filter = R"_(#version 450
+
+  layout(std140, binding = 0) uniform buf {
+  mat4 clipSpaceCorrMatrix;
+  vec2 texcoordAdjust;
+  } tbuf;
+
+  layout(binding=3) uniform sampler2D y_tex;
+  layout(binding=4) uniform sampler2D u_tex;
+  layout(binding=5) uniform sampler2D v_tex;
+  %1
+
+  layout(location = 0) in vec2 v_texcoord;
+  layout(location = 0) out vec4 fragColor;
+
+  %2
+
+  void main ()
+  {
+    vec2 texcoord = vec2(v_texcoord.x, tbuf.texcoordAdjust.y + tbuf.texcoordAdjust.x * v_texcoord.y);
+
+    float y = texture(y_tex, texcoord).r;
+    float u = texture(u_tex, texcoord).r;
+    float v = texture(v_tex, texcoord).r;
+    fragColor = vec4(convert_to_rgb(vec3(y, u, v)), %3);
+  })_";
+
+  PlanarYUVDecoder(Video::VideoInterface& d)
+      : decoder{d}
+  {
+    if (auto desc = av_pix_fmt_desc_get(d.pixel_format))
+    {
+      chroma_w = desc->log2_chroma_w;
+      chroma_h = desc->log2_chroma_h;
+      alpha = desc->flags & AV_PIX_FMT_FLAG_ALPHA;
+      bytes = desc->comp[0].depth > 8 ? 2 : 1;
+    }
+  }
+
+  Video::VideoInterface& decoder;
+  int chroma_w{1}, chroma_h{1};
+  int bytes{1};
+  bool alpha{};
+
+  std::pair<QShader, QShader> init(RenderList& r) override
+  {
+    auto& rhi = *r.state.rhi;
+    const auto format = bytes == 2 ? QRhiTexture::R16 : QRhiTexture::R8;
+
+    auto addPlane = [&](QSize sz) {
+      auto tex = rhi.newTexture(format, sz, 1, QRhiTexture::Flag{});
+      tex->create();
+
+      auto sampler = rhi.newSampler(
+          QRhiSampler::Linear,
+          QRhiSampler::Linear,
+          QRhiSampler::None,
+          QRhiSampler::ClampToEdge,
+          QRhiSampler::ClampToEdge);
+      sampler->create();
+      samplers.push_back({sampler, tex});
+    };
+
+    addPlane(planeSize(0));
+    addPlane(planeSize(1));
+    addPlane(planeSize(2));
+    if (alpha)
+      addPlane(planeSize(3));
+
+    const QString frag
+        = QString(filter)
+              .arg(
+                  alpha ? "layout(binding=6) uniform sampler2D a_tex;" : "")
+              .arg(convertToRGB(decoder))
+              .arg(alpha ? "texture(a_tex, texcoord).r" : "1.0");
+    return score::gfx::tryMakeShaders(
+        TexturedTriangle::instance().defaultVertexShader(), frag);
+  }
+
+  void exec(
+      RenderList&,
+      QRhiResourceUpdateBatch& res,
+      AVFrame& frame) override
+  {
+    for (std::size_t i = 0; i < samplers.size(); i++)
+      setPixels(res, i, frame.data[i], frame.linesize[i]);
+  }
+
+  QSize planeSize(int plane) const noexcept
+  {
+    const auto w = decoder.width, h = decoder.height;
+    if (plane == 1 || plane == 2)
+      return {
+          (w + (1 << chroma_w) - 1) >> chroma_w,
+          (h + (1 << chroma_h) - 1) >> chroma_h};
+    return {w, h};
+  }
+
+  void setPixels(
+      QRhiResourceUpdateBatch& res,
+      int plane,
+      uint8_t* pixels,
+      int stride) const noexcept
+  {
+    const auto sz = planeSize(plane);
+    QRhiTextureUploadEntry entry{
+        0,
+        0,
+        createTextureUpload(pixels, sz.width(), sz.height(), bytes, stride)};
+    QRhiTextureUploadDescription desc{entry};
+
+    res.uploadTexture(samplers[plane].texture, desc);
+  }
+};
+
+#include <Gfx/Qt5CompatPop> // clang-format: keep
+}
@@ -1,6 +1,13 @@
 #pragma once
 #include <Gfx/Graph/decoders/GPUVideoDecoder.hpp>
 
+extern "C"
+{
+#include <libswscale/swscale.h>
+}
+
+#include <vector>
+
 namespace score::gfx
 {
 #include <Gfx/Qt5CompatPush> // clang-format: keep
@@ -65,7 +72,7 @@ struct RGB0Decoder : GPUVideoDecoder
       samplers.push_back({sampler, tex});
     }
 
-    return score::gfx::makeShaders(TexturedTriangle::instance().defaultVertexShader(), QString(rgb_filter).arg(filter));
+    return score::gfx::tryMakeShaders(TexturedTriangle::instance().defaultVertexShader(), QString(rgb_filter).arg(filter));
   }
 
   void exec(
@@ -92,4 +99,58 @@ struct RGB0Decoder : GPUVideoDecoder
     res.uploadTexture(y_tex, desc);
   }
 };
+
+/**
+ * @brief Converts the frames to RGBA on the CPU before uploading them.
+ *
+ * Fallback for the formats whose GPU decoder needs a texture format
+ * not supported by the current backend.
+ */
+struct SwsRGBADecoder : RGB0Decoder
+{
+  SwsRGBADecoder(
+      AVPixelFormat fmt,
+      Video::VideoInterface& d,
+      QString f = "")
+      : RGB0Decoder{QRhiTexture::RGBA8, d, std::move(f)}
+      , sourceFormat{fmt}
+  {
+  }
+
+  ~SwsRGBADecoder() override
+  {
+    if (m_rescale)
+      sws_freeContext(m_rescale);
+  }
+
+  AVPixelFormat sourceFormat;
+
+  void exec(
+      RenderList&,
+      QRhiResourceUpdateBatch& res,
+      AVFrame& frame) override
+  {
+    const auto w = decoder.width, h = decoder.height;
+    if (!m_rescale)
+    {
+      m_rescale = sws_getContext(
+          w, h, sourceFormat,
+          w, h, AV_PIX_FMT_RGBA,
+          SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+      if (!m_rescale)
+        return;
+      m_rgba.resize(std::size_t(w) * h * 4);
+    }
+
+    // The buffer outlives the upload: it is only rewritten for the next frame
+    uint8_t* dst[4]{m_rgba.data()};
+    int dst_stride[4]{w * 4};
+    sws_scale(m_rescale, frame.data, frame.linesize, 0, h, dst, dst_stride);
+    setPixels(res, m_rgba.data(), w * 4);
+  }
+
+private:
+  SwsContext* m_rescale{};
+  std::vector<uint8_t> m_rgba;
+};
 }
@@ -0,0 +1,125 @@
+#pragma once
+#include <Gfx/Graph/decoders/ColorSpace.hpp>
+#include <Gfx/Graph/decoders/GPUVideoDecoder.hpp>
+
+namespace score::gfx
+{
+#include <Gfx/Qt5CompatPush> // clang-format: keep
+
+/**
+ * @brief Decodes 4:2:0 YUV videos with interleaved chroma: NV12, NV21,
+ * P010, P016; mostly what hardware decoders output.
+ *
+ * The chroma plane goes as is in a R8 or R16 texture twice as wide as the
+ * chroma, in which the shader fetches both samples of a pixel.
+ */
+struct SemiPlanarYUVDecoder : GPUVideoDecoder
+{
+  static const constexpr auto filter = R"_(#version 450
+
+  layout(std140, binding = 0) uniform buf {
+  mat4 clipSpaceCorrMatrix;
+  vec2 texcoordAdjust;
+  } tbuf;
+
+  layout(binding=3) uniform sampler2D y_tex;
+  layout(binding=4) uniform sampler2D uv_tex;
+
+  layout(location = 0) in vec2 v_texcoord;
+  layout(location = 0) out vec4 fragColor;
+
+  %1
+
+  void main ()
+  {
+    vec2 texcoord = vec2(v_texcoord.x, tbuf.texcoordAdjust.y + tbuf.texcoordAdjust.x * v_texcoord.y);
+
+    ivec2 uv_size = textureSize(uv_tex, 0) / ivec2(2, 1);
+    ivec2 c = clamp(ivec2(texcoord * vec2(uv_size)), ivec2(0), uv_size - 1);
+
+    float y = texture(y_tex, texcoord).r;
+    float u = texelFetch(uv_tex, ivec2(2 * c.x + %2, c.y), 0).r;
+    float v = texelFetch(uv_tex, ivec2(2 * c.x + %3, c.y), 0).r;
+    fragColor = vec4(convert_to_rgb(vec3(y, u, v)), 1.0);
+  })_";
+
+  SemiPlanarYUVDecoder(Video::VideoInterface& d)
+      : decoder{d}
+  {
+    if (auto desc = av_pix_fmt_desc_get(d.pixel_format))
+    {
+      bytes = desc->comp[0].depth > 8 ? 2 : 1;
+      swap_uv = desc->comp[1].offset > desc->comp[2].offset;
+    }
+  }
+
+  Video::VideoInterface& decoder;
+  int bytes{1};
+  bool swap_uv{};
+
+  std::pair<QShader, QShader> init(RenderList& r) override
+  {
+    auto& rhi = *r.state.rhi;
+    const auto format = bytes == 2 ? QRhiTexture::R16 : QRhiTexture::R8;
+
+    auto addPlane = [&](QSize sz, QRhiSampler::Filter mode) {
+      auto tex = rhi.newTexture(format, sz, 1, QRhiTexture::Flag{});
+      tex->create();
+
+      auto sampler = rhi.newSampler(
+          mode,
+          mode,
+          QRhiSampler::None,
+          QRhiSampler::ClampToEdge,
+          QRhiSampler::ClampToEdge);
+      sampler->create();
+      samplers.push_back({sampler, tex});
+    };
+
+    addPlane(planeSize(0), QRhiSampler::Linear);
+    addPlane(planeSize(1), QRhiSampler::Nearest);
+
+    const QString frag = QString(filter)
+                             .arg(convertToRGB(decoder))
+                             .arg(swap_uv ? 1 : 0)
+                             .arg(swap_uv ? 0 : 1);
+    return score::gfx::tryMakeShaders(
+        TexturedTriangle::instance().defaultVertexShader(), frag);
+  }
+
+  void exec(
+      RenderList&,
+      QRhiResourceUpdateBatch& res,
+      AVFrame& frame) override
+  {
+    setPixels(res, 0, frame.data[0], frame.linesize[0]);
+    setPixels(res, 1, frame.data[1], frame.linesize[1]);
+  }
+
+  QSize planeSize(int plane) const noexcept
+  {
+    const auto w = decoder.width, h = decoder.height;
+    if (plane == 1)
+      return {2 * ((w + 1) / 2), (h + 1) / 2};
+    return {w, h};
+  }
+
+  void setPixels(
+      QRhiResourceUpdateBatch& res,
+      int plane,
+      uint8_t* pixels,
+      int stride) const noexcept
+  {
+    const auto sz = planeSize(plane);
+    QRhiTextureUploadEntry entry{
+        0,
+        0,
+        createTextureUpload(pixels, sz.width(), sz.height(), bytes, stride)};
+    QRhiTextureUploadDescription desc{entry};
+
+    res.uploadTexture(samplers[plane].texture, desc);
+  }
+};
+
+#include <Gfx/Qt5CompatPop> // clang-format: keep
+}
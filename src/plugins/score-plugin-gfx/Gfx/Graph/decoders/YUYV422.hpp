@@ -67,7 +67,7 @@ void main() {
       samplers.push_back({sampler, tex});
     }
 
-    return score::gfx::makeShaders(TexturedTriangle::instance().defaultVertexShader(), filter);
+    return score::gfx::tryMakeShaders(TexturedTriangle::instance().defaultVertexShader(), filter);
   }
 
   void exec(
@@ -170,7 +170,7 @@ void main() {
       samplers.push_back({sampler, tex});
     }
 
-    return score::gfx::makeShaders(TexturedTriangle::instance().defaultVertexShader(), filter);
+    return score::gfx::tryMakeShaders(TexturedTriangle::instance().defaultVertexShader(), filter);
   }
 
   void exec(
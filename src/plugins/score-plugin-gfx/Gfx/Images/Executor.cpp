@@ -47,7 +47,6 @@ ProcessExecutorComponent::ProcessExecutorComponent(
     auto ctrl = qobject_cast<Process::ControlInlet*>(element.inlets()[i]);
     auto& p = n->add_control();
     p->value = ctrl->value();
-    for(auto img : Gfx::getImages(p->value)) qDebug() << "init image: " << img.path << img.frames.size();
     p->changed = true;
 
     QObject::connect(
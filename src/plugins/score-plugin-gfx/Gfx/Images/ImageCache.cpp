@@ -0,0 +1,109 @@
+#include "ImageCache.hpp"
+
+#include <score/tools/ThreadPool.hpp>
+
+#include <QFileInfo>
+#include <QImageReader>
+#include <QThread>
+
+#include <algorithm>
+
+namespace Gfx
+{
+namespace
+{
+// Decoded images kept when no process uses them anymore
+constexpr std::size_t max_bytes = std::size_t(512) * 1024 * 1024;
+
+score::gfx::Image decode(const QString& path)
+{
+  QImageReader reader{path};
+  reader.setBackgroundColor(Qt::transparent);
+
+  std::vector<QImage> frames;
+  while (reader.canRead())
+  {
+    QImage img = reader.read();
+    if (img.isNull() || img.size() == QSize{})
+      break;
+
+    // The layout of the BGRA8 textures
+    frames.push_back(img.convertToFormat(QImage::Format_ARGB32));
+  }
+
+  return score::gfx::Image{path, std::move(frames)};
+}
+}
+
+ImageCache& ImageCache::instance() noexcept
+{
+  static ImageCache self;
+  return self;
+}
+
+ImageCache::ImageCache()
+{
+  m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+}
+
+ImageCache::~ImageCache()
+{
+  m_pool.clear();
+  m_pool.waitForDone();
+}
+
+int ImageCache::frameCount(const QString& path)
+{
+  // Only GIF can be animated amongst the supported formats:
+  // the others are not opened until they are decoded.
+  if (QFileInfo{path}.suffix().compare("gif", Qt::CaseInsensitive) != 0)
+    return 1;
+
+  QImageReader reader{path};
+  return std::max(reader.imageCount(), 1);
+}
+
+ImageCache::image_ptr ImageCache::tryAcquire(const QString& path)
+{
+  auto key = path.toStdString();
+
+  std::lock_guard lock{m_mutex};
+  if (auto it = m_index.find(key); it != m_index.end())
+  {
+    m_lru.splice(m_lru.begin(), m_lru, it->second);
+    return it->second->image;
+  }
+
+  if (m_pending.insert(key).second)
+  {
+    score::startOnPool(m_pool, [this, path, key = std::move(key)] {
+      auto img = std::make_shared<const score::gfx::Image>(decode(path));
+
+      std::lock_guard lock{m_mutex};
+      m_pending.erase(key);
+      insert(key, std::move(img));
+    });
+  }
+  return {};
+}
+
+void ImageCache::insert(const std::string& key, image_ptr img)
+{
+  std::size_t bytes = 0;
+  for (const auto& frame : img->frames)
+    bytes += frame.sizeInBytes();
+
+  m_lru.push_front(Entry{key, std::move(img), bytes});
+  m_index[key] = m_lru.begin();
+  m_bytes += bytes;
+
+  // The image just decoded is kept even if it is above the budget by itself
+  while (m_bytes > max_bytes && m_lru.size() > 1)
+  {
+    auto& last = m_lru.back();
+    m_bytes -= last.bytes;
+    m_index.erase(last.key);
+    m_lru.pop_back();
+  }
+}
+}
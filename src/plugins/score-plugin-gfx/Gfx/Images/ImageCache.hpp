@@ -0,0 +1,59 @@
+#pragma once
+#include <Gfx/Graph/Utils.hpp>
+
+#include <QThreadPool>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Gfx
+{
+/**
+ * @brief Decoded images, shared by all the Images processes.
+ *
+ * Files are decoded on background threads, in the layout of the textures
+ * they are uploaded to.
+ * The most recently used images are kept as long as they fit in the budget;
+ * an image which is evicted while still in use stays alive until it is not.
+ */
+class ImageCache
+{
+public:
+  using image_ptr = std::shared_ptr<const score::gfx::Image>;
+
+  static ImageCache& instance() noexcept;
+
+  //! Returns the image if it is decoded, otherwise starts decoding it.
+  //! A file which cannot be read gives an image without frames.
+  image_ptr tryAcquire(const QString& path);
+
+  //! Number of frames in a file, without decoding it
+  static int frameCount(const QString& path);
+
+private:
+  ImageCache();
+  ~ImageCache();
+
+  void insert(const std::string& key, image_ptr img);
+
+  struct Entry
+  {
+    std::string key;
+    image_ptr image;
+    std::size_t bytes{};
+  };
+
+  std::mutex m_mutex;
+  std::list<Entry> m_lru;
+  std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+  std::unordered_set<std::string> m_pending;
+  std::size_t m_bytes{};
+
+  // Last, so that the decoding tasks are over before the rest is destroyed
+  QThreadPool m_pool;
+};
+}
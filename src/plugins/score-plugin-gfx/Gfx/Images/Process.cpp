@@ -1,5 +1,6 @@
 #include "Process.hpp"
 
+#include <Gfx/Images/ImageCache.hpp>
 #include <Gfx/Images/ImageListChooser.hpp>
 #include <Gfx/Graph/Node.hpp>
 #include <Gfx/TexturePort.hpp>
@@ -25,26 +26,14 @@ ossia::value fromImageSet(const gsl::span<score::gfx::Image>& images)
   return v;
 }
 
-void releaseImages(std::vector<score::gfx::Image>& imgs)
+std::vector<QString> getImagePaths(const ossia::value& val)
 {
-  auto& cache = ImageCache::instance();
-  for(auto& img : imgs)
-    cache.release(std::move(img));
-  imgs.clear();
-}
-
-std::vector<score::gfx::Image> getImages(const ossia::value& val)
-{
-  auto& cache = ImageCache::instance();
-  std::vector<score::gfx::Image> imgs;
+  std::vector<QString> paths;
   for(auto& img : ossia::convert<std::vector<ossia::value>>(val))
   {
-    if(auto image = cache.acquire(ossia::convert<std::string>(img)))
-    {
-      imgs.push_back(std::move(*image));
-    }
+    paths.push_back(QString::fromStdString(ossia::convert<std::string>(img)));
   }
-  return imgs;
+  return paths;
 }
 }
 
@@ -104,18 +93,16 @@ Model::~Model() { }
 
 void Model::on_imagesChanged(const ossia::value& v)
 {
-  auto imgs = getImages(safe_cast<ImageListChooser*>(inlets().back())->value());
+  auto paths = getImagePaths(safe_cast<ImageListChooser*>(inlets().back())->value());
   int count = 0;
-  for (const auto& img : imgs)
-    count += img.frames.size();
+  for (const auto& path : paths)
+    count += ImageCache::frameCount(path);
 
   auto spinbox = safe_cast<Process::IntSpinBox*>(m_inlets[0]);
-  if (!imgs.empty())
+  if (count > 0)
     spinbox->setDomain(ossia::make_domain(int(0), int(count) - 1));
   else
     spinbox->setDomain(ossia::make_domain(int(0), int(0)));
-
-  releaseImages(imgs);
 }
 
 QString Model::prettyName() const noexcept
@@ -144,29 +131,17 @@ static bool isSupportedImage(const QFileInfo& filepath)
   return set.contains(filepath.completeSuffix().toLower());
 }
 
+// The images are decoded by the ImageCache when they are played
 static std::optional<score::gfx::Image> readImage(const QString& filename)
 {
   QFileInfo info{filename};
   if (!isSupportedImage(info))
     return {};
 
-  QImageReader reader{filename};
-  reader.setBackgroundColor(Qt::transparent);
-  std::vector<QImage> frames;
-  while (reader.canRead())
-  {
-    QImage img = reader.read();
-
-    if (img.isNull() || img.size() == QSize{})
-      continue;
-
-    frames.push_back(std::move(img));
-  }
-
-  if (frames.empty())
+  if (!QImageReader{filename}.canRead())
     return {};
 
-  return score::gfx::Image{filename, std::move(frames)};
+  return score::gfx::Image{filename, {}};
 }
 
 std::vector<Process::ProcessDropHandler::ProcessDrop> DropHandler::drop(
@@ -199,44 +174,6 @@ std::vector<Process::ProcessDropHandler::ProcessDrop> DropHandler::drop(
   vec.push_back(std::move(p));
   return vec;
 }
-}
-namespace Gfx
-{
-
-std::optional<score::gfx::Image> ImageCache::acquire(const std::string& path)
-{
-  if(auto it = m_images.find(path); it != m_images.end())
-  {
-    it->second.first++;
-    return it->second.second;
-  }
-
-  if(auto img = Images::readImage(QString::fromStdString(path)))
-  {
-    auto [it, ok] = m_images.insert({path, {0, *std::move(img)}});
-    return it->second.second;
-  }
-  return {};
-}
-
-void ImageCache::release(score::gfx::Image&& img)
-{
-  if(auto it = m_images.find(img.path.toStdString()); it != m_images.end())
-  {
-    it->second.first--;
-    if(it->second.first <= 0)
-    {
-      m_images.erase(it);
-    }
-  }
-}
-
-ImageCache& ImageCache::instance() noexcept
-{
-  static ImageCache img;
-  return img;
-}
-
 }
 template <>
 void DataStreamReader::read(const score::gfx::Image& proc)
@@ -248,8 +185,6 @@ template <>
 void DataStreamWriter::write(score::gfx::Image& proc)
 {
   m_stream >> proc.path;
-  if (auto img = Gfx::Images::readImage(proc.path))
-    proc = *std::move(img);
 }
 
 template <>
@@ -266,8 +201,6 @@ void JSONWriter::write(score::gfx::Image& proc)
 {
   const auto& obj = base.GetObject();
   proc.path = obj["Path"].GetString();
-  if (auto img = Gfx::Images::readImage(proc.path))
-    proc = *std::move(img);
 }
 
 template <>
@@ -12,20 +12,8 @@
 
 namespace Gfx
 {
-std::vector<score::gfx::Image> getImages(const ossia::value& val);
+std::vector<QString> getImagePaths(const ossia::value& val);
 ossia::value fromImageSet(const gsl::span<score::gfx::Image>& images);
-void releaseImages(std::vector<score::gfx::Image>& imgs);
-
-struct ImageCache
-{
-public:
-  std::optional<score::gfx::Image> acquire(const std::string& path);
-  void release(score::gfx::Image&& img);
-
-  static ImageCache& instance() noexcept;
-private:
-  std::unordered_map<std::string, std::pair<int, score::gfx::Image>> m_images;
-};
 }
 W_REGISTER_ARGTYPE(score::gfx::Image)
 
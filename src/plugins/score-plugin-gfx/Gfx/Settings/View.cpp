@@ -1,6 +1,7 @@
 // This is an open source non-commercial project. Dear PVS-Studio, please check
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 
+#include <Gfx/Graph/ShaderCache.hpp>
 #include <Gfx/Settings/Model.hpp>
 #include <Gfx/Settings/Presenter.hpp>
 #include <Gfx/Settings/View.hpp>
@@ -13,6 +14,7 @@
 #include <QComboBox>
 #include <QSpinBox>
 #include <QFormLayout>
+#include <QPushButton>
 
 #include <wobjectimpl.h>
 W_OBJECT_IMPL(Gfx::Settings::View)
@@ -27,6 +29,13 @@ View::View()
   SETTINGS_UI_DOUBLE_SPINBOX_SETUP("Rate (if no VSync)", Rate);
   m_Rate->setRange(1., 1000.);
   SETTINGS_UI_TOGGLE_SETUP("VSync", VSync);
+
+  auto clearCache = new QPushButton{tr("Clear"), m_widg};
+  clearCache->setToolTip(score::gfx::ShaderCache::diskCachePath());
+  connect(clearCache, &QPushButton::clicked, this, [] {
+    score::gfx::ShaderCache::clearDiskCache();
+  });
+  lay->addRow(tr("Shader cache"), clearCache);
 }
 
 QWidget* View::getWidget()
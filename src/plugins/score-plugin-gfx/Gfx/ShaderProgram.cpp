@@ -1,11 +1,17 @@
 #include "ShaderProgram.hpp"
 
+#include <Gfx/Graph/RenderedISFNode.hpp>
 #include <Gfx/Graph/ShaderCache.hpp>
 
 #include <ossia/detail/flat_map.hpp>
 
+#include <QCoreApplication>
 #include <QFile>
+#include <QPointer>
 #include <QRegularExpression>
+
+#include <atomic>
+#include <iterator>
 namespace Gfx
 {
 
@@ -91,12 +97,8 @@ ProgramCache& ProgramCache::instance() noexcept
 }
 
 std::pair<std::optional<ProcessedProgram>, QString>
-ProgramCache::get(const ShaderProgram& program) noexcept
+ProgramCache::parse(const ShaderProgram& program) noexcept
 {
-  auto it = programs.find(program);
-  if (it != programs.end())
-    return {it->second, QString{}};
-
   try
   {
     // Parse ISF and get GLSL shaders
@@ -125,36 +127,7 @@ ProgramCache::get(const ShaderProgram& program) noexcept
 
       // Add layout, location, etc
       updateToGlsl45(processed);
-
-      // Create QShader objects
-      auto [vertexS, vertexError]
-          = score::gfx::ShaderCache::get(processed.vertex.toUtf8(), QShader::VertexStage);
-      if (!vertexError.isEmpty())
-      {
-        qDebug().noquote() << vertexError;
-        qDebug().noquote() << processed.vertex.toUtf8();
-        return {std::nullopt, "Vertex shader error: " + vertexError};
-      }
-
-      auto [fragmentS, fragmentError] = score::gfx::ShaderCache::get(
-          processed.fragment.toUtf8(), QShader::FragmentStage);
-      if (!fragmentError.isEmpty())
-      {
-        qDebug().noquote() << fragmentError;
-        qDebug().noquote() << processed.fragment.toUtf8();
-
-        return {std::nullopt, "Fragment shader error: " + fragmentError};
-      }
-
-      if (vertexS.isValid() && fragmentS.isValid())
-      {
-        // We can store our shader in the cache
-        processed.compiledVertex = std::move(vertexS);
-        processed.compiledFragment = std::move(fragmentS);
-
-        programs[program] = processed;
-        return {processed, {}};
-      }
+      return {std::move(processed), {}};
     }
     else
     {
@@ -173,6 +146,134 @@ ProgramCache::get(const ShaderProgram& program) noexcept
   return {std::nullopt, "Unknown error"};
 }
 
+std::pair<std::optional<ProcessedProgram>, QString>
+ProgramCache::prefetch(const ShaderProgram& program) noexcept
+{
+  if (auto it = programs.find(program); it != programs.end())
+    return {it->second, QString{}};
+  if (auto it = pending.find(program); it != pending.end())
+    return {it->second.program, QString{}};
+
+  auto [processed, error] = parse(program);
+  if (!processed)
+    return {std::nullopt, std::move(error)};
+
+  // Create QShader objects on the shader cache's worker threads
+  auto vertex = score::gfx::ShaderCache::getAsync(
+      processed->vertex.toUtf8(), QShader::VertexStage);
+  auto fragment = score::gfx::ShaderCache::getAsync(
+      processed->fragment.toUtf8(), QShader::FragmentStage);
+  pending[program] = PendingProgram{*processed, vertex, fragment};
+
+  // Used by the programs with persistent passes
+  const auto [final_vertex, final_fragment] = score::gfx::isfFinalPassShaders();
+  score::gfx::ShaderCache::getAsync(final_vertex, QShader::VertexStage);
+  score::gfx::ShaderCache::getAsync(final_fragment, QShader::FragmentStage);
+
+  return {std::move(processed), QString{}};
+}
+
+void ProgramCache::whenReady(
+    const ShaderProgram& program,
+    QObject* context,
+    std::function<void()> onReady) noexcept
+{
+  if (programs.find(program) == programs.end())
+    prefetch(program);
+
+  auto it = pending.find(program);
+  if (it == pending.end())
+  {
+    // Already baked, or not a valid program: get() does not wait
+    QMetaObject::invokeMethod(context, std::move(onReady), Qt::QueuedConnection);
+    return;
+  }
+
+  // The last shader to be baked posts onReady: no thread waits for the bakes
+  const auto& processed = it->second.program;
+  const auto [final_vertex, final_fragment] = score::gfx::isfFinalPassShaders();
+  const std::pair<QByteArray, QShader::Stage> shaders[]{
+      {processed.vertex.toUtf8(), QShader::VertexStage},
+      {processed.fragment.toUtf8(), QShader::FragmentStage},
+      {final_vertex, QShader::VertexStage},
+      {final_fragment, QShader::FragmentStage}};
+
+  auto remaining = std::make_shared<std::atomic_int>(int(std::size(shaders)));
+  auto onBaked = [remaining,
+                  context = QPointer<QObject>{context},
+                  onReady = std::move(onReady)] {
+    if (remaining->fetch_sub(1) != 1)
+      return;
+
+    auto app = QCoreApplication::instance();
+    if (!app)
+      return;
+
+    QMetaObject::invokeMethod(
+        app,
+        [context, onReady] {
+          if (context)
+            onReady();
+        },
+        Qt::QueuedConnection);
+  };
+
+  for (const auto& [source, stage] : shaders)
+    score::gfx::ShaderCache::whenBaked(source, stage, onBaked);
+}
+
+std::pair<std::optional<ProcessedProgram>, QString>
+ProgramCache::get(const ShaderProgram& program) noexcept
+{
+  auto it = programs.find(program);
+  if (it != programs.end())
+    return {it->second, QString{}};
+
+  auto [prefetched, parseError] = prefetch(program);
+  if (!prefetched)
+    return {std::nullopt, std::move(parseError)};
+
+  auto pending_it = pending.find(program);
+  SCORE_ASSERT(pending_it != pending.end());
+  PendingProgram p = std::move(pending_it->second);
+  pending.erase(pending_it);
+
+  auto& processed = p.program;
+  auto [vertexS, vertexError] = p.vertex.get();
+  if (!vertexError.isEmpty())
+  {
+    qDebug().noquote() << vertexError;
+    qDebug().noquote() << processed.vertex.toUtf8();
+    return {std::nullopt, "Vertex shader error: " + vertexError};
+  }
+
+  auto [fragmentS, fragmentError] = p.fragment.get();
+  if (!fragmentError.isEmpty())
+  {
+    qDebug().noquote() << fragmentError;
+    qDebug().noquote() << processed.fragment.toUtf8();
+
+    return {std::nullopt, "Fragment shader error: " + fragmentError};
+  }
+
+  if (vertexS.isValid() && fragmentS.isValid())
+  {
+    // So that the render thread does not have to bake them
+    const auto [final_vertex, final_fragment] = score::gfx::isfFinalPassShaders();
+    score::gfx::ShaderCache::get(final_vertex, QShader::VertexStage);
+    score::gfx::ShaderCache::get(final_fragment, QShader::FragmentStage);
+
+    // We can store our shader in the cache
+    processed.compiledVertex = std::move(vertexS);
+    processed.compiledFragment = std::move(fragmentS);
+
+    programs[program] = processed;
+    return {std::move(processed), {}};
+  }
+
+  return {std::nullopt, "Unknown error"};
+}
+
 ShaderProgram
 programFromFragmentShaderPath(const QString& fsFilename, QByteArray fsData)
 {
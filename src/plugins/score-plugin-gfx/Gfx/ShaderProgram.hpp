@@ -10,6 +10,8 @@
 #include <isf.hpp>
 
 #include <array>
+#include <functional>
+#include <future>
 #include <optional>
 #include <verdigris>
 #include <score_plugin_gfx_export.h>
@@ -128,10 +130,37 @@ struct ProcessedProgram : ShaderProgram
 struct SCORE_PLUGIN_GFX_EXPORT ProgramCache
 {
   static ProgramCache& instance() noexcept;
+
+  //! Parses and bakes the program. Waits if it is being baked in the background.
   std::pair<std::optional<ProcessedProgram>, QString>
   get(const ShaderProgram& program) noexcept;
 
+  //! Parses the program and starts baking its shaders in the background.
+  //! The compiled shaders of the result are only set if they were already baked.
+  std::pair<std::optional<ProcessedProgram>, QString>
+  prefetch(const ShaderProgram& program) noexcept;
+
+  //! Calls onReady in the GUI thread once get() can be called without waiting
+  //! for a bake, unless context, which lives in the GUI thread, is destroyed
+  //! by then. The bakes post onReady themselves when they are done.
+  void whenReady(
+      const ShaderProgram& program,
+      QObject* context,
+      std::function<void()> onReady) noexcept;
+
   ossia::fast_hash_map<ShaderProgram, ProcessedProgram> programs;
+
+private:
+  std::pair<std::optional<ProcessedProgram>, QString>
+  parse(const ShaderProgram& program) noexcept;
+
+  struct PendingProgram
+  {
+    ProcessedProgram program;
+    std::shared_future<std::pair<QShader, QString>> vertex;
+    std::shared_future<std::pair<QShader, QString>> fragment;
+  };
+  ossia::fast_hash_map<ShaderProgram, PendingProgram> pending;
 };
 
 }
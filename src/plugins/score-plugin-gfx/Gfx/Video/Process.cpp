@@ -1,6 +1,7 @@
 #include "Process.hpp"
 
 #include <Gfx/Graph/Node.hpp>
+#include <Gfx/Graph/decoders/HAPDecompressor.hpp>
 #include <Gfx/TexturePort.hpp>
 #include <Media/Tempo.hpp>
 #include <Process/Dataflow/Port.hpp>
@@ -35,6 +36,7 @@ void Model::setPath(const QString& f)
 
   m_path = f;
   m_decoder = std::make_shared<video_decoder>();
+  m_decoder->setCompressedFrameProcessor(&score::gfx::decompressHAP);
   m_decoder->load(m_path.toStdString(), 60.);
   setLoopDuration(TimeVal{m_decoder->duration()});
   pathChanged(f);
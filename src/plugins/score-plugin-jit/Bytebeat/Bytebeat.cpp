@@ -35,7 +35,7 @@ QString generateBytebeatFunction(QString bb)
   {
     if (const auto simp = line.simplified(); !simp.isEmpty())
     {
-      computed += QStringLiteral("double(signed_char(%1))+").arg(simp);
+      computed += QStringLiteral("int(signed_char(%1))+").arg(simp);
       k++;
     }
   }
@@ -58,14 +58,54 @@ QString generateBytebeatFunction(QString bb)
 
 using signed_char = signed char;
 extern "C"
-void score_bytebeat(double* input, int size, int T)
+void score_bytebeat(double* __restrict output, int size, int T)
 {
-  for(auto end = input + size; input < end; ++input, ++T)
+  // A t lasts four samples: each one is only evaluated once, in blocks of
+  // consecutive t which the loop vectorizer spreads over SIMD lanes.
+  constexpr int block = 64;
+  double values[block];
+
+  // Samples of the first t which were not in the previous buffer
+  int head = (4 - T % 4) % 4;
+  const int t_end = (T + size + 3) / 4;
+  for(int t_begin = T / 4; t_begin < t_end; t_begin += block)
   {
-    const int t = T / 4;
+    const int count = t_end - t_begin < block ? t_end - t_begin : block;
+#pragma clang loop vectorize(enable) interleave(enable)
+    for(int k = 0; k < count; k++)
     {
-      *(input) = %1;
+      const int t = t_begin + k;
+      values[k] = %1;
     }
+
+    int k = 0;
+    if(head > 0)
+    {
+      const int n = head < size ? head : size;
+      for(int i = 0; i < n; i++)
+        output[i] = values[0];
+      output += n;
+      size -= n;
+      head = 0;
+      k = 1;
+    }
+
+    const int full = size / 4 < count - k ? size / 4 : count - k;
+    for(int j = 0; j < full; j++)
+    {
+      const double v = values[k + j];
+      output[4 * j] = v;
+      output[4 * j + 1] = v;
+      output[4 * j + 2] = v;
+      output[4 * j + 3] = v;
+    }
+    output += 4 * full;
+    size -= 4 * full;
+    k += full;
+
+    // The last t may be cut by the end of the buffer
+    for(int i = 0; k < count && i < size; i++)
+      output[i] = values[k];
   }
 }
 )_")
@@ -46,6 +46,19 @@ struct Driver
     return *jitedFn;
   }
 
+  //! Another function of the last compiled code, if it is defined
+  template <typename F>
+  std::function<F> function(const std::string& name)
+  {
+    auto fn = jit.getFunction<F>(name);
+    if (!fn)
+    {
+      llvm::consumeError(fn.takeError());
+      return {};
+    }
+    return *fn;
+  }
+
   llvm::PrettyStackTraceProgram X;
   llvm::LLVMContext context;
   llvm::orc::ThreadSafeContext ts_ctx;
@@ -139,6 +139,7 @@ void TexgenModel::reload()
     return;
   }
 
+  tileFactory = m_compiler->function<TexgenTileFunction>("score_rgba_tile");
   factory = std::move(jit_factory);
   changed();
 }
@@ -157,7 +158,11 @@ public:
     id = exec_context->ui->register_node(std::move(n));
   }
 
-  void set_function(TexgenFunction* func) { gfxNode->function = func; }
+  void set_function(TexgenFunction* func, TexgenTileFunction* tile)
+  {
+    gfxNode->tileFunction = tile;
+    gfxNode->function = func;
+  }
 
   ~texgen_node()
   {
@@ -177,17 +182,20 @@ TexgenExecutor::TexgenExecutor(
   auto bb = new texgen_node{ctx.doc.plugin<Gfx::DocumentPlugin>().exec};
   this->node.reset(bb);
 
-  if (auto tgt = proc.factory.target<void (*)(
-                     unsigned char* rgb, int width, int height, int t)>())
-    bb->set_function(*tgt);
+  auto tile = [&proc]() -> TexgenTileFunction* {
+    auto tgt = proc.tileFactory.target<TexgenTileFunction*>();
+    return tgt ? *tgt : nullptr;
+  };
+
+  if (auto tgt = proc.factory.target<TexgenFunction*>())
+    bb->set_function(*tgt, tile());
 
   m_ossia_process = std::make_shared<ossia::node_process>(node);
 
-  con(proc, &Jit::TexgenModel::changed, this, [this, &proc, bb] {
-    if (auto tgt = proc.factory.target<void (*)(
-                       unsigned char* rgb, int width, int height, int t)>())
+  con(proc, &Jit::TexgenModel::changed, this, [this, &proc, bb, tile] {
+    if (auto tgt = proc.factory.target<TexgenFunction*>())
     {
-      in_exec([tgt, bb] { bb->set_function(*tgt); });
+      in_exec([f = *tgt, t = tile(), bb] { bb->set_function(f, t); });
     }
   });
 }
@@ -244,11 +252,12 @@ template <>
 QString
 EffectProcessFactory_T<Jit::TexgenModel>::customConstructionData() const
 {
-  return R"_(extern "C"
-void score_rgba(unsigned char* rgba, int width, int height, int t)
+  return R"_(// Optional: called in parallel for bands of rows
+extern "C"
+void score_rgba_tile(unsigned char* rgba, int width, int height, int y_begin, int y_end, int t)
 {
-  int k = 0;
-  for(int j = 0; j < height; j++)
+  int k = 4 * y_begin * width;
+  for(int j = y_begin; j < y_end; j++)
   {
     for(int i = 0; i < width; i++)
     {
@@ -259,6 +268,12 @@ void score_rgba(unsigned char* rgba, int width, int height, int t)
     }
   }
 }
+
+extern "C"
+void score_rgba(unsigned char* rgba, int width, int height, int t)
+{
+  score_rgba_tile(rgba, width, height, 0, height, t);
+}
 )_";
 }
 
@@ -40,8 +40,17 @@ namespace Jit
 template <typename Fun_T>
 struct Driver;
 using TexgenFunction = void(unsigned char* rgb, int width, int height, int t);
+//! Fills the rows [y_begin; y_end) of the texture, from several threads
+using TexgenTileFunction = void(
+    unsigned char* rgb,
+    int width,
+    int height,
+    int y_begin,
+    int y_end,
+    int t);
 using TexgenCompiler = Driver<TexgenFunction>;
 using TexgenFactory = std::function<TexgenFunction>;
+using TexgenTileFactory = std::function<TexgenTileFunction>;
 class TexgenModel : public Process::ProcessModel
 {
   friend class JitUI;
@@ -77,6 +86,7 @@ public:
   Process::Outlets& outlets() { return m_outlets; }
 
   TexgenFactory factory;
+  TexgenTileFactory tileFactory;
 
   void errorMessage(int line, const QString& e)
       W_SIGNAL(errorMessage, line, e);
@@ -5,6 +5,7 @@
 #include "JSAPIWrapper.hpp"
 
 #include <Execution/DocumentPlugin.hpp>
+#include <Execution/Settings/ExecutorModel.hpp>
 #include <Explorer/DocumentPlugin/DeviceDocumentPlugin.hpp>
 #include <JS/ConsolePanel.hpp>
 #include <JS/JSProcessModel.hpp>
@@ -29,23 +30,66 @@
 
 #include <Scenario/Execution/score2OSSIA.hpp>
 
+#include <readerwriterqueue.h>
+
+#include <chrono>
+#include <optional>
+#include <thread>
 #include <vector>
 
 namespace JS
 {
 namespace Executor
 {
+class js_worker;
+
+//! Latest value of each control of the script, written by the GUI thread
+//! and read by the thread which runs the script.
+struct js_controls
+{
+  explicit js_controls(std::vector<int> inlets)
+      : inlets{std::move(inlets)}
+      , slots{std::make_unique<Execution::ControlSlot<ossia::value>[]>(
+            this->inlets.size())}
+  {
+  }
+
+  void write(std::size_t slot, const ossia::value& val)
+  {
+    slots[slot].write(val);
+    dirty.store(true, std::memory_order_release);
+  }
+
+  std::vector<int> inlets;
+  std::unique_ptr<Execution::ControlSlot<ossia::value>[]> slots;
+  std::atomic_bool dirty{};
+};
+
 class js_node final : public ossia::graph_node
 {
 public:
-  js_node(ossia::execution_state& st);
+  js_node(ossia::execution_state& st, bool threaded);
+  ~js_node();
 
-  void setScript(const QString& val);
+  void setScript(
+      const QString& val,
+      std::vector<int> in_kinds,
+      std::vector<int> out_kinds,
+      std::shared_ptr<js_controls> controls);
 
   void
   run(const ossia::token_request& t,
       ossia::exec_state_facade) noexcept override;
 
+  //! Runs f on the thread which owns the script engine.
+  template <typename F>
+  void onScriptThread(F&& f);
+
+  //! Calls the script and exchanges data with the ports used by the script.
+  void execute(
+      const ossia::token_request& t,
+      ossia::exec_state_facade) noexcept;
+
   ossia::execution_state& m_st;
   QQmlEngine* m_engine{};
   std::vector<Inlet*> m_jsInlets;
@@ -62,63 +106,226 @@ public:
 
   void setupComponent_gui(JS::Script*);
 
-  void setControl(std::size_t index, const QVariant& val)
+  //! Sets the controls which changed since the last call.
+  //! Must be called on the thread which owns the script engine.
+  void readControls(js_controls& controls) noexcept;
+
+  //! Controls read by the worker, if any
+  std::shared_ptr<js_controls> m_controls;
+  std::unique_ptr<js_worker> m_worker;
+
+private:
+  void loadScript(const QString& val);
+  void setupComponent(QQmlComponent& c);
+};
+
+/**
+ * @brief Runs the script engine of a js_node on its own thread.
+ *
+ * The audio thread hands the inputs of a tick over to the worker and
+ * collects the outputs at the next tick, which gives a fixed latency of one
+ * buffer. If the worker is not done by then, the previous audio outputs are
+ * repeated and the deadline is counted as missed; the values and MIDI
+ * messages received meanwhile are kept for the next run of the script.
+ *
+ * The worker only touches the shadow ports while a job is pending or
+ * running, and the audio thread only while the worker is idle or done.
+ * Device writes made by the script are applied by the audio thread along
+ * with the outputs, since the execution state belongs to it.
+ *
+ * The audio thread wakes the worker with a lightweight semaphore, which
+ * never takes a lock.
+ */
+class js_worker
+{
+public:
+  enum State : int
   {
-    if (index > m_jsInlets.size())
-      return;
-    if (auto v = qobject_cast<ValueInlet*>(m_jsInlets[index]))
-      v->setValue(val);
+    Idle,
+    Pending,
+    Running,
+    Done
+  };
+
+  explicit js_worker(js_node& node);
+  ~js_worker();
+
+  // Audio thread
+  void push(Execution::ExecutionCommand&& cmd) noexcept
+  {
+    if (!m_commands.enqueue(std::move(cmd)))
+      m_droppedCommands.fetch_add(1, std::memory_order_relaxed);
   }
 
+  //! Runs the pending commands even if the node does not tick anymore.
+  void flush() noexcept
+  {
+    // If a job is running, the worker sees the request once it is over
+    m_flushRequested.store(true);
+    switch (int state = m_state.load())
+    {
+      case Idle:
+        submit(false);
+        break;
+      case Done:
+        if (m_state.compare_exchange_strong(state, Idle))
+        {
+          writeOutputs();
+          submit(false);
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
+  void tick(
+      const ossia::token_request& tk,
+      ossia::exec_state_facade estate) noexcept;
+
+  // Worker thread
+  void setPorts(
+      const std::vector<int>& in_kinds,
+      const std::vector<int>& out_kinds);
+
+  ossia::inlets inlets;
+  ossia::outlets outlets;
+
 private:
-  void setupComponent(QQmlComponent& c);
+  void loop();
+  void runCommands();
+  void submit(bool has_tick) noexcept;
+  void stageInputs() noexcept;
+  void readInputs() noexcept;
+  void writeOutputs() noexcept;
+  void repeatOutputs() noexcept;
+  void reportMissed();
+
+  js_node& m_node;
+  ossia::spsc_queue<Execution::ExecutionCommand, 1024> m_commands;
+
+  moodycamel::spsc_sema::LightweightSemaphore m_wakeup;
+  std::atomic<int> m_state{Idle};
+  std::atomic_bool m_flushRequested{};
+  std::atomic_bool m_running{true};
+
+  ossia::token_request m_token;
+  std::optional<ossia::exec_state_facade> m_estate;
+  bool m_hasTick{};
+
+  std::vector<ossia::audio_vector> m_lastAudio;
+
+  //! Values and MIDI received by each input during missed deadlines
+  struct staged_input
+  {
+    std::vector<ossia::value> values;
+    std::vector<libremidi::message> midi;
+  };
+  std::vector<staged_input> m_staged;
+
+  std::atomic<int64_t> m_missed{};
+  std::atomic<int64_t> m_droppedCommands{};
+  int64_t m_reportedMissed{};
+  std::chrono::steady_clock::time_point m_lastReport{};
+
+  std::thread m_thread;
 };
 
+template <typename F>
+void js_node::onScriptThread(F&& f)
+{
+  if (m_worker)
+    m_worker->push(std::forward<F>(f));
+  else
+    f();
+}
+
 struct js_process final : public ossia::node_process
 {
   using node_process::node_process;
   js_node& js() const { return static_cast<js_node&>(*node); }
   void start() override
   {
-    if (auto obj = js().m_object)
-      if (obj->start().isCallable())
-        obj->start().call();
+    js().onScriptThread([&js = js()] {
+      if (auto obj = js.m_object)
+        if (obj->start().isCallable())
+          obj->start().call();
+    });
   }
   void stop() override
   {
-    if (auto obj = js().m_object)
-      if (obj->stop().isCallable())
-        obj->stop().call();
+    js().onScriptThread([&js = js()] {
+      if (auto obj = js.m_object)
+        if (obj->stop().isCallable())
+          obj->stop().call();
+    });
+    if (js().m_worker)
+      js().m_worker->flush();
   }
   void pause() override
   {
-    if (auto obj = js().m_object)
-      if (obj->pause().isCallable())
-        obj->pause().call();
+    js().onScriptThread([&js = js()] {
+      if (auto obj = js.m_object)
+        if (obj->pause().isCallable())
+          obj->pause().call();
+    });
+    if (js().m_worker)
+      js().m_worker->flush();
   }
   void resume() override
   {
-    if (auto obj = js().m_object)
-      if (obj->resume().isCallable())
-        obj->resume().call();
+    js().onScriptThread([&js = js()] {
+      if (auto obj = js.m_object)
+        if (obj->resume().isCallable())
+          obj->resume().call();
+    });
   }
   void transport_impl(ossia::time_value date) override
   {
-    QMetaObject::invokeMethod(
-        js().m_object,
-        "transport",
-        Qt::DirectConnection,
-        Q_ARG(QVariant, double(date.impl)));
+    js().onScriptThread([&js = js(), date] {
+      QMetaObject::invokeMethod(
+          js.m_object,
+          "transport",
+          Qt::DirectConnection,
+          Q_ARG(QVariant, double(date.impl)));
+    });
   }
   void offset_impl(ossia::time_value date) override
   {
-    QMetaObject::invokeMethod(
-        js().m_object,
-        "offset",
-        Qt::DirectConnection,
-        Q_ARG(QVariant, double(date.impl)));
+    js().onScriptThread([&js = js(), date] {
+      QMetaObject::invokeMethod(
+          js.m_object,
+          "offset",
+          Qt::DirectConnection,
+          Q_ARG(QVariant, double(date.impl)));
+    });
+  }
+};
+//! Applies the controls of a script which runs on the audio thread
+class js_control_mailbox final : public Execution::ControlMailbox
+{
+public:
+  js_control_mailbox(
+      std::shared_ptr<js_node> node,
+      std::shared_ptr<js_controls> controls)
+      : m_node{std::move(node)}
+      , m_controls{std::move(controls)}
+  {
+  }
+
+  void write(std::size_t slot, const ossia::value& val)
+  {
+    m_controls->write(slot, val);
+    markDirty();
   }
+
+private:
+  void applyControls() noexcept override { m_node->readControls(*m_controls); }
+
+  std::shared_ptr<js_node> m_node;
+  std::shared_ptr<js_controls> m_controls;
 };
+
 Component::Component(
     JS::ProcessModel& element,
     const ::Execution::Context& ctx,
@@ -129,7 +336,10 @@ Component::Component(
         "JSComponent",
         parent}
 {
-  std::shared_ptr<js_node> node = std::make_shared<js_node>(*ctx.execState);
+  const bool threaded = ctx.doc.app.settings<Execution::Settings::Model>()
+                            .getThreadedScripts();
+  std::shared_ptr<js_node> node
+      = std::make_shared<js_node>(*ctx.execState, threaded);
   this->node = node;
   auto proc = std::make_shared<js_process>(node);
   m_ossia_process = proc;
@@ -166,7 +376,7 @@ void Component::on_scriptChange(const QString& script)
   // 1. Create new inlet & outlet arrays
   ossia::inlets inls;
   ossia::outlets outls;
-  std::vector<Execution::ExecutionCommand> controlSetups;
+  std::vector<std::pair<Process::ControlInlet*, int>> controls;
 
   {
     if (auto object = process().currentObject())
@@ -195,20 +405,7 @@ void Component::on_scriptChange(const QString& script)
                 process().inlets()[idx]);
             SCORE_ASSERT(ctrl);
 
-            disconnect(ctrl, nullptr, this, nullptr);
-            connect(
-                ctrl,
-                &Process::ControlInlet::valueChanged,
-                this,
-                [=](const ossia::value& val) {
-                  this->in_exec([proc, val, idx] {
-                    proc->setControl(
-                        idx, val.apply(ossia::qt::ossia_to_qvariant{}));
-                  });
-                });
-            controlSetups.push_back([proc, val = ctrl->value(), idx] {
-              proc->setControl(idx, val.apply(ossia::qt::ossia_to_qvariant{}));
-            });
+            controls.emplace_back(ctrl, idx);
           }
 
           ++idx;
@@ -241,8 +438,22 @@ void Component::on_scriptChange(const QString& script)
     }
   }
 
+  // Changes of the controls go through a mailbox read at each tick
+  // instead of one command per change; a worker reads them itself.
+  std::shared_ptr<js_controls> values;
+  {
+    std::vector<int> indices;
+    indices.reserve(controls.size());
+    for (const auto& [ctrl, idx] : controls)
+      indices.push_back(idx);
+    values = std::make_shared<js_controls>(std::move(indices));
+  }
+  std::shared_ptr<js_control_mailbox> mailbox;
+  if (!proc->m_worker)
+    mailbox = std::make_shared<js_control_mailbox>(proc, values);
+
   // Send the updates to the node
-  commands.push_back([proc, script, inls, outls]() mutable {
+  commands.push_back([proc, script, inls, outls, values]() mutable {
 
     for(auto& inl : proc->root_inputs()) delete inl;
     for(auto& outl : proc->root_outputs()) delete outl;
@@ -250,13 +461,22 @@ void Component::on_scriptChange(const QString& script)
     using namespace std;
     swap(proc->root_inputs(), inls);
     swap(proc->root_outputs(), outls);
-    proc->setScript(std::move(script));
-  });
 
-  commands.commands.reserve(commands.commands.size() + controlSetups.size());
-  for (auto& cmd : controlSetups)
-    commands.commands.push_back(std::move(cmd));
-  controlSetups.clear();
+    // The worker mirrors the ports without touching the ones of the node.
+    std::vector<int> in_kinds, out_kinds;
+    if (proc->m_worker)
+    {
+      for (auto inl : proc->root_inputs())
+        in_kinds.push_back(inl->which());
+      for (auto outl : proc->root_outputs())
+        out_kinds.push_back(outl->which());
+    }
+    proc->setScript(
+        std::move(script),
+        std::move(in_kinds),
+        std::move(out_kinds),
+        proc->m_worker ? std::move(values) : nullptr);
+  });
 
   // Register the new inlets
   SCORE_ASSERT(process().inlets().size() == inls.size());
@@ -272,13 +492,37 @@ void Component::on_scriptChange(const QString& script)
 
   commands.run_all();
 
+  for (std::size_t i = 0; i < controls.size(); i++)
+  {
+    auto ctrl = controls[i].first;
+    auto write = [values, mailbox, i](const ossia::value& val) {
+      if (mailbox)
+        mailbox->write(i, val);
+      else
+        values->write(i, val);
+    };
+    write(ctrl->value());
+
+    disconnect(ctrl, nullptr, this, nullptr);
+    connect(ctrl, &Process::ControlInlet::valueChanged, this, write);
+  }
+  setControlMailbox(std::move(mailbox));
+
   m_oldInlets = process().inlets();
   m_oldOutlets = process().outlets();
 }
 
-js_node::js_node(ossia::execution_state& st)
+js_node::js_node(ossia::execution_state& st, bool threaded)
     : m_st{st}
 {
+  if (threaded)
+    m_worker = std::make_unique<js_worker>(*this);
+}
+
+js_node::~js_node()
+{
+  // Stops the thread, which releases the engine.
+  m_worker.reset();
 }
 
 void js_node::setupComponent(QQmlComponent& c)
@@ -286,6 +530,9 @@ void js_node::setupComponent(QQmlComponent& c)
   auto object = c.create();
   if ((m_object = qobject_cast<JS::Script*>(object)))
   {
+    // When running on a worker, the script reads and writes shadow ports
+    const auto& ins = m_worker ? m_worker->inlets : m_inlets;
+    const auto& outs = m_worker ? m_worker->outlets : m_outlets;
     m_object->setParent(m_engine);
     int input_i = 0;
     int output_i = 0;
@@ -302,34 +549,34 @@ void js_node::setupComponent(QQmlComponent& c)
       if (auto ctrl_in = qobject_cast<ControlInlet*>(n))
       {
         m_jsInlets.push_back(ctrl_in);
-        m_ctrlInlets.push_back({ctrl_in, m_inlets[input_i++]});
+        m_ctrlInlets.push_back({ctrl_in, ins[input_i++]});
       }
       else if (auto val_in = qobject_cast<ValueInlet*>(n))
       {
         m_jsInlets.push_back(val_in);
-        m_valInlets.push_back({val_in, m_inlets[input_i++]});
+        m_valInlets.push_back({val_in, ins[input_i++]});
       }
       else if (auto aud_in = qobject_cast<AudioInlet*>(n))
       {
         m_jsInlets.push_back(aud_in);
-        m_audInlets.push_back({aud_in, m_inlets[input_i++]});
+        m_audInlets.push_back({aud_in, ins[input_i++]});
       }
       else if (auto mid_in = qobject_cast<MidiInlet*>(n))
       {
         m_jsInlets.push_back(mid_in);
-        m_midInlets.push_back({mid_in, m_inlets[input_i++]});
+        m_midInlets.push_back({mid_in, ins[input_i++]});
       }
       else if (auto val_out = qobject_cast<ValueOutlet*>(n))
       {
-        m_valOutlets.push_back({val_out, m_outlets[output_i++]});
+        m_valOutlets.push_back({val_out, outs[output_i++]});
       }
       else if (auto aud_out = qobject_cast<AudioOutlet*>(n))
       {
-        m_audOutlets.push_back({aud_out, m_outlets[output_i++]});
+        m_audOutlets.push_back({aud_out, outs[output_i++]});
       }
       else if (auto mid_out = qobject_cast<MidiOutlet*>(n))
       {
-        m_midOutlets.push_back({mid_out, m_outlets[output_i++]});
+        m_midOutlets.push_back({mid_out, outs[output_i++]});
       }
     }
   }
@@ -338,12 +585,38 @@ void js_node::setupComponent(QQmlComponent& c)
     delete object;
   }
 }
-void js_node::setScript(const QString& val)
+void js_node::setScript(
+    const QString& val,
+    std::vector<int> in_kinds,
+    std::vector<int> out_kinds,
+    std::shared_ptr<js_controls> controls)
+{
+  if (m_worker)
+  {
+    m_worker->push([this,
+                    val,
+                    in_kinds = std::move(in_kinds),
+                    out_kinds = std::move(out_kinds),
+                    controls = std::move(controls)]() mutable {
+      m_worker->setPorts(in_kinds, out_kinds);
+      // The previous controls are released on the worker
+      std::swap(m_controls, controls);
+      loadScript(val);
+    });
+  }
+  else
+  {
+    loadScript(val);
+  }
+}
+
+void js_node::loadScript(const QString& val)
 {
   if (!m_engine)
   {
     m_engine = new QQmlEngine;
     m_execFuncs = new ExecStateWrapper{m_st, m_engine};
+    m_execFuncs->setDeferred(bool(m_worker));
     m_engine->rootContext()->setContextProperty("Device", m_execFuncs);
   }
 
@@ -383,9 +656,47 @@ void js_node::setScript(const QString& val)
   }
 }
 
+void js_node::readControls(js_controls& controls) noexcept
+{
+  if (!controls.dirty.exchange(false, std::memory_order_acquire))
+    return;
+
+  for (std::size_t i = 0; i < controls.inlets.size(); i++)
+  {
+    auto val = controls.slots[i].read();
+    if (!val)
+      continue;
+
+    const std::size_t index = controls.inlets[i];
+    if (index >= m_jsInlets.size())
+      continue;
+
+    if (auto v = qobject_cast<ValueInlet*>(m_jsInlets[index]))
+    {
+      try
+      {
+        v->setValue(val->apply(ossia::qt::ossia_to_qvariant{}));
+      }
+      catch (...)
+      {
+      }
+    }
+  }
+}
+
 void js_node::run(
     const ossia::token_request& tk,
     ossia::exec_state_facade estate) noexcept
+{
+  if (m_worker)
+    m_worker->tick(tk, estate);
+  else
+    execute(tk, estate);
+}
+
+void js_node::execute(
+    const ossia::token_request& tk,
+    ossia::exec_state_facade estate) noexcept
 {
   if (!m_engine || !m_object)
     return;
@@ -397,21 +708,21 @@ void js_node::run(
   //   return;
 
   QEventLoop e;
-  // Copy audio
-  for (int i = 0; i < m_audInlets.size(); i++)
+  // Copy audio in the buffers shared with the script
+  for (auto& [js_in, port] : m_audInlets)
   {
-    auto& dat = m_audInlets[i].second->target<ossia::audio_port>()->samples;
+    auto& dat = port->target<ossia::audio_port>()->samples;
+    auto& buffers = js_in->buffers();
 
-    const int dat_size = (int)dat.size();
-    QVector<QVector<double>> audio(dat_size);
-    for (int i = 0; i < dat_size; i++)
+    const std::size_t frames = dat.empty() ? 0 : dat[0].size();
+    buffers.resize(*m_engine, dat.size(), frames);
+    for (std::size_t chan = 0; chan < dat.size(); chan++)
     {
-      const int dat_i_size = dat[i].size();
-      audio[i].resize(dat_i_size);
-      for (int j = 0; j < dat_i_size; j++)
-        audio[i][j] = dat[i][j];
+      auto out = reinterpret_cast<double*>(buffers.data(chan));
+      const std::size_t N = std::min(frames, (std::size_t)dat[chan].size());
+      std::copy_n(dat[chan].data(), N, out);
+      std::fill(out + N, out + frames, 0.);
     }
-    m_audInlets[i].first->setAudio(audio);
   }
 
   // Copy values
@@ -466,6 +777,11 @@ void js_node::run(
     m_midInlets[i].first->setMidi(dat);
   }
 
+  const auto tick_start = estate.physical_start(tk);
+  const auto frames = tk.physical_write_duration(estate.modelToSamples());
+  for (auto& [js_out, port] : m_audOutlets)
+    js_out->prepare(frames);
+
   if (m_tickCall.empty())
     m_tickCall = {{}, {}};
 
@@ -509,23 +825,353 @@ void js_node::run(
     m_midOutlets[i].first->clear();
   }
 
-  auto tick_start = estate.physical_start(tk);
-  for (int out = 0; out < m_audOutlets.size(); out++)
+  for (auto& [js_out, port] : m_audOutlets)
   {
-    auto& src = m_audOutlets[out].first->audio();
-    auto& snk = m_audOutlets[out].second->target<ossia::audio_port>()->samples;
-    snk.resize(src.size());
-    for (int chan = 0; chan < src.size(); chan++)
+    auto& snk = port->target<ossia::audio_port>()->samples;
+    const auto& buffers = js_out->buffers();
+    if (js_out->usedBuffers())
     {
-      snk[chan].resize(src[chan].size() + tick_start);
+      // Script used buffer(i)
+      if (snk.size() < buffers.size())
+        snk.resize(buffers.size());
+      for (std::size_t chan = 0; chan < buffers.size(); chan++)
+      {
+        const std::size_t N = buffers.elements(chan);
+        if (snk[chan].size() < N + tick_start)
+          snk[chan].resize(N + tick_start);
 
-      for (int j = 0; j < src[chan].size(); j++)
-        snk[chan][j + tick_start] = src[chan][j];
+        auto src = reinterpret_cast<const double*>(buffers.data(chan));
+        std::copy_n(src, N, snk[chan].data() + tick_start);
+      }
+    }
+    else
+    {
+      // Script used setChannel(i, array)
+      auto& src = js_out->audio();
+      snk.resize(src.size());
+      for (int chan = 0; chan < src.size(); chan++)
+      {
+        snk[chan].resize(src[chan].size() + tick_start);
+
+        for (int j = 0; j < src[chan].size(); j++)
+          snk[chan][j + tick_start] = src[chan][j];
+      }
     }
   }
 
   e.processEvents();
   m_engine->collectGarbage();
 }
+
+js_worker::js_worker(js_node& node)
+    : m_node{node}
+    , m_commands(1024)
+    , m_thread{[this] { loop(); }}
+{
+}
+
+js_worker::~js_worker()
+{
+  m_running = false;
+  m_wakeup.signal();
+  m_thread.join();
+
+  for (auto inl : inlets)
+    delete inl;
+  for (auto outl : outlets)
+    delete outl;
+}
+
+void js_worker::loop()
+{
+  while (m_running)
+  {
+    m_wakeup.wait();
+    if (m_state.load(std::memory_order_acquire) != Pending)
+      continue;
+    m_state.store(Running, std::memory_order_release);
+
+    // This job runs all the commands pushed so far
+    m_flushRequested.exchange(false);
+    runCommands();
+
+    if (m_hasTick && m_estate)
+      m_node.execute(m_token, *m_estate);
+
+    for (;;)
+    {
+      m_state.store(Done);
+
+      // Commands pushed during the job by a node which does not tick
+      // anymore, unless the audio thread already took the outputs
+      if (!m_flushRequested.exchange(false))
+        break;
+      int state = Done;
+      if (!m_state.compare_exchange_strong(state, Running))
+        break;
+      runCommands();
+    }
+
+    reportMissed();
+  }
+
+  // The engine and the script objects belong to this thread
+  delete m_node.m_engine;
+  m_node.m_engine = nullptr;
+  m_node.m_object = nullptr;
+  m_node.m_execFuncs = nullptr;
+}
+
+void js_worker::runCommands()
+{
+  Execution::ExecutionCommand cmd;
+  while (m_commands.try_dequeue(cmd))
+    cmd();
+
+  if (m_node.m_controls)
+    m_node.readControls(*m_node.m_controls);
+}
+
+void js_worker::submit(bool has_tick) noexcept
+{
+  m_hasTick = has_tick;
+  m_state.store(Pending, std::memory_order_release);
+  m_wakeup.signal();
+}
+
+void js_worker::tick(
+    const ossia::token_request& tk,
+    ossia::exec_state_facade estate) noexcept
+{
+  // The worker may take a finished job back to run late commands
+  int state = m_state.load(std::memory_order_acquire);
+  if (state == Done)
+    m_state.compare_exchange_strong(state, Idle);
+
+  switch (state)
+  {
+    case Done:
+      writeOutputs();
+      break;
+    case Idle:
+      break;
+    default:
+      // The script did not finish within one buffer
+      m_missed.fetch_add(1, std::memory_order_relaxed);
+      stageInputs();
+      repeatOutputs();
+      return;
+  }
+
+  readInputs();
+  m_token = tk;
+  m_estate = estate;
+  submit(true);
+}
+
+void js_worker::stageInputs() noexcept
+{
+  // Bounds what a script which never finishes can accumulate
+  static constexpr std::size_t max_staged = 4096;
+
+  const auto& ins = m_node.root_inputs();
+  if (m_staged.size() < ins.size())
+    m_staged.resize(ins.size());
+
+  for (std::size_t i = 0; i < ins.size(); i++)
+  {
+    auto src = ins[i];
+    auto& staged = m_staged[i];
+    if (src->which() == ossia::value_port::which)
+    {
+      for (const auto& v : src->target<ossia::value_port>()->get_data())
+      {
+        if (staged.values.size() >= max_staged)
+          staged.values.erase(staged.values.begin());
+        staged.values.push_back(v.value);
+      }
+    }
+    else if (src->which() == ossia::midi_port::which)
+    {
+      for (const auto& m : src->target<ossia::midi_port>()->messages)
+      {
+        if (staged.midi.size() >= max_staged)
+          staged.midi.erase(staged.midi.begin());
+        staged.midi.push_back(m);
+      }
+    }
+  }
+}
+
+void js_worker::readInputs() noexcept
+{
+  if (auto reads = m_node.m_execFuncs)
+    reads->updateReads();
+
+  const auto& ins = m_node.root_inputs();
+  const std::size_t N = std::min(ins.size(), inlets.size());
+  for (std::size_t i = 0; i < N; i++)
+  {
+    auto src = ins[i];
+    auto dst = inlets[i];
+    if (src->which() != dst->which())
+      continue;
+
+    if (src->which() == ossia::audio_port::which)
+    {
+      dst->target<ossia::audio_port>()->samples
+          = src->target<ossia::audio_port>()->samples;
+    }
+    else if (src->which() == ossia::value_port::which)
+    {
+      auto& sp = *src->target<ossia::value_port>();
+      auto& dp = *dst->target<ossia::value_port>();
+      dp.clear();
+      dp.is_event = sp.is_event;
+
+      // Received during the missed ticks: they come first, at the start
+      if (i < m_staged.size())
+      {
+        for (auto& v : m_staged[i].values)
+          dp.write_value(std::move(v), 0);
+        m_staged[i].values.clear();
+      }
+      for (const auto& v : sp.get_data())
+        dp.write_value(v.value, v.timestamp);
+    }
+    else if (src->which() == ossia::midi_port::which)
+    {
+      const auto& sm = src->target<ossia::midi_port>()->messages;
+      auto& dm = dst->target<ossia::midi_port>()->messages;
+      dm.clear();
+      if (i < m_staged.size())
+      {
+        auto& staged = m_staged[i].midi;
+        dm.insert(dm.end(), staged.begin(), staged.end());
+        staged.clear();
+      }
+      dm.insert(dm.end(), sm.begin(), sm.end());
+    }
+  }
+}
+
+void js_worker::writeOutputs() noexcept
+{
+  if (auto writes = m_node.m_execFuncs)
+    writes->applyWrites();
+
+  if (!m_hasTick)
+    return;
+
+  const auto& outs = m_node.root_outputs();
+  const std::size_t N = std::min(outs.size(), outlets.size());
+  if (m_lastAudio.size() != outlets.size())
+    m_lastAudio.resize(outlets.size());
+
+  for (std::size_t i = 0; i < N; i++)
+  {
+    auto src = outlets[i];
+    auto dst = outs[i];
+    if (src->which() != dst->which())
+      continue;
+
+    if (src->which() == ossia::audio_port::which)
+    {
+      const auto& samples = src->target<ossia::audio_port>()->samples;
+      dst->target<ossia::audio_port>()->samples = samples;
+      m_lastAudio[i] = samples;
+    }
+    else if (src->which() == ossia::value_port::which)
+    {
+      auto& sp = *src->target<ossia::value_port>();
+      auto& dp = *dst->target<ossia::value_port>();
+      for (const auto& v : sp.get_data())
+        dp.write_value(v.value, v.timestamp);
+      sp.clear();
+    }
+    else if (src->which() == ossia::midi_port::which)
+    {
+      auto& sm = src->target<ossia::midi_port>()->messages;
+      auto& dm = dst->target<ossia::midi_port>()->messages;
+      dm.insert(dm.end(), sm.begin(), sm.end());
+      sm.clear();
+    }
+  }
+}
+
+void js_worker::repeatOutputs() noexcept
+{
+  // Values and MIDI are events: repeating them would duplicate them.
+  const auto& outs = m_node.root_outputs();
+  const std::size_t N = std::min(outs.size(), m_lastAudio.size());
+  for (std::size_t i = 0; i < N; i++)
+  {
+    if (outs[i]->which() == ossia::audio_port::which)
+      outs[i]->target<ossia::audio_port>()->samples = m_lastAudio[i];
+  }
+}
+
+void js_worker::setPorts(
+    const std::vector<int>& in_kinds,
+    const std::vector<int>& out_kinds)
+{
+  // The script objects refer to the previous shadow ports
+  m_node.m_ctrlInlets.clear();
+  m_node.m_valInlets.clear();
+  m_node.m_audInlets.clear();
+  m_node.m_midInlets.clear();
+  m_node.m_valOutlets.clear();
+  m_node.m_audOutlets.clear();
+  m_node.m_midOutlets.clear();
+
+  for (auto inl : inlets)
+    delete inl;
+  inlets.clear();
+  for (int k : in_kinds)
+  {
+    if (k == ossia::audio_port::which)
+      inlets.push_back(new ossia::audio_inlet);
+    else if (k == ossia::midi_port::which)
+      inlets.push_back(new ossia::midi_inlet);
+    else
+      inlets.push_back(new ossia::value_inlet);
+  }
+
+  for (auto outl : outlets)
+    delete outl;
+  outlets.clear();
+  for (int k : out_kinds)
+  {
+    if (k == ossia::audio_port::which)
+      outlets.push_back(new ossia::audio_outlet);
+    else if (k == ossia::midi_port::which)
+      outlets.push_back(new ossia::midi_outlet);
+    else
+      outlets.push_back(new ossia::value_outlet);
+  }
+}
+
+void js_worker::reportMissed()
+{
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_lastReport < std::chrono::seconds(1))
+    return;
+
+  const int64_t missed = m_missed.load(std::memory_order_relaxed);
+  if (missed != m_reportedMissed)
+  {
+    ossia::logger().warn(
+        "JS: the script missed {} audio deadlines",
+        missed - m_reportedMissed);
+    m_reportedMissed = missed;
+    m_lastReport = now;
+  }
+
+  if (const int64_t dropped = m_droppedCommands.exchange(0))
+  {
+    ossia::logger().warn("JS: {} commands to the script were dropped", dropped);
+    m_lastReport = now;
+  }
+}
 }
 }
@@ -94,6 +94,21 @@ const ossia::destination_t& ExecStateWrapper::find_address(const QString& str)
 
 QVariant ExecStateWrapper::read(const QString& address)
 {
+  if (m_deferred)
+  {
+    const auto& r = m_reads[address];
+    if (r.values.empty())
+      return {};
+    if (r.unique)
+      return r.values.front().second.apply(ossia::qt::ossia_to_qvariant{});
+
+    QVariantMap mv;
+    for (const auto& [name, val] : r.values)
+      mv[QString::fromStdString(name)]
+          = val.apply(ossia::qt::ossia_to_qvariant{});
+    return mv;
+  }
+
   if (auto addr = find_address(address))
   {
     QVariant var;
@@ -124,6 +139,12 @@ QVariant ExecStateWrapper::read(const QString& address)
 
 void ExecStateWrapper::write(const QString& address, const QVariant& value)
 {
+  if (m_deferred)
+  {
+    m_writes.emplace_back(address, ossia::qt::qt_to_ossia{}(value));
+    return;
+  }
+
   if (const auto& addr = find_address(address))
   {
     auto val = ossia::qt::qt_to_ossia{}(value);
@@ -138,4 +159,42 @@ void ExecStateWrapper::write(const QString& address, const QVariant& value)
   }
 }
 
+void ExecStateWrapper::updateReads()
+{
+  for (auto& [address, r] : m_reads)
+  {
+    r.values.clear();
+    if (const auto& addr = find_address(address))
+    {
+      r.unique = ossia::apply_to_destination(
+          addr,
+          devices.exec_devices(),
+          [&r](ossia::net::parameter_base* addr, bool unique) {
+            r.values.emplace_back(
+                unique ? std::string{} : addr->get_node().osc_address(),
+                addr->value());
+          },
+          ossia::do_nothing_for_nodes{});
+    }
+  }
+}
+
+void ExecStateWrapper::applyWrites()
+{
+  for (const auto& [address, val] : m_writes)
+  {
+    if (const auto& addr = find_address(address))
+    {
+      ossia::apply_to_destination(
+          addr,
+          devices.exec_devices(),
+          [&](ossia::net::parameter_base* addr, bool unique) {
+            devices.insert(*addr, ossia::typed_value{val});
+          },
+          ossia::do_nothing_for_nodes{});
+    }
+  }
+  m_writes.clear();
+}
+
 }
@@ -4,13 +4,22 @@
 #include <ossia/dataflow/dataflow_fwd.hpp>
 #include <ossia/detail/hash_map.hpp>
 #include <ossia/network/common/path.hpp>
+#include <ossia/network/value/value.hpp>
 
 #include <QObject>
 
 #include <verdigris>
+
+#include <string>
+#include <utility>
+#include <vector>
 namespace ossia
 {
 struct execution_state;
+namespace net
+{
+class parameter_base;
+}
 }
 namespace JS
 {
@@ -31,8 +40,27 @@ public:
   W_SLOT(write);
   void exec(const QString& code) W_SIGNAL(exec, code);
 
+  //! When the script does not run on the audio thread, it never accesses
+  //! the devices itself: its writes are kept until the audio thread applies
+  //! them with applyWrites(), and its reads return the values copied by the
+  //! audio thread in updateReads(). An address read for the first time
+  //! thus has a value from the next tick on.
+  void setDeferred(bool b) noexcept { m_deferred = b; }
+  void updateReads();
+  void applyWrites();
+
 private:
+  struct DeferredRead
+  {
+    // The OSC address of each parameter, when the address is a pattern
+    std::vector<std::pair<std::string, ossia::value>> values;
+    bool unique{true};
+  };
+
   ossia::execution_state& devices;
+  ossia::fast_hash_map<QString, DeferredRead> m_reads;
+  std::vector<std::pair<QString, ossia::value>> m_writes;
+  bool m_deferred{};
 
   const ossia::destination_t& find_address(const QString&);
   ossia::fast_hash_map<QString, ossia::destination_t> m_address_cache;
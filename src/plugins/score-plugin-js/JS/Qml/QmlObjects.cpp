@@ -1,6 +1,9 @@
 #include "QmlObjects.hpp"
 
 #include <wobjectimpl.h>
+
+#include <algorithm>
+
 W_OBJECT_IMPL(JS::Inlet)
 W_OBJECT_IMPL(JS::Outlet)
 W_OBJECT_IMPL(JS::ValueInlet)
@@ -98,14 +101,16 @@ AudioInlet::AudioInlet(QObject* parent)
 
 AudioInlet::~AudioInlet() { }
 
-const QVector<QVector<double>>& AudioInlet::audio() const
+QVector<double> AudioInlet::channel(int i) const
 {
-  return m_audio;
-}
+  if (i < 0 || i >= int(m_buffers.size()))
+    return {};
 
-void AudioInlet::setAudio(const QVector<QVector<double>>& audio)
-{
-  m_audio = audio;
+  auto data = reinterpret_cast<const double*>(m_buffers.data(i));
+  const int N = int(m_buffers.elements(i));
+  QVector<double> res(N);
+  std::copy_n(data, N, res.begin());
+  return res;
 }
 
 AudioOutlet::AudioOutlet(QObject* parent)
@@ -120,6 +125,38 @@ const QVector<QVector<double>>& AudioOutlet::audio() const
   return m_audio;
 }
 
+QJSValue AudioOutlet::buffer(int i)
+{
+  if (i < 0)
+    return {};
+
+  if (auto engine = qjsEngine(this))
+    m_buffers.reserve(*engine, i, m_frames);
+  if (i >= int(m_buffers.size()))
+    return {};
+  m_usedBuffers = true;
+  return m_buffers.array(i);
+}
+
+void AudioOutlet::prepare(int frames)
+{
+  m_usedBuffers = false;
+  if (frames != m_frames)
+  {
+    m_frames = frames;
+    if (auto engine = qjsEngine(this))
+      m_buffers.resize(*engine, m_buffers.size(), frames);
+  }
+
+  for (std::size_t i = 0; i < m_buffers.size(); i++)
+  {
+    std::fill_n(
+        reinterpret_cast<double*>(m_buffers.data(i)),
+        m_buffers.elements(i),
+        0.);
+  }
+}
+
 MidiInlet::MidiInlet(QObject* parent)
     : Inlet{parent}
 {
@@ -127,6 +164,35 @@ MidiInlet::MidiInlet(QObject* parent)
 
 MidiInlet::~MidiInlet() { }
 
+QVariantList MidiInlet::messages() const
+{
+  QVariantList res;
+  if (m_bytes.size() == 0)
+    return res;
+
+  auto data = reinterpret_cast<const uint8_t*>(m_bytes.data(0));
+  auto end = data + m_bytesLength;
+  while (data < end)
+  {
+    int N = 0;
+    for (int shift = 0; data < end; shift += 7)
+    {
+      const uint8_t b = *data++;
+      N |= (b & 0x7f) << shift;
+      if (!(b & 0x80))
+        break;
+    }
+    N = std::min(N, int(end - data));
+
+    QVector<int> m(N);
+    for (int i = 0; i < N; i++)
+      m[i] = data[i];
+    data += N;
+    res.push_back(QVariant::fromValue(m));
+  }
+  return res;
+}
+
 MidiOutlet::MidiOutlet(QObject* parent)
     : Outlet{parent}
 {
@@ -2,11 +2,13 @@
 #include <Process/Dataflow/Port.hpp>
 #include <Process/Dataflow/WidgetInlets.hpp>
 #include <State/Domain.hpp>
+#include <JS/Qml/TypedArray.hpp>
 
 #include <score/tools/Debug.hpp>
 
 #include <ossia/network/domain/domain.hpp>
 
+#include <QJSEngine>
 #include <QJSValue>
 #include <QObject>
 #include <QQmlListProperty>
@@ -266,15 +268,25 @@ class AudioInlet : public Inlet
 public:
   AudioInlet(QObject* parent = nullptr);
   virtual ~AudioInlet() override;
-  const QVector<QVector<double>>& audio() const;
-  void setAudio(const QVector<QVector<double>>& audio);
 
-  QVector<double> channel(int i) const
+  //! Storage shared with the scripts, filled by the executor at each tick
+  TypedArrays& buffers() noexcept { return m_buffers; }
+
+  int channels() const noexcept { return int(m_buffers.size()); }
+  W_INVOKABLE(channels);
+
+  //! Float64Array with the samples of channel i for the current tick.
+  //! It is reused across ticks and must not be kept by the script.
+  QJSValue buffer(int i) const
   {
-    if (m_audio.size() > i)
-      return m_audio[i];
+    if (i >= 0 && i < int(m_buffers.size()))
+      return m_buffers.array(i);
     return {};
   }
+  W_INVOKABLE(buffer);
+
+  //! Copy of the samples of channel i. Prefer buffer.
+  QVector<double> channel(int i) const;
   W_INVOKABLE(channel);
 
   Process::Inlet* make(Id<Process::Port>&& id, QObject* parent) override
@@ -283,7 +295,7 @@ public:
   }
 
 private:
-  QVector<QVector<double>> m_audio;
+  TypedArrays m_buffers{TypedArrays::Float64};
 };
 
 class AudioOutlet : public Outlet
@@ -310,8 +322,26 @@ public:
     m_audio[i] = v;
   }
   W_INVOKABLE(setChannel)
+
+  //! Float64Array, sized to the current tick, in which the script writes
+  //! the samples of channel i. It is zeroed before each tick, and has to
+  //! be requested again at each tick for its content to be output.
+  QJSValue buffer(int i);
+  W_INVOKABLE(buffer)
+
+  //! Called by the executor before each tick
+  void prepare(int frames);
+  const TypedArrays& buffers() const noexcept { return m_buffers; }
+
+  //! Whether the script called buffer(i) during this tick,
+  //! instead of setChannel
+  bool usedBuffers() const noexcept { return m_usedBuffers; }
+
 private:
   QVector<QVector<double>> m_audio;
+  TypedArrays m_buffers{TypedArrays::Float64};
+  int m_frames{};
+  bool m_usedBuffers{};
 };
 
 class MidiMessage
@@ -331,24 +361,48 @@ class MidiInlet : public Inlet
 public:
   MidiInlet(QObject* parent = nullptr);
   virtual ~MidiInlet() override;
+  //! Packs the messages in the byte buffer shared with the scripts
   template <typename T>
   void setMidi(const T& arr)
   {
-    m_midi.clear();
+    std::size_t total = 0;
     for (const libremidi::message& mess : arr)
-    {
-      const auto N = mess.size();
-      QVector<int> m;
-      m.resize(N);
+      total += lengthSize(mess.size()) + mess.size();
 
-      for (std::size_t i = 0; i < N; i++)
-        m[i] = mess.bytes[i];
+    if (auto engine = qjsEngine(this))
+      m_bytes.reserve(*engine, 0, total);
+    if (m_bytes.size() == 0 || m_bytes.elements(0) < total)
+    {
+      m_bytesLength = 0;
+      return;
+    }
 
-      m_midi.push_back(QVariant::fromValue(m));
+    auto data = reinterpret_cast<uint8_t*>(m_bytes.data(0));
+    for (const libremidi::message& mess : arr)
+    {
+      data = writeLength(data, mess.size());
+      std::copy(mess.bytes.begin(), mess.bytes.end(), data);
+      data += mess.size();
     }
+    m_bytesLength = int(total);
   }
 
-  QVariantList messages() const { return m_midi; }
+  //! Uint8Array with all the messages of the tick.
+  //! Each message is prefixed by its size: [n, b0, ..., bn-1, n', ...].
+  //! The size is a varint so that SysEx messages fit: 7 bits per byte,
+  //! least significant first, the high bit set on all the bytes but the
+  //! last one. Sizes below 128 thus take a single byte.
+  //! Only the first bytesLength() bytes are valid.
+  QJSValue bytes() const
+  {
+    return m_bytes.size() > 0 ? m_bytes.array(0) : QJSValue{};
+  }
+  W_INVOKABLE(bytes);
+  int bytesLength() const noexcept { return m_bytesLength; }
+  W_INVOKABLE(bytesLength);
+
+  //! Copy of the messages as arrays of ints. Prefer bytes.
+  QVariantList messages() const;
   W_INVOKABLE(messages);
 
   Process::Inlet* make(Id<Process::Port>&& id, QObject* parent) override
@@ -357,7 +411,27 @@ public:
   }
 
 private:
-  QVariantList m_midi;
+  static std::size_t lengthSize(std::size_t n) noexcept
+  {
+    std::size_t sz = 1;
+    while (n >>= 7)
+      sz++;
+    return sz;
+  }
+
+  static uint8_t* writeLength(uint8_t* data, std::size_t n) noexcept
+  {
+    while (n >= 0x80)
+    {
+      *data++ = uint8_t(n | 0x80);
+      n >>= 7;
+    }
+    *data++ = uint8_t(n);
+    return data;
+  }
+
+  TypedArrays m_bytes{TypedArrays::Uint8};
+  int m_bytesLength{};
 };
 
 class MidiOutlet : public Outlet
@@ -0,0 +1,87 @@
+#include "TypedArray.hpp"
+
+#include <QJSEngine>
+
+#include <private/qjsvalue_p.h>
+#include <private/qv4arraybuffer_p.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace JS
+{
+namespace
+{
+char* arrayBufferData(const QJSValue& buf)
+{
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+  if (auto ab = QJSValuePrivate::asManagedType<QV4::ArrayBuffer>(&buf))
+    return const_cast<QV4::ArrayBuffer*>(ab)->arrayData();
+#else
+  if (auto v = QJSValuePrivate::getValue(&buf))
+    if (auto ab = v->as<QV4::ArrayBuffer>())
+      return const_cast<QV4::ArrayBuffer*>(ab)->data();
+#endif
+  return nullptr;
+}
+}
+
+void TypedArrays::allocate(QJSEngine& engine, std::size_t i, std::size_t elements)
+{
+  if (m_ctor.isUndefined())
+  {
+    m_ctor = engine.evaluate(
+        m_type == Float64 ? "(function(b) { return new Float64Array(b); })"
+                          : "(function(b) { return new Uint8Array(b); })");
+  }
+
+  const std::size_t bytes
+      = elements * (m_type == Float64 ? sizeof(double) : sizeof(uint8_t));
+
+  // QByteArray is converted to an ArrayBuffer by the engine.
+  // Once the temporary is released, the ArrayBuffer is the sole owner of
+  // the storage, thus the pointer we get is stable until the next resize.
+  m_buffers[i] = engine.toScriptValue(QByteArray(int(bytes), 0));
+  m_arrays[i] = m_ctor.call({m_buffers[i]});
+  m_data[i] = arrayBufferData(m_buffers[i]);
+  m_elements[i] = m_data[i] ? elements : 0;
+}
+
+void TypedArrays::resize(QJSEngine& engine, std::size_t n, std::size_t elements)
+{
+  const std::size_t old_n = m_arrays.size();
+  if (old_n != n)
+  {
+    m_buffers.resize(n);
+    m_arrays.resize(n);
+    m_data.resize(n);
+    m_elements.resize(n);
+  }
+
+  for (std::size_t i = 0; i < n; i++)
+  {
+    if (i >= old_n || m_elements[i] != elements)
+      allocate(engine, i, elements);
+  }
+}
+
+void TypedArrays::reserve(QJSEngine& engine, std::size_t i, std::size_t elements)
+{
+  if (i >= m_arrays.size())
+  {
+    const std::size_t old_n = m_arrays.size();
+    m_buffers.resize(i + 1);
+    m_arrays.resize(i + 1);
+    m_data.resize(i + 1);
+    m_elements.resize(i + 1);
+    for (std::size_t k = old_n; k <= i; k++)
+      allocate(engine, k, elements);
+  }
+  else if (m_elements[i] < elements)
+  {
+    // Grow geometrically so that variable-size data such as MIDI
+    // settles quickly.
+    allocate(engine, i, std::max(elements, 2 * m_elements[i]));
+  }
+}
+}
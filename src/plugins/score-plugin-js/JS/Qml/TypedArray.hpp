@@ -0,0 +1,56 @@
+#pragma once
+#include <QJSValue>
+
+#include <vector>
+
+class QJSEngine;
+namespace JS
+{
+/**
+ * @brief Typed arrays allocated once in the JS heap and reused across ticks.
+ *
+ * Each entry is an ArrayBuffer and a typed view on it (e.g. a Float64Array).
+ * The C++ side accesses the storage of the ArrayBuffer directly,
+ * thus exchanging data with scripts only costs a memcpy: nothing gets
+ * allocated or converted as long as the sizes do not change.
+ */
+class TypedArrays
+{
+public:
+  enum Type
+  {
+    Float64,
+    Uint8
+  };
+
+  explicit TypedArrays(Type t) noexcept
+      : m_type{t}
+  {
+  }
+
+  //! Ensures that there are n arrays of the given element count.
+  //! Only allocates when the layout changes.
+  void resize(QJSEngine& engine, std::size_t n, std::size_t elements);
+
+  //! Grows the array at index i to be able to hold at least elements.
+  void reserve(QJSEngine& engine, std::size_t i, std::size_t elements);
+
+  std::size_t size() const noexcept { return m_arrays.size(); }
+  std::size_t elements(std::size_t i) const noexcept
+  {
+    return m_elements[i];
+  }
+  char* data(std::size_t i) const noexcept { return m_data[i]; }
+  const QJSValue& array(std::size_t i) const noexcept { return m_arrays[i]; }
+
+private:
+  void allocate(QJSEngine& engine, std::size_t i, std::size_t elements);
+
+  std::vector<QJSValue> m_buffers;
+  std::vector<QJSValue> m_arrays;
+  std::vector<char*> m_data;
+  std::vector<std::size_t> m_elements;
+  QJSValue m_ctor;
+  Type m_type{};
+};
+}
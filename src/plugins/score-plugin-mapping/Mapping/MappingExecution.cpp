@@ -3,6 +3,7 @@
 #include "MappingExecution.hpp"
 
 #include <Curve/CurveConversion.hpp>
+#include <Curve/Settings/CurveSettingsModel.hpp>
 #include <Device/Protocol/DeviceInterface.hpp>
 #include <Process/ExecutionContext.hpp>
 #include <Process/ExecutionFunctions.hpp>
@@ -126,6 +127,9 @@ std::shared_ptr<ossia::curve_abstract> Component::on_curveChanged_impl2()
   auto segt_data = process().curve().sortedSegments();
   if (segt_data.size() != 0)
   {
+    if (system().doc.app.settings<Curve::Settings::Model>().getBakeCurves())
+      return Engine::score_to_ossia::bakedCurve<X_T, Y_T>(
+          scale_x, scale_y, segt_data, {});
     return Engine::score_to_ossia::curve<X_T, Y_T>(
         scale_x, scale_y, segt_data, {});
   }
@@ -1,5 +1,6 @@
 #include "AudioDecoder.hpp"
 
+#include <Media/DecodeScheduler.hpp>
 #include <Media/Libav.hpp>
 #include <Media/Sound/SoundModel.hpp>
 
@@ -452,19 +453,11 @@ namespace Media
 AudioDecoder::AudioDecoder(int rate)
     : convertedSampleRate{rate}
 {
-  connect(
-      this,
-      &AudioDecoder::startDecode,
-      this,
-      &AudioDecoder::on_startDecode,
-      Qt::QueuedConnection);
 }
 
 AudioDecoder::~AudioDecoder()
 {
-  m_decodeThread.exit();
-  while (m_decodeThread.isRunning())
-    ;
+  DecodeScheduler::instance().cancel(*this);
 }
 
 struct AVCodecContext_Free
@@ -654,9 +647,8 @@ void AudioDecoder::decode(const QString& path, audio_handle hdl)
   if (data.size() == 0)
     return;
 
-  this->moveToThread(&m_decodeThread);
-  m_decodeThread.start();
-  startDecode(path, hdl);
+  m_cancelled = false;
+  DecodeScheduler::instance().enqueue(*this, path, std::move(hdl));
 #endif
 }
 
@@ -881,7 +873,7 @@ void AudioDecoder::on_startDecode(QString path, audio_handle hdl)
 
           debug_ffmpeg(ret, "av_read_frame");
           int update = 0;
-          while (ret >= 0)
+          while (ret >= 0 && !m_cancelled)
           {
             ret = avcodec_send_packet(codec_ctx.get(), &packet);
             debug_ffmpeg(ret, "avcodec_send_packet");
@@ -936,6 +928,12 @@ void AudioDecoder::on_startDecode(QString path, audio_handle hdl)
             }
           }
 
+          if (m_cancelled)
+          {
+            av_packet_unref(&packet);
+            return;
+          }
+
           // Flush
           ret = avcodec_send_packet(codec_ctx.get(), nullptr);
 
@@ -954,8 +952,8 @@ void AudioDecoder::on_startDecode(QString path, audio_handle hdl)
     qDebug() << "Decoder error: " << e.what();
   }
 
-  finishedDecoding(hdl);
-  m_decodeThread.quit();
+  if (!m_cancelled)
+    finishedDecoding(hdl);
 
 #endif
   return;
@@ -5,8 +5,6 @@
 #include <ossia/detail/flicks.hpp>
 #include <ossia/detail/optional.hpp>
 
-#include <QThread>
-
 #include <atomic>
 #include <vector>
 #include <verdigris>
@@ -31,6 +29,16 @@ struct AudioInfo
   }
 };
 
+//! Order in which the files waiting to be decoded are processed
+enum class DecodePriority : int8_t
+{
+  Background,
+  //! Shown in a scenario
+  Visible,
+  //! Used by a running execution
+  Playing
+};
+
 class AudioDecoder : public QObject
 {
   W_OBJECT(AudioDecoder)
@@ -39,8 +47,14 @@ public:
   AudioDecoder(int rate);
   ~AudioDecoder();
   static std::optional<AudioInfo> probe(const QString& path);
+
+  //! Decoding happens on the DecodeScheduler threads.
+  //! The signals are sent from them.
   void decode(const QString& path, audio_handle hdl);
 
+  DecodePriority priority() const noexcept { return m_priority; }
+  void setPriority(DecodePriority p) noexcept { m_priority = p; }
+
   static std::optional<std::pair<AudioInfo, audio_array>>
   decode_synchronous(const QString& path, int rate);
 
@@ -49,24 +63,19 @@ public:
   int32_t fileSampleRate{};
   int32_t convertedSampleRate{};
   int32_t channels{};
-  std::size_t decoded{};
+  std::atomic_size_t decoded{};
 
 public:
   void newData() W_SIGNAL(newData);
   void finishedDecoding(audio_handle hdl) W_SIGNAL(finishedDecoding, hdl);
 
-  void startDecode(QString str, audio_handle hdl)
-      W_SIGNAL(startDecode, str, hdl);
-
-public:
-  void on_startDecode(QString, audio_handle hdl);
-  W_SLOT(on_startDecode);
-
 private:
+  friend class DecodeScheduler;
+  void on_startDecode(QString, audio_handle hdl);
   static double read_length(const QString& path);
 
-  QThread* m_baseThread{};
-  QThread m_decodeThread;
+  std::atomic<DecodePriority> m_priority{DecodePriority::Background};
+  std::atomic_bool m_cancelled{};
 
   template <typename Decoder>
   void decodeFrame(Decoder dec, audio_array& data, AVFrame& frame);
@@ -0,0 +1,300 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__) && __has_include(<immintrin.h>)
+#include <immintrin.h>
+#define SCORE_MEDIA_KERNELS_AVX2 1
+#elif (defined(__SSE2__) || defined(_M_X64)) && __has_include(<emmintrin.h>)
+#include <emmintrin.h>
+#define SCORE_MEDIA_KERNELS_SSE2 1
+#elif defined(__ARM_NEON) && __has_include(<arm_neon.h>)
+#include <arm_neon.h>
+#define SCORE_MEDIA_KERNELS_NEON 1
+#endif
+
+/**
+ * Reductions over blocks of audio samples, used to summarize audio files
+ * for waveform display.
+ *
+ * The instruction set is chosen at compile time (AVX2, SSE2 or NEON);
+ * the remainders of the blocks, and the builds without any of those,
+ * use the scalar versions.
+ */
+namespace Media::kernels
+{
+struct MinMax
+{
+  float min{};
+  float max{};
+};
+
+//! The sample with the largest magnitude, with its sign
+inline float abs_max(MinMax mm) noexcept
+{
+  return mm.max >= -mm.min ? mm.max : mm.min;
+}
+
+//! The largest magnitude
+inline float peak(MinMax mm) noexcept
+{
+  return std::max(mm.max, -mm.min);
+}
+
+namespace scalar
+{
+template <typename T>
+inline MinMax reduce(const T* in, int64_t n) noexcept
+{
+  if (n <= 0)
+    return {};
+
+  float min = in[0], max = in[0];
+  for (int64_t i = 0; i < n; i++)
+  {
+    const float v = in[i];
+    min = std::min(min, v);
+    max = std::max(max, v);
+  }
+  return {min, max};
+}
+
+inline void reduce_interleaved(
+    const float* in,
+    int64_t frames,
+    int channels,
+    MinMax* out) noexcept
+{
+  for (int c = 0; c < channels; c++)
+    out[c] = frames > 0 ? MinMax{in[c], in[c]} : MinMax{};
+
+  for (int64_t i = 0; i < frames; i++)
+  {
+    const float* frame = in + i * channels;
+    for (int c = 0; c < channels; c++)
+    {
+      const float v = frame[c];
+      out[c].min = std::min(out[c].min, v);
+      out[c].max = std::max(out[c].max, v);
+    }
+  }
+}
+}
+
+namespace detail
+{
+#if defined(SCORE_MEDIA_KERNELS_AVX2)
+struct simd_f32
+{
+  using value_type = float;
+  using reg = __m256;
+  static constexpr int width = 8;
+  static reg load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+  static void store(float* p, reg v) noexcept { _mm256_storeu_ps(p, v); }
+  static reg min(reg a, reg b) noexcept { return _mm256_min_ps(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm256_max_ps(a, b); }
+};
+
+struct simd_f64
+{
+  using value_type = double;
+  using reg = __m256d;
+  static constexpr int width = 4;
+  static reg load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+  static void store(double* p, reg v) noexcept { _mm256_storeu_pd(p, v); }
+  static reg min(reg a, reg b) noexcept { return _mm256_min_pd(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm256_max_pd(a, b); }
+};
+#elif defined(SCORE_MEDIA_KERNELS_SSE2)
+struct simd_f32
+{
+  using value_type = float;
+  using reg = __m128;
+  static constexpr int width = 4;
+  static reg load(const float* p) noexcept { return _mm_loadu_ps(p); }
+  static void store(float* p, reg v) noexcept { _mm_storeu_ps(p, v); }
+  static reg min(reg a, reg b) noexcept { return _mm_min_ps(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm_max_ps(a, b); }
+};
+
+struct simd_f64
+{
+  using value_type = double;
+  using reg = __m128d;
+  static constexpr int width = 2;
+  static reg load(const double* p) noexcept { return _mm_loadu_pd(p); }
+  static void store(double* p, reg v) noexcept { _mm_storeu_pd(p, v); }
+  static reg min(reg a, reg b) noexcept { return _mm_min_pd(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm_max_pd(a, b); }
+};
+#elif defined(SCORE_MEDIA_KERNELS_NEON)
+struct simd_f32
+{
+  using value_type = float;
+  using reg = float32x4_t;
+  static constexpr int width = 4;
+  static reg load(const float* p) noexcept { return vld1q_f32(p); }
+  static void store(float* p, reg v) noexcept { vst1q_f32(p, v); }
+  static reg min(reg a, reg b) noexcept { return vminq_f32(a, b); }
+  static reg max(reg a, reg b) noexcept { return vmaxq_f32(a, b); }
+};
+
+#if defined(__aarch64__)
+struct simd_f64
+{
+  using value_type = double;
+  using reg = float64x2_t;
+  static constexpr int width = 2;
+  static reg load(const double* p) noexcept { return vld1q_f64(p); }
+  static void store(double* p, reg v) noexcept { vst1q_f64(p, v); }
+  static reg min(reg a, reg b) noexcept { return vminq_f64(a, b); }
+  static reg max(reg a, reg b) noexcept { return vmaxq_f64(a, b); }
+};
+#else
+using simd_f64 = void;
+#endif
+#else
+using simd_f32 = void;
+using simd_f64 = void;
+#endif
+
+template <typename V>
+inline MinMax reduce(const typename V::value_type* in, int64_t n) noexcept
+{
+  using T = typename V::value_type;
+  constexpr int W = V::width;
+  if (n < W)
+    return scalar::reduce(in, n);
+
+  // Two sets of accumulators to not be bound by the latency of min / max
+  auto min0 = V::load(in), max0 = min0, min1 = min0, max1 = min0;
+
+  int64_t i = 0;
+  for (; i + 2 * W <= n; i += 2 * W)
+  {
+    const auto a = V::load(in + i);
+    const auto b = V::load(in + i + W);
+    min0 = V::min(min0, a);
+    max0 = V::max(max0, a);
+    min1 = V::min(min1, b);
+    max1 = V::max(max1, b);
+  }
+  for (; i + W <= n; i += W)
+  {
+    const auto a = V::load(in + i);
+    min0 = V::min(min0, a);
+    max0 = V::max(max0, a);
+  }
+
+  T lo[W], hi[W];
+  V::store(lo, V::min(min0, min1));
+  V::store(hi, V::max(max0, max1));
+
+  T min = lo[0], max = hi[0];
+  for (int k = 0; k < W; k++)
+  {
+    min = std::min(min, lo[k]);
+    max = std::max(max, hi[k]);
+  }
+
+  for (; i < n; i++)
+  {
+    const T v = in[i];
+    min = std::min(min, v);
+    max = std::max(max, v);
+  }
+  return {float(min), float(max)};
+}
+
+// When the channel count divides the vector width, lane k of every
+// register always holds channel k % channels.
+template <typename V>
+inline void reduce_interleaved(
+    const float* in,
+    int64_t frames,
+    int channels,
+    MinMax* out) noexcept
+{
+  constexpr int W = V::width;
+  const int64_t n = frames * channels;
+  if (n < W || W % channels != 0)
+    return scalar::reduce_interleaved(in, frames, channels, out);
+
+  auto min = V::load(in), max = min;
+  int64_t i = 0;
+  for (; i + W <= n; i += W)
+  {
+    const auto a = V::load(in + i);
+    min = V::min(min, a);
+    max = V::max(max, a);
+  }
+
+  float lo[W], hi[W];
+  V::store(lo, min);
+  V::store(hi, max);
+
+  for (int c = 0; c < channels; c++)
+    out[c] = {lo[c], hi[c]};
+  for (int k = 0; k < W; k++)
+  {
+    auto& o = out[k % channels];
+    o.min = std::min(o.min, lo[k]);
+    o.max = std::max(o.max, hi[k]);
+  }
+
+  // i is a multiple of W, thus of channels: the tail starts on a frame
+  for (; i < n; i += channels)
+  {
+    for (int c = 0; c < channels; c++)
+    {
+      const float v = in[i + c];
+      out[c].min = std::min(out[c].min, v);
+      out[c].max = std::max(out[c].max, v);
+    }
+  }
+}
+
+template <typename T>
+inline MinMax reduce_dispatch(const T* in, int64_t n) noexcept
+{
+  using V = std::conditional_t<std::is_same_v<T, float>, simd_f32, simd_f64>;
+  if constexpr (std::is_void_v<V>)
+    return scalar::reduce(in, n);
+  else
+    return reduce<V>(in, n);
+}
+
+inline void reduce_interleaved_dispatch(
+    const float* in,
+    int64_t frames,
+    int channels,
+    MinMax* out) noexcept
+{
+  if constexpr (std::is_void_v<simd_f32>)
+    scalar::reduce_interleaved(in, frames, channels, out);
+  else
+    reduce_interleaved<simd_f32>(in, frames, channels, out);
+}
+}
+
+//! Min and max of a block of samples
+inline MinMax minmax(const float* in, int64_t n) noexcept
+{
+  return detail::reduce_dispatch(in, n);
+}
+inline MinMax minmax(const double* in, int64_t n) noexcept
+{
+  return detail::reduce_dispatch(in, n);
+}
+
+//! Min and max of each channel of a block of interleaved frames
+inline void minmax_interleaved(
+    const float* in,
+    int64_t frames,
+    int channels,
+    MinMax* out) noexcept
+{
+  detail::reduce_interleaved_dispatch(in, frames, channels, out);
+}
+}
@@ -0,0 +1,100 @@
+#include "DecodeScheduler.hpp"
+
+#include <Media/AudioDecoder.hpp>
+
+#include <ossia/detail/algorithms.hpp>
+
+#include <QThread>
+
+#include <algorithm>
+
+namespace Media
+{
+DecodeScheduler& DecodeScheduler::instance()
+{
+  static DecodeScheduler self;
+  return self;
+}
+
+DecodeScheduler::DecodeScheduler()
+{
+  // More threads do not help: they just fight over the disk
+  const int threads = std::clamp(QThread::idealThreadCount() / 2, 1, 4);
+  for (int i = 0; i < threads; i++)
+    m_threads.emplace_back([this] { run(); });
+}
+
+DecodeScheduler::~DecodeScheduler()
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_stop = true;
+    m_pending.clear();
+    for (auto dec : m_running)
+      dec->m_cancelled = true;
+  }
+  m_queued.notify_all();
+
+  for (auto& t : m_threads)
+    t.join();
+}
+
+void DecodeScheduler::enqueue(
+    AudioDecoder& dec,
+    const QString& path,
+    audio_handle hdl)
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_pending.push_back({&dec, path, std::move(hdl), m_order++});
+  }
+  m_queued.notify_one();
+}
+
+void DecodeScheduler::cancel(AudioDecoder& dec)
+{
+  std::unique_lock lock{m_mutex};
+  ossia::remove_erase_if(
+      m_pending, [&](const Job& job) { return job.decoder == &dec; });
+
+  if (ossia::contains(m_running, &dec))
+  {
+    dec.m_cancelled = true;
+    m_finished.wait(lock, [&] { return !ossia::contains(m_running, &dec); });
+  }
+}
+
+void DecodeScheduler::run()
+{
+  std::unique_lock lock{m_mutex};
+  for (;;)
+  {
+    m_queued.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+    if (m_stop)
+      return;
+
+    // Highest priority first, then oldest first
+    auto it = std::min_element(
+        m_pending.begin(),
+        m_pending.end(),
+        [](const Job& lhs, const Job& rhs) {
+          const auto lp = lhs.decoder->priority();
+          const auto rp = rhs.decoder->priority();
+          if (lp != rp)
+            return lp > rp;
+          return lhs.order < rhs.order;
+        });
+
+    Job job = std::move(*it);
+    m_pending.erase(it);
+    m_running.push_back(job.decoder);
+
+    lock.unlock();
+    job.decoder->on_startDecode(job.path, std::move(job.handle));
+    lock.lock();
+
+    ossia::remove_erase(m_running, job.decoder);
+    m_finished.notify_all();
+  }
+}
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <Media/AudioArray.hpp>
+
+#include <ossia/detail/small_vector.hpp>
+
+#include <QString>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Media
+{
+class AudioDecoder;
+
+/**
+ * @brief Runs the decoding of the audio files on a few shared threads.
+ *
+ * Decoding is bound by the disk and the CPU: when many files are loaded at
+ * once, e.g. when dropping a folder in a scenario, they are queued
+ * instead of all being decoded at the same time.
+ *
+ * The waiting decoders are started by order of AudioDecoder::priority(),
+ * then by order of submission. The priority can be changed while waiting.
+ */
+class DecodeScheduler
+{
+public:
+  static DecodeScheduler& instance();
+  ~DecodeScheduler();
+
+  void enqueue(AudioDecoder& dec, const QString& path, audio_handle hdl);
+
+  //! Removes the decoder from the queue. If it is being decoded, it is
+  //! stopped, and this function waits until it does not use it anymore.
+  void cancel(AudioDecoder& dec);
+
+private:
+  DecodeScheduler();
+  void run();
+
+  struct Job
+  {
+    AudioDecoder* decoder{};
+    QString path;
+    audio_handle handle;
+    uint64_t order{};
+  };
+
+  std::mutex m_mutex;
+  std::condition_variable m_queued;
+  std::condition_variable m_finished;
+  std::vector<Job> m_pending;
+  ossia::small_vector<AudioDecoder*, 8> m_running;
+  uint64_t m_order{};
+  bool m_stop{};
+
+  std::vector<std::thread> m_threads;
+};
+}
@@ -1,13 +1,16 @@
 #include "MediaFileHandle.hpp"
 
 #include <Media/AudioDecoder.hpp>
+#include <Media/AudioKernels.hpp>
 #include <Media/RMSData.hpp>
 
 #include <score/document/DocumentContext.hpp>
 #include <score/serialization/DataStreamVisitor.hpp>
 #include <score/serialization/JSONVisitor.hpp>
 #include <score/tools/Bind.hpp>
+#include <score/tools/CacheFolder.hpp>
 #include <score/tools/File.hpp>
+#include <score/tools/ThreadPool.hpp>
 
 #include <core/document/Document.hpp>
 
@@ -19,13 +22,23 @@
 
 #include <Audio/Settings/Model.hpp>
 
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <QDebug>
+#include <QDir>
 #include <QFileInfo>
+#include <QPointer>
+#include <QStandardPaths>
 #include <QStorageInfo>
+#include <QThreadPool>
 
 #define DR_WAV_NO_STDIO
 #include <dr_wav.h>
 
+#include <algorithm>
+#include <functional>
+
 namespace Media
 {
 
@@ -56,6 +69,55 @@ static int64_t readSampleRate(QFile& file)
   return sr;
 }
 
+static float readAcidTempo(const QString& path)
+{
+  if (!path.endsWith("wav", Qt::CaseInsensitive))
+    return 0.f;
+
+  QFile f{path};
+  if (!f.open(QIODevice::ReadOnly))
+    return 0.f;
+
+  auto data = f.map(0, f.size());
+  if (!data)
+    return 0.f;
+
+  ossia::drwav_handle h;
+  h.open_memory(data, f.size());
+  return h.acid().tempo;
+}
+
+// Files decoded with libav are stored as 32-bit float .wav files, at the
+// rate they were converted to, so that they can be memory-mapped
+// the next time instead of being decoded again.
+static constexpr qint64 decoded_cache_max_size = 4LL * 1024 * 1024 * 1024;
+
+static QString decodedCacheFolder()
+{
+  const auto cache = QStandardPaths::standardLocations(
+      QStandardPaths::StandardLocation::CacheLocation);
+  if (cache.empty())
+    return {};
+  return cache.first() + "/decoded";
+}
+
+static QString decodedCachePath(const QString& abspath, int rate)
+{
+  const auto folder = decodedCacheFolder();
+  if (folder.isEmpty())
+    return {};
+
+  const QFileInfo info{abspath};
+  QCryptographicHash h{QCryptographicHash::Sha1};
+  h.addData(abspath.toUtf8());
+  h.addData(QByteArray::number(info.size()));
+  h.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+  h.addData(QByteArray::number(rate));
+
+  return folder + "/"
+         + h.result().toBase64(QByteArray::Base64UrlEncoding) + ".wav";
+}
+
 // TODO if it's smaller than e.g. 1 megabyte, it would be worth
 // loading it in memory entirely..
 // TODO might make sense to do resampling during execution if it's nott too
@@ -93,6 +155,7 @@ void AudioFile::load(const QString& path, const QString& abspath)
 {
   m_originalFile = path;
   m_file = abspath;
+  m_decodeCache = true;
 
   const auto& audioSettings
       = score::GUIAppContext().settings<Audio::Settings::Model>();
@@ -101,10 +164,14 @@ void AudioFile::load(const QString& path, const QString& abspath)
   switch (needsDecoding(m_file, rate))
   {
     case DecodingMethod::Libav:
-      load_ffmpeg(rate);
+      load_libav(rate);
       break;
     case DecodingMethod::Mmap:
-      load_drwav();
+      if (!load_drwav(m_file))
+      {
+        m_impl = Handle{};
+        on_mediaChanged();
+      }
       break;
     default:
       break;
@@ -118,6 +185,7 @@ void AudioFile::load(
 {
   m_originalFile = path;
   m_file = abspath;
+  m_decodeCache = false;
 
   const auto& audioSettings
       = score::GUIAppContext().settings<Audio::Settings::Model>();
@@ -129,7 +197,11 @@ void AudioFile::load(
       load_ffmpeg(rate);
       break;
     case DecodingMethod::Mmap:
-      load_drwav();
+      if (!load_drwav(m_file))
+      {
+        m_impl = Handle{};
+        on_mediaChanged();
+      }
       break;
     default:
       break;
@@ -213,16 +285,30 @@ void AudioFile::updateSampleRate(int rate)
   switch (needsDecoding(m_file, rate))
   {
     case DecodingMethod::Libav:
-      load_ffmpeg(rate);
+      load_libav(rate);
       break;
     case DecodingMethod::Mmap:
-      load_drwav();
+      if (!load_drwav(m_file))
+      {
+        m_impl = Handle{};
+        on_mediaChanged();
+      }
       break;
     default:
       break;
   }
 }
 
+void AudioFile::prioritizeDecoding(DecodePriority p)
+{
+  if (p <= m_decodePriority)
+    return;
+
+  m_decodePriority = p;
+  if (auto r = m_impl.target<libav_ptr>(); r && *r)
+    (*r)->decoder.setPriority(p);
+}
+
 template <typename Fun_T, typename T>
 struct FrameComputer
 {
@@ -242,9 +328,8 @@ struct FrameComputer
       for (int c = 0; c < channels; c++)
       {
         const auto& vals = r.data[c];
-        sum[c] = fun.init(vals[start_frame]);
-        for (int64_t i = start_frame + 1; i < end_frame; i++)
-          sum[c] = fun(sum[c], (float)vals[i]);
+        sum[c] = fun.result(
+            kernels::minmax(vals + start_frame, end_frame - start_frame));
       }
     }
     else if (end_frame == start_frame)
@@ -287,18 +372,11 @@ struct FrameComputer
       if (Q_UNLIKELY(max == 0))
         return;
 
+      ossia::small_vector<kernels::MinMax, 8> stats(channels);
+      kernels::minmax_interleaved(floats, max, channels, stats.data());
       for (int c = 0; c < channels; c++)
       {
-        sum[c] = fun.init(floats[c]);
-      }
-
-      for (decltype(max) i = 1; i < max; i++)
-      {
-        for (int c = 0; c < channels; c++)
-        {
-          const float f = floats[i * channels + c];
-          sum[c] = fun(sum[c], f);
-        }
+        sum[c] = fun.result(stats[c]);
       }
     }
     else
@@ -373,9 +451,9 @@ void AudioFile::ViewHandle::absmax_frame(
   struct AbsMax
   {
     static float init(float v) noexcept { return v; }
-    float operator()(float f1, float f2) const noexcept
+    static float result(kernels::MinMax mm) noexcept
     {
-      return abs_max(f1, f2);
+      return kernels::abs_max(mm);
     }
   };
   FrameComputer<AbsMax, float> _{start_frame, end_frame, out, {}};
@@ -390,9 +468,9 @@ void AudioFile::ViewHandle::minmax_frame(
   struct MinMax
   {
     static std::pair<float, float> init(float v) noexcept { return {v, v}; }
-    auto operator()(std::pair<float, float> f1, float f2) const noexcept
+    static std::pair<float, float> result(kernels::MinMax mm) noexcept
     {
-      return std::make_pair(std::min(f1.first, f2), std::max(f1.second, f2));
+      return {mm.min, mm.max};
     }
   };
 
@@ -401,6 +479,68 @@ void AudioFile::ViewHandle::minmax_frame(
   ossia::apply(_, *this);
 }
 
+void AudioFile::load_libav(int rate)
+{
+  if (m_decodeCache && load_cached(rate))
+    return;
+  load_ffmpeg(rate);
+}
+
+bool AudioFile::load_cached(int rate)
+{
+  const auto path = decodedCachePath(m_file, rate);
+  if (path.isEmpty() || !QFile::exists(path))
+    return false;
+
+  if (!load_drwav(path))
+  {
+    QFile::remove(path);
+    return false;
+  }
+
+  // Used for eviction
+  score::touchCacheFile(path);
+  return true;
+}
+
+void AudioFile::storeDecoded(const libav_ptr& reader)
+{
+  const auto path = decodedCachePath(m_file, m_sampleRate);
+  if (path.isEmpty() || !QDir{}.mkpath(decodedCacheFolder()))
+    return;
+
+  // Written in the background, then the file is reloaded from the cache
+  // so that it streams from the disk instead of staying in memory.
+  score::startOnPool(
+      *QThreadPool::globalInstance(),
+      [self = QPointer<AudioFile>{this},
+       handle = reader->handle,
+       path,
+       rate = m_sampleRate] {
+        if (!score::writeCacheFile(path, [&](const QString& tmp_path) {
+              return writeAudioArrayToFile(tmp_path, handle->data, rate);
+            }))
+          return;
+
+        auto app = QCoreApplication::instance();
+        if (!app)
+          return;
+
+        QMetaObject::invokeMethod(
+            app,
+            [self, handle, rate] {
+              if (!self || self->m_sampleRate != rate)
+                return;
+
+              // The file may have been reloaded in the meantime
+              auto current = self->m_impl.target<libav_ptr>();
+              if (current && *current && (*current)->handle == handle)
+                self->load_cached(rate);
+            },
+            Qt::QueuedConnection);
+      });
+}
+
 void AudioFile::load_ffmpeg(int rate)
 {
   qDebug() << "AudioFileHandle::load_ffmpeg(): " << m_file << rate;
@@ -434,7 +574,7 @@ void AudioFile::load_ffmpeg(int rate)
                 = *eggs::variants::get<std::shared_ptr<LibavReader>>(m_impl);
             std::vector<gsl::span<const audio_sample>> samples;
             auto& handle = r.handle->data;
-            const auto decoded = r.decoder.decoded;
+            const auto decoded = r.decoder.decoded.load();
 
             for (auto& channel : handle)
             {
@@ -457,7 +597,7 @@ void AudioFile::load_ffmpeg(int rate)
                 = *eggs::variants::get<std::shared_ptr<LibavReader>>(m_impl);
             std::vector<gsl::span<const audio_sample>> samples;
             auto& handle = r.handle->data;
-            auto decoded = r.decoder.decoded;
+            auto decoded = r.decoder.decoded.load();
 
             for (auto& channel : handle)
             {
@@ -468,29 +608,22 @@ void AudioFile::load_ffmpeg(int rate)
             m_rms->decodeLast(samples);
 
             on_finishedDecoding();
+
+            if (m_decodeCache)
+              storeDecoded(
+                  eggs::variants::get<std::shared_ptr<LibavReader>>(m_impl));
           },
           Qt::QueuedConnection);
     }
 
+    r.decoder.setPriority(m_decodePriority);
     r.decoder.decode(m_file, r.handle);
 
     m_sampleRate = rate;
 
+    // Do a quick pass if it'as a wav file to check for ACID tags
     QFileInfo fi{f};
-    if (fi.completeSuffix() == "wav")
-    {
-      // Do a quick pass if it'as a wav file to check for ACID tags
-      if (f.open(QIODevice::ReadOnly))
-      {
-        if (auto data = f.map(0, f.size()))
-        {
-          ossia::drwav_handle h;
-          h.open_memory(data, f.size());
-
-          ptr->tempo = h.acid().tempo;
-        }
-      }
-    }
+    ptr->tempo = readAcidTempo(m_file);
 
     // Assign pointers to the audio data
     r.data.resize(r.handle->data.size());
@@ -508,39 +641,30 @@ void AudioFile::load_ffmpeg(int rate)
   on_mediaChanged();
 }
 
-void AudioFile::load_drwav()
+bool AudioFile::load_drwav(const QString& data_path)
 {
-  qDebug() << "AudioFileHandle::load_drwav(): " << m_file;
+  qDebug() << "AudioFileHandle::load_drwav(): " << m_file << data_path;
 
   // Loading with drwav is done when the file can be
-  // mmapped directly in to memory.
-
+  // mmapped directly in to memory: either the file itself, or
+  // a copy of it in the decoded cache.
   MmapReader r;
   r.file = std::make_shared<QFile>();
-  r.file->setFileName(m_file);
+  r.file->setFileName(data_path);
 
   bool ok = r.file->open(QIODevice::ReadOnly);
-  if (!ok)
+  if (ok)
+    r.data = r.file->map(0, r.file->size());
+  if (r.data)
+    r.wav.open_memory(r.data, r.file->size());
+  if (!r.data || !r.wav || r.wav.channels() == 0 || r.wav.sampleRate() == 0)
   {
-    qDebug() << "Cannot open file" << m_file;
-    m_impl = Handle{};
-    on_mediaChanged();
+    qDebug() << "Cannot open file" << data_path;
+    return false;
   }
 
-  r.data = r.file->map(0, r.file->size());
-  if (!r.data)
-  {
-    qDebug() << "Cannot open file" << m_file;
-    m_impl = Handle{};
-    on_mediaChanged();
-  }
-  r.wav.open_memory(r.data, r.file->size());
-  if (!r.wav || r.wav.channels() == 0 || r.wav.sampleRate() == 0)
-  {
-    qDebug() << "Cannot open file" << m_file;
-    m_impl = Handle{};
-    on_mediaChanged();
-  }
+  if (data_path != m_file)
+    r.tempo = readAcidTempo(m_file);
 
   m_rms->load(
       m_file,
@@ -551,11 +675,10 @@ void AudioFile::load_drwav()
 
   if (!m_rms->exists())
   {
-    m_rms->decode(r.wav);
+    m_rms->decode(r);
   }
 
-  QFileInfo fi{*r.file};
-  m_fileName = fi.fileName();
+  m_fileName = QFileInfo{m_file}.fileName();
   m_sampleRate = r.wav.sampleRate();
 
   m_impl = std::move(r);
@@ -563,10 +686,15 @@ void AudioFile::load_drwav()
   on_finishedDecoding();
   on_mediaChanged();
   qDebug() << "AudioFileHandle::on_mediaChanged(): " << m_file;
+  return true;
 }
 
 AudioFileManager::AudioFileManager() noexcept
 {
+  score::evictCacheFolder(
+      decodedCacheFolder(), {"*.wav"}, decoded_cache_max_size);
+  RMSData::evictCache();
+
   auto& audioSettings
       = score::GUIAppContext().settings<Audio::Settings::Model>();
   con(audioSettings,
@@ -603,6 +731,17 @@ AudioFileManager::get(const QString& path, const score::DocumentContext& ctx)
   return r;
 }
 
+void AudioFileManager::release(std::shared_ptr<AudioFile>& file)
+{
+  if (!file)
+    return;
+
+  auto it = m_handles.find(file->absoluteFileName());
+  if (it != m_handles.end() && it->second == file && file.use_count() == 2)
+    m_handles.erase(it);
+  file.reset();
+}
+
 AudioFile::ViewHandle::ViewHandle(const AudioFile::Handle& handle)
 {
   struct
@@ -670,19 +809,19 @@ ossia::audio_array AudioFile::getAudioArray() const
   return vis.out;
 }
 
-void writeAudioArrayToFile(const QString& path, const ossia::audio_array& arr, int fs)
+bool writeAudioArrayToFile(const QString& path, const ossia::audio_array& arr, int fs)
 {
   if(arr.empty())
   {
     qDebug() << "Not writing" << path << ": no data to write.";
-    return;
+    return false;
   }
 
   QFile f{path};
   if(!f.open(QIODevice::WriteOnly))
   {
     qDebug() << "Not writing" << path << ": cannot open file for writing.";
-    return;
+    return false;
   }
 
   const int channels = arr.size();
@@ -696,7 +835,7 @@ void writeAudioArrayToFile(const QString& path, const ossia::audio_array& arr, i
   if(QStorageInfo(path).bytesAvailable() < minimum_disk_space)
   {
     qDebug() << "Not writing" << path << ": not enough disk space.";
-    return;
+    return false;
   }
 
   drwav_data_format format;
@@ -716,7 +855,7 @@ void writeAudioArrayToFile(const QString& path, const ossia::audio_array& arr, i
   if(!drwav_init_write_sequential(&wav, &format, samples, onWrite, &f, &ossia::drwav_handle::drwav_allocs))
   {
     qDebug() << "Not writing" << path << ": could not initialize writer.";
-    return;
+    return false;
   }
 
   auto buffer = std::make_unique<float[]>(samples);
@@ -728,9 +867,10 @@ void writeAudioArrayToFile(const QString& path, const ossia::audio_array& arr, i
     }
   }
 
-  drwav_write_pcm_frames(&wav, frames, buffer.get());
+  const auto written = drwav_write_pcm_frames(&wav, frames, buffer.get());
   drwav_uninit(&wav);
   f.flush();
+  return int64_t(written) == frames && f.error() == QFile::NoError;
 }
 
 }
@@ -24,21 +24,6 @@ namespace Media
 {
 struct RMSData;
 class SoundComponentSetup;
-#if defined(__clang__)
-static constexpr inline float abs_max(float f1, float f2) noexcept
-{
-  const int mul = (f2 >= 0.f) ? 1 : -1;
-  if (f1 < mul * f2)
-    return f2;
-  else
-    return f1;
-}
-#else
-static constexpr inline float abs_max(float f1, float f2) noexcept
-{
-  return f2 >= 0.f ? f1 < f2 ? f2 : f1 : f1 < -f2 ? f2 : f1;
-}
-#endif
 
 enum class DecodingMethod
 {
@@ -55,7 +40,9 @@ public:
   AudioFile();
   ~AudioFile() override;
 
+  //! Files which need decoding are read from the decoded cache if possible
   void load(const QString&, const QString&);
+  //! Forces a decoding method, without going through the cache
   void load(const QString&, const QString&, DecodingMethod d);
 
   //! The text passed to the load function
@@ -88,11 +75,17 @@ public:
 
   void updateSampleRate(int);
 
+  //! Files which are not decoded yet are decoded by order of priority.
+  //! The priority can only be raised.
+  void prioritizeDecoding(DecodePriority p);
+
   struct MmapReader
   {
     std::shared_ptr<QFile> file;
     void* data{};
     ossia::drwav_handle wav;
+    //! ACID tempo of the original file, when reading a decoded copy of it
+    float tempo{};
   };
 
   struct LibavReader
@@ -169,8 +162,11 @@ public:
   const Handle& unsafe_handle() const noexcept { return m_impl; }
 
 private:
+  void load_libav(int rate);
   void load_ffmpeg(int rate);
-  void load_drwav();
+  bool load_drwav(const QString& data_path);
+  bool load_cached(int rate);
+  void storeDecoded(const libav_ptr& reader);
 
   friend class SoundComponentSetup;
 
@@ -180,6 +176,8 @@ private:
 
   RMSData* m_rms{};
   int m_sampleRate{};
+  DecodePriority m_decodePriority{DecodePriority::Background};
+  bool m_decodeCache{};
 
   Handle m_impl;
 };
@@ -194,6 +192,10 @@ public:
   std::shared_ptr<AudioFile>
   get(const QString&, const score::DocumentContext&);
 
+  //! To call when a process stops using a file.
+  //! If nothing else uses it, it is unloaded, which stops its decoding.
+  void release(std::shared_ptr<AudioFile>& file);
+
 private:
   ossia::fast_hash_map<QString, std::shared_ptr<AudioFile>> m_handles;
 };
@@ -202,7 +204,7 @@ private:
  * @brief Saves an audio file as .wav (in 32-bit float format)
  */
 SCORE_PLUGIN_MEDIA_EXPORT
-void writeAudioArrayToFile(const QString& path, const ossia::audio_array& arr, int fs);
+bool writeAudioArrayToFile(const QString& path, const ossia::audio_array& arr, int fs);
 }
 
 Q_DECLARE_METATYPE(std::shared_ptr<Media::AudioFile>)
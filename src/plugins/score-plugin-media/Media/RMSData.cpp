@@ -5,78 +5,214 @@
 #undef DR_WAV_IMPLEMENTATION
 #include "RMSData.hpp"
 
+#include <Media/AudioKernels.hpp>
 #include <Media/MediaFileHandle.hpp>
 #include <Media/RMSData.hpp>
 
+#include <score/tools/CacheFolder.hpp>
+#include <score/tools/ThreadPool.hpp>
+
 #include <ossia/detail/math.hpp>
 
+#include <QCoreApplication>
 #include <QCryptographicHash>
+#include <QDateTime>
 #include <QDir>
+#include <QFileInfo>
 #include <QStandardPaths>
+#include <QThread>
+#include <QThreadPool>
+
+#include <cstring>
 
 #include <wobjectimpl.h>
 W_OBJECT_IMPL(Media::RMSData)
 namespace Media
 {
-static const constexpr auto rms_buffer_size = 64;
-RMSData::RMSData() { }
+namespace
+{
+// Bump when the format of the cache files changes
+static constexpr uint32_t rms_cache_magic = 0x534d5253; // SRMS
+static constexpr uint32_t rms_cache_version = 2;
 
-void RMSData::load(QString abspath, int channels, int rate, TimeVal duration)
-{/*
-  this->header = nullptr;
-  this->data = nullptr;
-  this->m_exists = false;
-  if (m_file.isOpen())
-    m_file.close();
+// Frames read at once for memory-mapped files; progress is reported
+// after each slice
+static constexpr int64_t rms_mmap_slice = 1 << 18;
+
+static constexpr float rms_scale = std::numeric_limits<rms_sample_t>::max();
+
+static rms_sample_t toSample(float v) noexcept
+{
+  return rms_sample_t(ossia::clamp(v, -1.f, 1.f) * rms_scale);
+}
+
+static constexpr qint64 waveform_cache_max_size = 1024LL * 1024 * 1024;
 
+static QString waveformCacheFolder()
+{
   const auto cache = QStandardPaths::standardLocations(
       QStandardPaths::StandardLocation::CacheLocation);
   if (cache.empty())
-    throw std::runtime_error("No cache folder");
+    return {};
+  return cache.first() + "/waveforms";
+}
+}
+
+void RMSData::evictCache()
+{
+  score::evictCacheFolder(
+      waveformCacheFolder(), {}, waveform_cache_max_size);
+}
+
+struct RMSData::Storage
+{
+  struct Accumulator
+  {
+    float min{};
+    float max{};
+  };
+
+  int channels{};
+  int sampleRate{};
+  int levels{};
 
-  QCryptographicHash h{QCryptographicHash::Sha1};
-  h.addData(abspath.toUtf8());
-  auto hash = h.result();
+  std::array<Sample*, maxLevels> data{};
+  std::array<int64_t, maxLevels> capacity{};
+  std::array<std::atomic_int64_t, maxLevels> counts{};
 
-  QDir::root().mkpath(cache.first());
-  QDir cache_dir{cache.first()};
-  cache_dir.mkdir("waveforms");
-  cache_dir.cd("waveforms");
+  // Either the levels are computed in this buffer...
+  std::unique_ptr<Sample[]> buffer;
 
-  m_file.setFileName(cache_dir.absoluteFilePath(
-      hash.toBase64(QByteArray::Base64UrlEncoding)));
+  // ... or they are mapped from the cache.
+  QFile file;
+  QString cachePath;
 
-  if (m_file.exists())
+  // State of the computation, only accessed by the thread computing it.
+  // Partial entries of each level, channels * maxLevels
+  std::vector<Accumulator> pending;
+  std::array<int, maxLevels> pendingCount{};
+  int64_t processedFrames{};
+
+  // Set when the RMSData does not need the levels anymore
+  std::atomic_bool cancelled{false};
+
+  static int64_t levelFrames(int level) noexcept
   {
-    m_file.open(QIODevice::ReadOnly);
-    m_exists = true;
+    int64_t frames = bufferSize;
+    for (int i = 0; i < level; i++)
+      frames *= factor;
+    return frames;
+  }
+
+  void pushBlock(const Accumulator* block, int level);
+  void finish();
+  void save() const;
+};
+
+namespace
+{
+// Shared by all the files being loaded, e.g. when importing a folder
+struct RMSPool final : QThreadPool
+{
+  RMSPool() { setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1)); }
+};
 
-    void* data = m_file.map(0, m_file.size());
-    assert(data);
-    this->header = reinterpret_cast<Header*>(data);
-    this->data
-        = reinterpret_cast<rms_sample_t*>(((char*)data) + sizeof(Header));
+static QThreadPool& rmsPool()
+{
+  static RMSPool pool;
+  return pool;
+}
+}
 
-    frames_count = (m_file.size() - sizeof(Header)) / sizeof(rms_sample_t);
-    samples_count = frames_count * header->channels;
+RMSData::RMSData() { }
+
+RMSData::~RMSData()
+{
+  if (m_storage)
+    m_storage->cancelled = true;
+}
+
+void RMSData::load(QString abspath, int channels, int rate, TimeVal duration)
+{
+  m_exists = false;
+
+  {
+    std::lock_guard lock{m_mutex};
+    if (m_storage)
+      m_storage->cancelled = true;
+    m_storage.reset();
   }
-  else
+
+  if (channels <= 0 || rate <= 0)
+    return;
+
+  // The levels depend on the file, and on the rate it is resampled to
+  QString cachePath;
+  if (const auto folder = waveformCacheFolder();
+      !folder.isEmpty() && QDir{}.mkpath(folder))
   {
-    m_ramData.reserve(
-        duration.msec() * 0.001 * rate * channels * sizeof(rms_sample_t)
-        + 1000);
-    m_ramBuffer.setBuffer(&m_ramData);
-    m_ramBuffer.open(QIODevice::ReadWrite);
-    Header h;
-    h.channels = channels;
-    h.sampleRate = rate;
-    h.bufferSize = rms_buffer_size;
-    m_ramBuffer.write((const char*)&h, sizeof(h));
-
-    this->header = reinterpret_cast<Header*>(m_ramData.data());
-    this->data = reinterpret_cast<rms_sample_t*>(
-        ((char*)m_ramData.data()) + sizeof(Header));
-  }*/
+    const QFileInfo info{abspath};
+    QCryptographicHash h{QCryptographicHash::Sha1};
+    h.addData(abspath.toUtf8());
+    h.addData(QByteArray::number(info.size()));
+    h.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    h.addData(QByteArray::number(rate));
+
+    cachePath = folder + "/"
+                + h.result().toBase64(QByteArray::Base64UrlEncoding);
+  }
+
+  auto st = std::make_shared<Storage>();
+  st->channels = channels;
+  st->sampleRate = rate;
+  st->cachePath = cachePath;
+
+  if (!cachePath.isEmpty())
+  {
+    {
+      std::lock_guard lock{m_mutex};
+      m_storage = st;
+    }
+
+    if (loadCache())
+    {
+      m_exists = true;
+      return;
+    }
+
+    st = std::make_shared<Storage>();
+    st->channels = channels;
+    st->sampleRate = rate;
+    st->cachePath = cachePath;
+  }
+
+  // The duration is an estimate for compressed files: leave some room
+  const int64_t max_frames = duration.msec() * 0.001 * rate * 1.05 + 8192;
+
+  int64_t total = 0;
+  int64_t capacity = max_frames / bufferSize + 2;
+  for (int level = 0; level < maxLevels; level++)
+  {
+    if (level > 0 && Storage::levelFrames(level) > max_frames)
+      break;
+
+    st->capacity[level] = capacity;
+    st->levels = level + 1;
+    total += capacity;
+    capacity = capacity / factor + 2;
+  }
+
+  st->buffer = std::make_unique<Sample[]>(total * channels);
+  Sample* ptr = st->buffer.get();
+  for (int level = 0; level < st->levels; level++)
+  {
+    st->data[level] = ptr;
+    ptr += st->capacity[level] * channels;
+  }
+  st->pending.resize(channels * maxLevels);
+
+  std::lock_guard lock{m_mutex};
+  m_storage = std::move(st);
 }
 
 bool RMSData::exists() const
@@ -87,226 +223,375 @@ bool RMSData::exists() const
 void RMSData::decode(
     const std::vector<gsl::span<const ossia::audio_sample>>& audio)
 {
-  computeRMS(audio, rms_buffer_size);
+  if (!m_exists)
+    computeBlocks(audio, false);
+  newData();
 }
 
 void RMSData::decodeLast(
     const std::vector<gsl::span<const ossia::audio_sample>>& audio)
 {
-  computeLastRMS(audio, rms_buffer_size);
-  /*
-  m_file.open(QIODevice::WriteOnly);
-  m_file.write(m_ramData);
-  m_file.flush();
-  m_file.close();*/
-  finishedDecoding();
-}
-
-void RMSData::decode(ossia::drwav_handle& audio)
-{/*
-  // store the data in interleaved format, it's much easier...
-  const int64_t channels = audio.channels();
-  if (channels > 0)
+  if (!m_exists && m_storage)
   {
-    const int64_t max_frames = audio.totalPCMFrameCount();
-    constexpr const auto buffer_size = rms_buffer_size;
-
-    const int64_t len = sizeof(rms_sample_t) * channels;
-    rms_sample_t* bytes = reinterpret_cast<rms_sample_t*>(alloca(len));
-
-    int64_t start_idx = 0;
-    while (start_idx < max_frames)
-    {
-      computeChannelRMS(audio, bytes, buffer_size);
-      m_ramBuffer.write(reinterpret_cast<const char*>(bytes), len);
-      start_idx += buffer_size;
-      frames_count++;
-      samples_count += channels;
-    }
+    computeBlocks(audio, true);
+    m_storage->finish();
+    m_storage->save();
   }
-*/
   newData();
-/*
-  m_file.open(QIODevice::WriteOnly);
-  m_file.write(m_ramData);
-  m_file.flush();
-  m_file.close();*/
   finishedDecoding();
 }
 
-double RMSData::sampleRateRatio(double expectedRate) const noexcept
+void RMSData::decode(const AudioFile::MmapReader& audio)
 {
-  return header->sampleRate / expectedRate;
+  if (m_exists || !m_storage)
+  {
+    newData();
+    finishedDecoding();
+    return;
+  }
+
+  // Done in the background so that many files can be processed
+  // at the same time without blocking the GUI
+  score::startOnPool(
+      rmsPool(),
+      [st = m_storage, audio, self = QPointer<RMSData>{this}]() mutable {
+        processFile(st, audio, self);
+      });
 }
 
-ossia::small_vector<float, 8>
-RMSData::frame(int64_t start_frame, int64_t end_frame) const noexcept
+void RMSData::notify(
+    const QPointer<RMSData>& self,
+    const std::shared_ptr<Storage>& st,
+    bool finished)
 {
-  ossia::small_vector<float, 8> sum;
-  sum.resize(header->channels);
+  auto app = QCoreApplication::instance();
+  if (!app)
+    return;
 
-  assert(start_frame >= 0);
-  assert(end_frame >= 0);
-  const auto channels = header->channels;
-  const auto start_idx = (start_frame / rms_buffer_size);
-  auto end_idx = (end_frame / rms_buffer_size);
+  QMetaObject::invokeMethod(
+      app,
+      [self, st, finished] {
+        // The file may have been reloaded in the meantime
+        if (!self || self->m_storage != st)
+          return;
+        self->newData();
+        if (finished)
+          self->finishedDecoding();
+      },
+      Qt::QueuedConnection);
+}
 
-  if (start_idx >= samples_count)
+void RMSData::processFile(
+    const std::shared_ptr<Storage>& ptr,
+    AudioFile::MmapReader& audio,
+    const QPointer<RMSData>& self)
+{
+  auto& st = *ptr;
+  auto& wav = audio.wav;
+  const int channels = st.channels;
+  const int64_t total = wav.totalPCMFrameCount();
+  if (!wav || channels != int(wav.channels()) || !wav.seek_to_pcm_frame(0))
   {
-    // qDebug() << "bug on start! " << start_idx << samples_count;
-    return sum;
+    notify(self, ptr, true);
+    return;
   }
 
-  if (end_idx > samples_count)
+  std::vector<float> floats;
+  ossia::small_vector<kernels::MinMax, 8> stats(channels);
+  ossia::small_vector<Storage::Accumulator, 8> block(channels);
+
+  while (st.processedFrames < total)
   {
-    // qDebug() << "bug on end! " << end_idx << samples_count;
-    end_idx = samples_count;
-  }
+    if (st.cancelled)
+      return;
 
-  rms_sample_t* begin = (data + start_idx);
-  rms_sample_t* end = (data + end_idx);
+    const int64_t frames
+        = std::min(rms_mmap_slice, total - st.processedFrames);
+    floats.resize(frames * channels);
 
-  constexpr float size_factor = 1. / std::numeric_limits<rms_sample_t>::max();
-  if (begin == end && start_frame < end_frame)
-  {
-    // Note: we should not enter this case -
-    // instead AudioFileHandle::frame would be used
-    for (std::size_t k = 0; k < channels; k++)
-      sum[k] = begin[k] * size_factor;
-    return sum;
-  }
+    const int64_t read = wav.read_pcm_frames_f32(frames, floats.data());
+    if (read <= 0)
+      break;
 
-  for (; begin < end; begin += channels)
-  {
-    for (std::size_t k = 0; k < channels; k++)
+    int64_t i = 0;
+    while (i < read)
     {
-      const int64_t val = begin[k];
-      sum[k] = abs_max(sum[k], val);
+      const int64_t n = std::min(int64_t(bufferSize), read - i);
+
+      // A partial block is only processed at the end of the file
+      if (n < bufferSize && st.processedFrames + i + n < total)
+        break;
+
+      kernels::minmax_interleaved(
+          floats.data() + i * channels, n, channels, stats.data());
+      for (int c = 0; c < channels; c++)
+        block[c] = {stats[c].min, stats[c].max};
+
+      st.pushBlock(block.data(), 0);
+      i += n;
     }
-  }
 
-  for (std::size_t k = 0; k < channels; k++)
-    sum[k] *= size_factor;
+    st.processedFrames += i;
+    if (i < read)
+      break;
 
-  return sum;
+    notify(self, ptr, false);
+  }
+
+  st.finish();
+  st.save();
+  notify(self, ptr, true);
 }
 
-rms_sample_t RMSData::computeChannelRMS(
-    gsl::span<const ossia::audio_sample> chan,
-    int64_t start_idx,
-    int64_t buffer_size)
+void RMSData::computeBlocks(
+    const std::vector<gsl::span<const ossia::audio_sample>>& audio,
+    bool last)
 {
-  float val = 0.;
-  auto begin = chan.begin() + start_idx;
-  auto end = begin + buffer_size;
-
-  for (auto it = begin; it < end; ++it)
-    val = abs_max(val, *it);
-  return val * std::numeric_limits<rms_sample_t>::max();
-}
+  if (audio.empty() || !m_storage)
+    return;
 
-void RMSData::computeChannelRMS(
-    ossia::drwav_handle& wav,
-    rms_sample_t* bytes,
-    int64_t buffer_size)
-{/*
-  const int channels = wav.channels();
-  float* val = (float*)alloca(sizeof(float) * channels);
-
-  float* floats = (float*)alloca(sizeof(float) * buffer_size * channels);
-  auto max = wav.read_pcm_frames_f32(buffer_size, floats);
-  if (max <= 0)
+  auto& st = *m_storage;
+  const int channels = st.channels;
+  if (int(audio.size()) != channels)
     return;
 
-  for (int c = 0; c < channels; c++)
-    val[c] = floats[c];
+  const int64_t max_frames = audio.front().size();
+  ossia::small_vector<Storage::Accumulator, 8> block(channels);
 
-  for (decltype(max) i = 1; i < max; i++)
+  // The decoder gives us everything decoded so far,
+  // only the blocks we have not seen yet are processed.
+  while (st.processedFrames < max_frames)
   {
+    const int64_t n
+        = std::min(int64_t(bufferSize), max_frames - st.processedFrames);
+    if (n < bufferSize && !last)
+      break;
+
     for (int c = 0; c < channels; c++)
     {
-      const float f = floats[i * channels + c];
-      val[c] = abs_max(val[c], f);
+      const auto s = kernels::minmax(audio[c].data() + st.processedFrames, n);
+      block[c] = {s.min, s.max};
     }
-  }
 
-  for (int c = 0; c < channels; c++)
-  {
-    bytes[c] = val[c] * std::numeric_limits<rms_sample_t>::max();
-  }*/
+    st.pushBlock(block.data(), 0);
+    st.processedFrames += n;
+  }
 }
 
-void RMSData::computeRMS(
-    const std::vector<gsl::span<const ossia::audio_sample>>& audio,
-    int buffer_size)
+void RMSData::Storage::pushBlock(const Accumulator* block, int level)
 {
-  if (audio.empty())
+  if (level >= levels)
     return;
-/*
-  // store the data in interleaved format, it's much easier...
-  const int64_t channels = audio.size();
-  const int64_t max_sample = audio.front().size();
 
-  const int64_t len = sizeof(rms_sample_t) * channels;
-  rms_sample_t* bytes = reinterpret_cast<rms_sample_t*>(alloca(len));
+  // Store the entry; readers on other threads only look at it
+  // once the count is published.
+  const int64_t idx = counts[level].load(std::memory_order_relaxed);
+  if (idx < capacity[level])
+  {
+    Sample* dst = data[level] + idx * channels;
+    for (int c = 0; c < channels; c++)
+    {
+      dst[c].min = toSample(block[c].min);
+      dst[c].max = toSample(block[c].max);
+    }
+    counts[level].store(idx + 1, std::memory_order_release);
+  }
+
+  // Summarize it in the next level
+  const int next = level + 1;
+  if (next >= levels)
+    return;
 
-  int64_t start_idx = frames_count * buffer_size;
-  while (start_idx + buffer_size < max_sample)
+  Accumulator* acc = &pending[next * channels];
+  int& count = pendingCount[next];
+  for (int c = 0; c < channels; c++)
   {
-    for (int i = 0; i < channels; i++)
+    if (count == 0)
     {
-      bytes[i] = computeChannelRMS(audio[i], start_idx, buffer_size);
+      acc[c] = block[c];
     }
+    else
+    {
+      acc[c].min = std::min(acc[c].min, block[c].min);
+      acc[c].max = std::max(acc[c].max, block[c].max);
+    }
+  }
 
-    m_ramBuffer.write(reinterpret_cast<const char*>(bytes), len);
-    start_idx += buffer_size;
-    frames_count++;
-    samples_count += channels;
+  if (++count == factor)
+  {
+    count = 0;
+    pushBlock(acc, next);
   }
-*/
-  newData();
 }
 
-void RMSData::computeLastRMS(
-    const std::vector<gsl::span<const ossia::audio_sample>>& audio,
-    int buffer_size)
+void RMSData::Storage::finish()
+{
+  // Flush the partial entries at the end of each level
+  for (int level = 1; level < levels; level++)
+  {
+    if (int& count = pendingCount[level]; count > 0)
+    {
+      count = 0;
+      pushBlock(&pending[level * channels], level);
+    }
+  }
+}
+
+void RMSData::Storage::save() const
 {
-  if (audio.empty())
+  if (cachePath.isEmpty() || cancelled)
     return;
-/*
-  // store the data in interleaved format, it's much easier...
-  const int channels = audio.size();
-  const int64_t max_frames = audio.front().size();
 
-  const int64_t len = sizeof(rms_sample_t) * channels;
-  rms_sample_t* bytes = reinterpret_cast<rms_sample_t*>(alloca(len));
+  score::writeCacheFile(cachePath, [&](const QString& tmp_path) {
+    QFile f{tmp_path};
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+      return false;
 
-  int64_t start_idx = frames_count * buffer_size;
-  while (start_idx + buffer_size < max_frames)
-  {
-    for (int i = 0; i < channels; i++)
+    Header h;
+    h.magic = rms_cache_magic;
+    h.version = rms_cache_version;
+    h.sampleRate = sampleRate;
+    h.channels = channels;
+    h.bufferSize = bufferSize;
+    h.factor = factor;
+    h.levels = levels;
+    f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+
+    for (int level = 0; level < levels; level++)
     {
-      bytes[i] = computeChannelRMS(audio[i], start_idx, buffer_size);
+      const int64_t count = counts[level].load(std::memory_order_acquire);
+      f.write(reinterpret_cast<const char*>(&count), sizeof(count));
     }
-    m_ramBuffer.write(reinterpret_cast<const char*>(bytes), len);
-    start_idx += buffer_size;
-    frames_count++;
-    samples_count += channels;
+
+    for (int level = 0; level < levels; level++)
+    {
+      const int64_t count = counts[level].load(std::memory_order_acquire);
+      f.write(
+          reinterpret_cast<const char*>(data[level]),
+          count * channels * sizeof(Sample));
+    }
+
+    return f.error() == QFile::NoError;
+  });
+}
+
+bool RMSData::loadCache()
+{
+  auto& st = *m_storage;
+  st.file.setFileName(st.cachePath);
+  if (!st.file.open(QIODevice::ReadOnly))
+    return false;
+
+  const int64_t size = st.file.size();
+  if (size < int64_t(sizeof(Header)))
+    return false;
+
+  auto data = reinterpret_cast<char*>(st.file.map(0, size));
+  if (!data)
+    return false;
+
+  Header h;
+  std::memcpy(&h, data, sizeof(Header));
+  if (h.magic != rms_cache_magic || h.version != rms_cache_version
+      || h.bufferSize != uint32_t(bufferSize) || h.factor != uint32_t(factor)
+      || h.channels != uint32_t(st.channels)
+      || h.sampleRate != uint32_t(st.sampleRate) || h.levels == 0
+      || h.levels > uint32_t(maxLevels))
+    return false;
+
+  int64_t offset = sizeof(Header) + h.levels * sizeof(int64_t);
+  if (size < offset)
+    return false;
+
+  const auto counts = reinterpret_cast<const int64_t*>(data + sizeof(Header));
+  for (uint32_t level = 0; level < h.levels; level++)
+  {
+    const int64_t count = counts[level];
+    const int64_t bytes = count * st.channels * sizeof(Sample);
+    if (count < 0 || offset + bytes > size)
+      return false;
+
+    // Never written to: the levels are complete
+    st.data[level] = reinterpret_cast<Sample*>(data + offset);
+    st.capacity[level] = count;
+    st.counts[level].store(count, std::memory_order_release);
+    offset += bytes;
+  }
+  st.levels = h.levels;
+
+  // Used to know which files are still in use, see evictCache
+  score::touchCacheFile(st.cachePath);
+  return true;
+}
+
+RMSData::View RMSData::view() const noexcept
+{
+  View v;
+  std::lock_guard lock{m_mutex};
+  if (!m_storage)
+    return v;
+
+  const auto& st = *m_storage;
+  v.storage = m_storage;
+  v.channels = st.channels;
+  for (int level = 0; level < st.levels; level++)
+  {
+    v.levels.push_back(
+        {st.data[level],
+         st.counts[level].load(std::memory_order_acquire),
+         Storage::levelFrames(level)});
   }
+  return v;
+}
 
-  if (start_idx < max_frames - 1)
+bool RMSData::View::minmax(
+    int64_t start_frame,
+    int64_t end_frame,
+    ossia::small_vector<std::pair<float, float>, 8>& out) const noexcept
+{
+  const int64_t span = end_frame - start_frame;
+  if (levels.empty() || span < bufferSize || start_frame < 0)
+    return false;
+  if (int(out.size()) != channels)
+    return false;
+
+  // Coarsest level where an entry is not larger than the range:
+  // we look at between 1 and factor + 1 entries.
+  int level = 0;
+  while (level + 1 < int(levels.size()) && levels[level + 1].frames <= span)
+    level++;
+
+  // The coarser levels lag behind while decoding
+  for (; level >= 0; level--)
   {
-    for (int i = 0; i < channels; i++)
+    const auto& l = levels[level];
+    const int64_t begin = start_frame / l.frames;
+    const int64_t end = (end_frame + l.frames - 1) / l.frames;
+    if (end > l.count)
+      continue;
+
+    const Sample* s = l.data + begin * channels;
+    for (int c = 0; c < channels; c++)
+      out[c] = {s[c].min, s[c].max};
+
+    for (int64_t i = begin + 1; i < end; i++)
     {
-      bytes[i]
-          = computeChannelRMS(audio[i], start_idx, max_frames - start_idx);
+      s = l.data + i * channels;
+      for (int c = 0; c < channels; c++)
+      {
+        out[c].first = std::min(out[c].first, float(s[c].min));
+        out[c].second = std::max(out[c].second, float(s[c].max));
+      }
     }
-    m_ramBuffer.write(reinterpret_cast<const char*>(bytes), len);
-    start_idx += buffer_size;
-    frames_count++;
-    samples_count += channels;
+
+    for (int c = 0; c < channels; c++)
+    {
+      out[c].first /= rms_scale;
+      out[c].second /= rms_scale;
+    }
+    return true;
   }
-*/
-  newData();
+
+  return false;
 }
 }
@@ -1,29 +1,92 @@
 #pragma once
 #include <Media/AudioArray.hpp>
+#include <Media/MediaFileHandle.hpp>
 #include <Process/TimeValue.hpp>
 
+#include <ossia/detail/small_vector.hpp>
 #include <ossia/detail/span.hpp>
 
-#include <QBuffer>
 #include <QFile>
+#include <QPointer>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
 
 namespace Media
 {
 
 using rms_sample_t = int16_t;
+
+/**
+ * @brief Multi-resolution summary of an audio file used to draw waveforms.
+ *
+ * Level 0 stores the minimum and maximum value of each block of
+ * bufferSize frames, for each channel.
+ * Each next level summarizes factor entries of the previous one,
+ * thus drawing a waveform at any zoom level only requires looking at
+ * a few entries per pixel.
+ *
+ * The levels are filled incrementally while the file is being decoded,
+ * and stored in the cache folder once complete: the next time the file is
+ * loaded, they are memory-mapped from there instead of being recomputed.
+ */
 struct RMSData : public QObject
 {
   W_OBJECT(RMSData)
 public:
+  static constexpr int bufferSize = 64;
+  static constexpr int factor = 4;
+  static constexpr int maxLevels = 24;
+
   struct Header
   {
+    uint32_t magic{};
+    uint32_t version{};
     uint32_t sampleRate{};
-    uint32_t bufferSize{};
     uint32_t channels{};
+    uint32_t bufferSize{};
+    uint32_t factor{};
+    uint32_t levels{};
     uint32_t padding{};
   };
 
+  //! Summary of a block of frames for a single channel
+  struct Sample
+  {
+    rms_sample_t min{};
+    rms_sample_t max{};
+  };
+
+  struct Level
+  {
+    //! Interleaved: entry i of channel c is at data[i * channels + c]
+    const Sample* data{};
+    //! Number of entries available
+    int64_t count{};
+    //! Number of audio frames summarized by each entry
+    int64_t frames{};
+  };
+
+  //! Thread-safe snapshot of the levels computed so far.
+  struct View
+  {
+    std::shared_ptr<const void> storage;
+    int channels{};
+    ossia::small_vector<Level, maxLevels> levels;
+
+    explicit operator bool() const noexcept { return !levels.empty(); }
+
+    //! Min / max of each channel between two frames.
+    //! Returns false if the range is too small or not computed yet.
+    bool minmax(
+        int64_t start_frame,
+        int64_t end_frame,
+        ossia::small_vector<std::pair<float, float>, 8>& out) const noexcept;
+  };
+
   RMSData();
+  ~RMSData();
 
   void load(QString abspath, int channels, int rate, TimeVal duration);
   bool exists() const;
@@ -33,46 +96,39 @@ public:
   void
   decodeLast(const std::vector<gsl::span<const ossia::audio_sample>>& audio);
 
-  // interleaved
-  void decode(ossia::drwav_handle& audio);
-  double sampleRateRatio(double expectedRate) const noexcept;
-
-  ossia::small_vector<float, 8>
-  frame(int64_t start_sample, int64_t end_sample) const noexcept;
+  // interleaved, processed on a worker thread: the signals are sent
+  // back on the thread of this object
+  void decode(const AudioFile::MmapReader& audio);
 
-  int64_t frames_count = 0;
-  int64_t samples_count = 0;
+  View view() const noexcept;
 
-  Header* header_ptr() const noexcept { return header; }
-  rms_sample_t* data_ptr() const noexcept { return data; }
+  //! Trims the waveform cache to its maximum size, on startup
+  static void evictCache();
 
   void newData() W_SIGNAL(newData);
   void finishedDecoding() W_SIGNAL(finishedDecoding);
 
 private:
-  rms_sample_t computeChannelRMS(
-      gsl::span<const ossia::audio_sample> chan,
-      int64_t start_idx,
-      int64_t buffer_size);
-  void computeRMS(
+  struct Storage;
+
+  static void processFile(
+      const std::shared_ptr<Storage>& st,
+      AudioFile::MmapReader& audio,
+      const QPointer<RMSData>& self);
+  static void notify(
+      const QPointer<RMSData>& self,
+      const std::shared_ptr<Storage>& st,
+      bool finished);
+
+  void computeBlocks(
       const std::vector<gsl::span<const ossia::audio_sample>>& audio,
-      int buffer_size);
-  void computeLastRMS(
-      const std::vector<gsl::span<const ossia::audio_sample>>& audio,
-      int buffer_size);
-  void computeChannelRMS(
-      ossia::drwav_handle& wav,
-      rms_sample_t* bytes,
-      int64_t buffer_size);
-
-  QFile m_file;
-  bool m_exists{false};
+      bool last);
+  bool loadCache();
 
-  Header* header{};
-  rms_sample_t* data{};
+  mutable std::mutex m_mutex;
+  std::shared_ptr<Storage> m_storage;
 
-  QByteArray m_ramData;
-  QBuffer m_ramBuffer;
+  bool m_exists{false};
 };
 
 }
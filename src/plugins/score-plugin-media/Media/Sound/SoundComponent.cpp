@@ -263,6 +263,7 @@ SoundComponent::SoundComponent(
 
   if (auto& file = element.file())
   {
+    file->prioritizeDecoding(Media::DecodePriority::Playing);
     file->on_finishedDecoding.connect<&SoundComponent::Recomputer::recompute>(
         m_recomputer);
   }
@@ -276,6 +277,7 @@ void SoundComponent::on_fileChanged()
 
   if (auto& file = process().file())
   {
+    file->prioritizeDecoding(Media::DecodePriority::Playing);
     file->on_finishedDecoding.connect<&SoundComponent::Recomputer::recompute>(
         m_recomputer);
   }
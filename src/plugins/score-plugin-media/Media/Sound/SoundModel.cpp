@@ -14,7 +14,8 @@ std::optional<double> estimateTempo(const AudioFile& file)
   auto handle = file.unsafe_handle();
   if (auto file = handle.target<AudioFile::mmap_ptr>())
   {
-    const auto tempo = file->wav.acid().tempo;
+    // A decoded copy has no ACID chunk: the tempo of the original is kept
+    const auto tempo = file->tempo != 0.f ? file->tempo : file->wav.acid().tempo;
     if (tempo != 0.f)
     {
       return tempo;
@@ -57,14 +58,19 @@ ProcessModel::ProcessModel(
   setFile(data);
 }
 
-ProcessModel::~ProcessModel() { }
+ProcessModel::~ProcessModel()
+{
+  AudioFileManager::instance().release(m_file);
+}
 
 void ProcessModel::loadFile(const QString& file)
 {
   m_file->on_mediaChanged.disconnect<&ProcessModel::on_mediaChanged>(*this);
 
-  m_file = AudioFileManager::instance().get(
-      file, score::IDocument::documentContext(*this));
+  auto& manager = AudioFileManager::instance();
+  auto previous = std::move(m_file);
+  m_file = manager.get(file, score::IDocument::documentContext(*this));
+  manager.release(previous);
 
   m_file->on_mediaChanged.connect<&ProcessModel::on_mediaChanged>(*this);
 }
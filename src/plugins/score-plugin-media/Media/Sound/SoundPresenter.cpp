@@ -29,11 +29,13 @@ LayerPresenter::LayerPresenter(
   });
 
   con(layer, &ProcessModel::fileChanged, this, [&]() {
+    layer.file()->prioritizeDecoding(DecodePriority::Visible);
     m_view->setData(layer.file());
     updateTempo();
     m_view->recompute(m_ratio);
   });
 
+  layer.file()->prioritizeDecoding(DecodePriority::Visible);
   m_view->setData(layer.file());
   updateTempo();
   m_view->recompute(m_ratio);
@@ -72,6 +72,9 @@ struct WaveformComputerImpl
     absmax_frame_fun_t absmax_frame_impl{};
     minmax_frame_fun_t minmax_frame_impl{};
 
+    // Precomputed summary, used when many samples fall in a single pixel
+    const RMSData::View* rms{};
+
     // TODO could be worth memoizing in a thread_local vector for absmax / minmax if we have a lot
     // of loops
 
@@ -136,7 +139,11 @@ struct WaveformComputerImpl
     {
       const int64_t start = h.start_offset + start_frame;
       const int64_t end = h.start_offset + end_frame;
-      if (start < h.decoded_samples && end < h.decoded_samples)
+      if (h.rms && h.rms->minmax(start, end, out))
+      {
+        return true;
+      }
+      else if (start < h.decoded_samples && end < h.decoded_samples)
       {
         h.handle.minmax_frame(start, end, out);
         return true;
@@ -198,7 +205,9 @@ struct WaveformComputerImpl
       const int64_t end = h.start_offset + (end_frame % h.duration);
       if (start < end)
       {
-        if (start < h.decoded_samples && end < h.decoded_samples)
+        if (h.rms && h.rms->minmax(start, end, out))
+          return true;
+        else if (start < h.decoded_samples && end < h.decoded_samples)
           h.handle.minmax_frame(start, end, out);
         else
           for (auto& val : out)
@@ -354,60 +363,6 @@ struct WaveformComputerImpl
     return true;
   }
 
-  /*
-    void compute_rms(const SizeInfos infos, const RMSData& rms)
-    {
-      QVector<QImage*> images;
-      if(!initImages(images, infos))
-        return;
-
-      for(int32_t x_samples = infos.logical_x0, x_pixels = x_samples -
-    infos.logical_x0 ;       x_samples < infos.logical_xf && x_pixels <
-    infos.logical_max_pixel ;       x_samples++, x_pixels++
-          )
-      {
-        if(computer.m_redraw_count > redraw_number)
-        {
-          pool.giveBack(images);
-          return;
-        }
-
-        const auto rms_sample = rms.frame(
-              (x_samples)     * infos.logical_samples_per_pixels *
-    infos.rate_ratio, (x_samples + 1) * infos.logical_samples_per_pixels *
-    infos.rate_ratio
-              );
-
-        for(int k = 0; k < infos.nchannels; k++)
-        {
-          QImage& image = images[k];
-          auto dat = reinterpret_cast<uint32_t*>(image.bits());
-
-          const int value = infos.logical_half_h_int + int(rms_sample[k] *
-    infos.logical_half_h_ratio);
-
-          auto [y, end_y] =
-              value < infos.logical_half_h_int
-              ? std::tuple<int, int>{value, infos.logical_half_h_int}
-              : std::tuple<int, int>{infos.logical_half_h_int, value};
-
-          for(; y <= end_y; y++)
-          {
-            dat[x_pixels + y * infos.logical_width] = main_color;
-          }
-        }
-      }
-
-      ComputedWaveform result;
-      result.mode = ComputedWaveform::RMS;
-      result.zoom = ratio;
-      result.x0 = infos.logical_x0;
-      result.xf = infos.logical_x0 + infos.logical_max_pixel;
-
-      computer.ready(images, result);
-    }
-  */
-
   void compute_mean_absmax(const SizeInfos infos)
   {
     QPainter* p = (QPainter*)alloca(sizeof(QPainter) * infos.nchannels);
@@ -601,9 +556,6 @@ struct WaveformComputerImpl
 
     if (data.decodedSamples() == 0)
       return;
-    //auto& rms = data.rms();
-    //if (rms.frames_count == 0)
-    //  return;
 
     // Height of each channel
     infos.logical_h = request.layerSize.height() / (float)infos.nchannels;
@@ -619,10 +571,6 @@ struct WaveformComputerImpl
 
     // rightmost point
     const auto audioSampleRate = data.sampleRate();
-    // not applicable if we source the direct MediaFileHnadle data which is
-    // always resampled, only if we user the RMS cache : There may be a ratio
-    // because the waveform could have been computed at a different samplerate.
-    // infos.rate_ratio =  data.rms().sampleRateRatio(audioSampleRate);
     infos.logical_samples_per_pixels
         = infos.tempo_ratio * 0.001 * zoom * audioSampleRate
           / (ossia::flicks_per_millisecond<double>);
@@ -683,9 +631,9 @@ struct WaveformComputerImpl
     }
     else
     {
-      // Show rms
+      // Show min / max, from the summary levels when they are available:
+      // the cost is then proportional to the number of pixels
       compute_mean_minmax(infos);
-      // compute_rms(infos, rms);
     }
   }
 };
@@ -742,6 +690,11 @@ void WaveformComputer::timerEvent(QTimerEvent* event)
     loopHandle.absmax_frame_impl = loopHandle.normal_absmax_frame;
     loopHandle.minmax_frame_impl = loopHandle.normal_minmax_frame;
   }
+  // The levels are computed at the rate of the decoded data
+  const auto rms = file->rms().view();
+  if (rms)
+    loopHandle.rms = &rms;
+
   WaveformComputerImpl impl{loopHandle, m_currentRequest, m_n, *this};
   impl.compute();
   m_processed_n = m_n;
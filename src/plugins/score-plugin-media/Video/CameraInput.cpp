@@ -235,34 +235,15 @@ bool CameraInput::open_stream() noexcept
 
         res = !(avcodec_open2(m_codecContext, m_codec, nullptr) < 0);
         pixel_format = static_cast<AVPixelFormat>(codecpar->format);
+        color_space = codecpar->color_space;
+        color_range = codecpar->color_range;
         width = codecpar->width;
         height = codecpar->height;
         fps = av_q2d(m_formatContext->streams[i]->avg_frame_rate);
 
-        switch (pixel_format)
-        {
-          // Supported formats for gpu decoding
-          case AV_PIX_FMT_YUV420P:
-          case AV_PIX_FMT_YUVJ420P:
-          case AV_PIX_FMT_YUVJ422P:
-          case AV_PIX_FMT_YUV422P:
-          case AV_PIX_FMT_RGB0:
-          case AV_PIX_FMT_RGBA:
-          case AV_PIX_FMT_BGR0:
-          case AV_PIX_FMT_BGRA:
-#if LIBAVUTIL_VERSION_INT >= AV_VERSION_INT(56, 19, 100)
-          case AV_PIX_FMT_GRAYF32LE:
-          case AV_PIX_FMT_GRAYF32BE:
-#endif
-          case AV_PIX_FMT_GRAY8:
-            break;
-          // Other formats get rgb'd
-          default:
-          {
-            init_scaler();
-            break;
-          }
-        }
+        // Other formats get rgb'd
+        if (!formatIsGPUConverted(pixel_format))
+          init_scaler();
         break;
       }
     }
@@ -0,0 +1,122 @@
+#include <Media/Libav.hpp>
+#if SCORE_HAS_LIBAV
+#include "DecodeScheduler.hpp"
+
+#include <Video/VideoDecoder.hpp>
+
+#include <QThread>
+
+#include <algorithm>
+
+namespace Video
+{
+DecodeScheduler& DecodeScheduler::instance()
+{
+  static DecodeScheduler self;
+  return self;
+}
+
+DecodeScheduler::DecodeScheduler()
+{
+  const int threads = std::max(QThread::idealThreadCount(), 1);
+  for (int i = 0; i < threads; i++)
+    m_threads.emplace_back([this] { run(); });
+}
+
+DecodeScheduler::~DecodeScheduler()
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_stop = true;
+  }
+  m_work.notify_all();
+
+  for (auto& t : m_threads)
+    t.join();
+}
+
+DecodeScheduler::Entry* DecodeScheduler::find(VideoDecoder& decoder) noexcept
+{
+  auto it = std::find_if(
+      m_entries.begin(), m_entries.end(), [&](const Entry& e) {
+        return e.decoder == &decoder;
+      });
+  return it != m_entries.end() ? &*it : nullptr;
+}
+
+void DecodeScheduler::request(VideoDecoder& decoder, clock::time_point deadline)
+{
+  {
+    std::lock_guard lock{m_mutex};
+    if (auto e = find(decoder))
+    {
+      e->deadline = e->requested ? std::min(e->deadline, deadline) : deadline;
+      e->requested = true;
+    }
+    else
+    {
+      m_entries.push_back({&decoder, deadline, true, false});
+    }
+  }
+  m_work.notify_one();
+}
+
+void DecodeScheduler::remove(VideoDecoder& decoder)
+{
+  std::unique_lock lock{m_mutex};
+  m_done.wait(lock, [&] {
+    auto e = find(decoder);
+    return !e || !e->running;
+  });
+
+  if (auto e = find(decoder))
+  {
+    *e = m_entries.back();
+    m_entries.pop_back();
+  }
+}
+
+void DecodeScheduler::run()
+{
+  std::unique_lock lock{m_mutex};
+  for (;;)
+  {
+    Entry* next{};
+    m_work.wait(lock, [&] {
+      if (m_stop)
+        return true;
+
+      next = nullptr;
+      for (auto& e : m_entries)
+        if (e.requested && !e.running
+            && (!next || e.deadline < next->deadline))
+          next = &e;
+      return next != nullptr;
+    });
+
+    if (m_stop)
+      return;
+
+    VideoDecoder& decoder = *next->decoder;
+    next->requested = false;
+    next->running = true;
+
+    lock.unlock();
+    const bool more = decoder.decode_step();
+    const auto deadline = decoder.deadline();
+    lock.lock();
+
+    // The entries may have moved meanwhile, but this one is still there:
+    // remove() waits until it is not running anymore.
+    Entry& e = *find(decoder);
+    e.running = false;
+    if (more)
+    {
+      e.deadline = e.requested ? std::min(e.deadline, deadline) : deadline;
+      e.requested = true;
+    }
+    m_done.notify_all();
+  }
+}
+}
+#endif
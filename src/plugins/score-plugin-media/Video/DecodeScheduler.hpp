@@ -0,0 +1,68 @@
+#pragma once
+#include <Media/Libav.hpp>
+#if SCORE_HAS_LIBAV
+
+#include <score_plugin_media_export.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <condition_variable>
+
+namespace Video
+{
+class VideoDecoder;
+
+/**
+ * @brief Threads shared by all the video decoders.
+ *
+ * A decoder asks for work when its player is running out of frames, with
+ * the time at which it will have none left; the threads always serve the
+ * decoder with the earliest deadline, one frame at a time.
+ *
+ * A decoder which is not read from, because it is paused or not displayed,
+ * does not ask for work and thus does not use any thread.
+ * A decoder is never run by two threads at once.
+ *
+ * Unlike Media::DecodeScheduler, which decodes whole audio files,
+ * the decoders come back here for every few frames they play.
+ */
+class SCORE_PLUGIN_MEDIA_EXPORT DecodeScheduler
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  static DecodeScheduler& instance();
+  ~DecodeScheduler();
+
+  //! Runs the decoder before the deadline, until it has enough frames
+  void request(VideoDecoder& decoder, clock::time_point deadline);
+
+  //! Waits until no thread runs the decoder, and forgets it
+  void remove(VideoDecoder& decoder);
+
+private:
+  DecodeScheduler();
+
+  struct Entry
+  {
+    VideoDecoder* decoder{};
+    clock::time_point deadline{};
+    bool requested{};
+    bool running{};
+  };
+
+  void run();
+  Entry* find(VideoDecoder& decoder) noexcept;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work;
+  std::condition_variable m_done;
+  std::vector<Entry> m_entries;
+  std::vector<std::thread> m_threads;
+  bool m_stop{};
+};
+}
+#endif
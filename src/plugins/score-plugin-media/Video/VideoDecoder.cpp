@@ -22,6 +22,44 @@ namespace Video
 static char global_errbuf[512];
 VideoInterface::~VideoInterface() { }
 
+bool formatIsGPUConverted(AVPixelFormat fmt) noexcept
+{
+  switch (fmt)
+  {
+    case AV_PIX_FMT_YUV420P:
+    case AV_PIX_FMT_YUVJ420P:
+    case AV_PIX_FMT_YUV422P:
+    case AV_PIX_FMT_YUVJ422P:
+    case AV_PIX_FMT_YUV444P:
+    case AV_PIX_FMT_YUVJ444P:
+    case AV_PIX_FMT_YUVA420P:
+    case AV_PIX_FMT_YUV420P10LE:
+    case AV_PIX_FMT_YUV420P12LE:
+    case AV_PIX_FMT_YUV422P10LE:
+    case AV_PIX_FMT_YUV422P12LE:
+    case AV_PIX_FMT_YUV444P10LE:
+    case AV_PIX_FMT_YUV444P12LE:
+    case AV_PIX_FMT_NV12:
+    case AV_PIX_FMT_NV21:
+    case AV_PIX_FMT_P010LE:
+    case AV_PIX_FMT_P016LE:
+    case AV_PIX_FMT_YUYV422:
+    case AV_PIX_FMT_UYVY422:
+    case AV_PIX_FMT_RGB0:
+    case AV_PIX_FMT_RGBA:
+    case AV_PIX_FMT_BGR0:
+    case AV_PIX_FMT_BGRA:
+#if LIBAVUTIL_VERSION_INT >= AV_VERSION_INT(56, 19, 100)
+    case AV_PIX_FMT_GRAYF32LE:
+    case AV_PIX_FMT_GRAYF32BE:
+#endif
+    case AV_PIX_FMT_GRAY8:
+      return true;
+    default:
+      return false;
+  }
+}
+
 VideoDecoder::VideoDecoder() noexcept { }
 
 VideoDecoder::~VideoDecoder() noexcept
@@ -32,10 +70,17 @@ VideoDecoder::~VideoDecoder() noexcept
 std::shared_ptr<VideoDecoder> VideoDecoder::clone() const noexcept
 {
   auto ptr = std::make_shared<VideoDecoder>();
+  ptr->m_processCompressed = m_processCompressed;
   ptr->load(this->m_inputFile, {});
   return ptr;
 }
 
+void VideoDecoder::setCompressedFrameProcessor(
+    std::function<void(AVFrame&)> f) noexcept
+{
+  m_processCompressed = std::move(f);
+}
+
 bool VideoDecoder::load(
     const std::string& inputFile,
     double fps_unused) noexcept
@@ -63,16 +108,16 @@ bool VideoDecoder::load(
     return false;
   }
 
-  m_running.store(true, std::memory_order_release);
-  // TODO use a thread pool
-  m_thread = std::thread{[this] { this->buffer_thread(); }};
-
   int64_t secs = m_formatContext->duration / AV_TIME_BASE;
   int64_t us = m_formatContext->duration % AV_TIME_BASE;
 
   m_duration = secs * ossia::flicks_per_second<int64_t>;
   m_duration += us * ossia::flicks_per_millisecond<int64_t> / 1000;
 
+  // Fills the buffer up-front
+  m_running.store(true, std::memory_order_release);
+  DecodeScheduler::instance().request(*this, DecodeScheduler::clock::now());
+
   return true;
 }
 
@@ -81,13 +126,19 @@ int64_t VideoDecoder::duration() const noexcept
   return m_duration;
 }
 
-void VideoDecoder::seek(int64_t flicks)
+void VideoDecoder::seek(int64_t flicks) noexcept
 {
-  m_seekTo = flicks;
+  m_seekTo.store(flicks, std::memory_order_release);
 }
 
 AVFrame* VideoDecoder::dequeue_frame() noexcept
 {
+  // Seeks come from the execution thread, which must not wait for the
+  // scheduler: they are requested from here, on the render thread.
+  if (m_seekTo.load(std::memory_order_acquire) != -1
+      && m_running.load(std::memory_order_acquire))
+    DecodeScheduler::instance().request(*this, DecodeScheduler::clock::now());
+
   AVFrame* f{};
   if (auto to_discard = m_discardUntil.exchange(nullptr))
   {
@@ -103,8 +154,12 @@ AVFrame* VideoDecoder::dequeue_frame() noexcept
   if (f)
   {
     m_last_dequeued_dts = f->pkt_dts;
+
+    // Nothing is decoded for the decoders which are not played
+    if (m_framesToPlayer.size_approx() < frames_to_buffer / 2
+        && m_running.load(std::memory_order_acquire))
+      DecodeScheduler::instance().request(*this, deadline());
   }
-  m_condVar.notify_one();
   return f;
 }
 
@@ -113,47 +168,44 @@ void VideoDecoder::release_frame(AVFrame* frame) noexcept
   m_releasedFrames.enqueue(frame);
 }
 
-void VideoDecoder::buffer_thread() noexcept
+bool VideoDecoder::decode_step() noexcept
 {
-  while (m_running.load(std::memory_order_acquire))
+  if (!m_running.load(std::memory_order_acquire))
+    return false;
+
+  if (int64_t seek = m_seekTo.exchange(-1); seek >= 0)
   {
-    if (int64_t seek = m_seekTo.exchange(-1); seek >= 0)
-    {
-      seek_impl(seek);
-    }
-    else
-    {
-      std::unique_lock lck{m_condMut};
-      m_condVar.wait(lck, [&] {
-        return m_framesToPlayer.size_approx() < frames_to_buffer / 2
-               || !m_running.load(std::memory_order_acquire)
-               || (m_seekTo != -1);
-      });
-      if (!m_running.load(std::memory_order_acquire))
-        return;
-
-      if (int64_t seek = m_seekTo.exchange(-1); seek >= 0)
-      {
-        seek_impl(seek);
-      }
+    seek_impl(seek);
+  }
 
-      if (m_framesToPlayer.size_approx() < (frames_to_buffer / 2))
-        if (auto f = read_frame_impl())
-        {
-          m_framesToPlayer.enqueue(f);
-        }
-    }
+  if (m_framesToPlayer.size_approx() < frames_to_buffer / 2)
+  {
+    if (auto f = read_frame_impl())
+      m_framesToPlayer.enqueue(f);
+    else
+      return m_seekTo != -1; // End of the file: wait for the next seek
   }
+
+  return m_running.load(std::memory_order_acquire)
+         && (m_seekTo != -1
+             || m_framesToPlayer.size_approx() < frames_to_buffer / 2);
+}
+
+DecodeScheduler::clock::time_point VideoDecoder::deadline() const noexcept
+{
+  using namespace std::chrono;
+  const double frame_duration = fps > 0. ? 1. / fps : 1. / 30.;
+  const auto buffered = m_framesToPlayer.size_approx();
+  return DecodeScheduler::clock::now()
+         + duration_cast<DecodeScheduler::clock::duration>(
+             duration<double>(buffered * frame_duration));
 }
 
 void VideoDecoder::close_file() noexcept
 {
   // Stop the running status
   m_running.store(false, std::memory_order_release);
-  m_condVar.notify_one();
-
-  if (m_thread.joinable())
-    m_thread.join();
+  DecodeScheduler::instance().remove(*this);
 
   // Clear the stream
   close_video();
@@ -211,8 +263,12 @@ ReadFrame VideoDecoder::read_one_frame(AVFrame* frame, AVPacket& packet)
 
         memcpy(&frame->format, &cp->codec_tag, 4);
 
+        // Releases what the frame held when it was last played
+        av_frame_unref(frame);
         frame->buf[0] = av_buffer_ref(packet.buf);
         frame->format = (cp->codec_tag);
+        frame->width = cp->width;
+        frame->height = cp->height;
         frame->best_effort_timestamp = packet.pts;
         frame->data[0]
             = packet.data; //(uint8_t*)malloc(sizeof(uint8_t) * packet.size);
@@ -220,6 +276,7 @@ ReadFrame VideoDecoder::read_one_frame(AVFrame* frame, AVPacket& packet)
         frame->pts = packet.pts;
         frame->pkt_dts = packet.dts;
         frame->pkt_duration = packet.duration;
+        av_packet_unref(&packet);
 
         //std::copy_n(packet.data, packet.size, frame->data[0]);
         return {frame, 0};
@@ -316,6 +373,8 @@ bool VideoDecoder::seek_impl(int64_t flicks) noexcept
 
   if (r.frame)
   {
+    if (!m_codecContext && m_processCompressed)
+      m_processCompressed(*f);
     m_framesToPlayer.enqueue(f);
     m_discardUntil = f;
   }
@@ -346,6 +405,10 @@ AVFrame* VideoDecoder::read_frame_impl() noexcept
       av_frame_free(&frame);
       res.frame = nullptr;
     }
+    else if (!m_codecContext && m_processCompressed)
+    {
+      m_processCompressed(*res.frame);
+    }
   }
   return res.frame;
 }
@@ -423,36 +486,17 @@ bool VideoDecoder::open_stream() noexcept
         else
         {
           pixel_format = (AVPixelFormat)codecPar->format;
+          color_space = codecPar->color_space;
+          color_range = codecPar->color_range;
           width = codecPar->width;
           height = codecPar->height;
           fps = av_q2d(stream->avg_frame_rate);
           m_codecContext = stream->codec;
           res = !(avcodec_open2(m_codecContext, m_codec, nullptr) < 0);
 
-          switch (pixel_format)
-          {
-            // Supported formats for gpu decoding
-            case AV_PIX_FMT_YUV420P:
-            case AV_PIX_FMT_YUVJ420P:
-            case AV_PIX_FMT_YUVJ422P:
-            case AV_PIX_FMT_YUV422P:
-            case AV_PIX_FMT_RGB0:
-            case AV_PIX_FMT_RGBA:
-            case AV_PIX_FMT_BGR0:
-            case AV_PIX_FMT_BGRA:
-#if LIBAVUTIL_VERSION_INT >= AV_VERSION_INT(56, 19, 100)
-            case AV_PIX_FMT_GRAYF32LE:
-            case AV_PIX_FMT_GRAYF32BE:
-#endif
-            case AV_PIX_FMT_GRAY8:
-              break;
-            // Other formats get rgb'd
-            default:
-            {
-              init_scaler();
-              break;
-            }
-          }
+          // Other formats get rgb'd
+          if (!formatIsGPUConverted(pixel_format))
+            init_scaler();
         }
       }
     }
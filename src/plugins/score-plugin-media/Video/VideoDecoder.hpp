@@ -1,6 +1,7 @@
 #pragma once
 #include <Media/Libav.hpp>
 #if SCORE_HAS_LIBAV
+#include <Video/DecodeScheduler.hpp>
 #include <Video/VideoInterface.hpp>
 extern "C"
 {
@@ -13,11 +14,8 @@ extern "C"
 #include <score_plugin_media_export.h>
 
 #include <atomic>
-#include <mutex>
+#include <functional>
 #include <string>
-#include <thread>
-
-#include <condition_variable>
 
 namespace Video
 {
@@ -33,17 +31,33 @@ public:
   ~VideoDecoder() noexcept;
 
   std::shared_ptr<VideoDecoder> clone() const noexcept;
+
+  //! Called on the decoding threads for the frames that libav does not
+  //! decode (HAP), whose data[0] holds the packet, before they are played.
+  //! Must be set before load(); clone() keeps it.
+  void setCompressedFrameProcessor(std::function<void(AVFrame&)> f) noexcept;
+
   bool load(const std::string& inputFile, double fps_unused) noexcept;
 
   int64_t duration() const noexcept;
 
-  void seek(int64_t flicks);
+  //! Can be called from the execution thread: only records the position,
+  //! the decoding is requested by the next dequeue_frame().
+  void seek(int64_t flicks) noexcept;
 
   AVFrame* dequeue_frame() noexcept override;
   void release_frame(AVFrame*) noexcept override;
 
 private:
-  void buffer_thread() noexcept;
+  friend class DecodeScheduler;
+
+  //! Called by the DecodeScheduler: seeks if asked to, and decodes a frame
+  //! if needed. Returns whether there is more to decode.
+  bool decode_step() noexcept;
+
+  //! When the frames already decoded will have been played
+  DecodeScheduler::clock::time_point deadline() const noexcept;
+
   void close_file() noexcept;
   bool seek_impl(int64_t dts) noexcept;
   AVFrame* read_frame_impl() noexcept;
@@ -59,10 +73,7 @@ private:
   static const constexpr int frames_to_buffer = 16;
 
   std::string m_inputFile;
-
-  std::thread m_thread;
-  std::mutex m_condMut;
-  std::condition_variable m_condVar;
+  std::function<void(AVFrame&)> m_processCompressed;
 
   ossia::spsc_queue<AVFrame*, 16> m_framesToPlayer;
   ossia::spsc_queue<AVFrame*, 16> m_releasedFrames;
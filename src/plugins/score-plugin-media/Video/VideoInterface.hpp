@@ -16,6 +16,8 @@ struct SCORE_PLUGIN_MEDIA_EXPORT VideoMetadata
   int height{};
   double fps{};
   AVPixelFormat pixel_format = AVPixelFormat(-1);
+  AVColorSpace color_space = AVCOL_SPC_UNSPECIFIED;
+  AVColorRange color_range = AVCOL_RANGE_UNSPECIFIED;
   bool realTime{};
   double flicks_per_dts{};
   double dts_per_flicks{};
@@ -28,5 +30,12 @@ struct SCORE_PLUGIN_MEDIA_EXPORT VideoInterface : VideoMetadata
   virtual void release_frame(AVFrame* frame) noexcept = 0;
 };
 
+//! Whether the frames can be passed as is to the renderer, which converts
+//! them on the GPU, instead of being converted to RGBA by the decoder.
+//! The renderer may still convert them on the CPU if the backend lacks
+//! a texture format they need.
+SCORE_PLUGIN_MEDIA_EXPORT
+bool formatIsGPUConverted(AVPixelFormat fmt) noexcept;
+
 }
 #endif
@@ -4,6 +4,7 @@
 
 #include <Automation/AutomationModel.hpp>
 #include <Curve/Segment/PointArray/PointArraySegment.hpp>
+#include <Recording/Record/RecordAutomations/RecordBuffer.hpp>
 
 #include <ossia/network/domain/domain.hpp>
 
@@ -51,7 +52,12 @@ RecordData RecordAutomationCreationVisitor::makeCurve(float start_y)
   segt->addPoint(0, start_y);
 
   autom.curve().addSegment(segt);
-  return RecordData{cmd_proc, cmd_layer, autom.curve(), *segt, addr.unit};
+
+  const auto& settings = recorder.settings();
+  auto buffer = std::make_shared<RecordBuffer>(
+      *segt, settings.getSimplify(), settings.getSimplificationRatio());
+  return RecordData{
+      cmd_proc, cmd_layer, autom.curve(), *segt, std::move(buffer), addr.unit};
 }
 
 void RecordAutomationCreationVisitor::handle_numeric(float val)
@@ -1,6 +1,5 @@
 #pragma once
-#include <Automation/AutomationModel.hpp>
-#include <Curve/Segment/PointArray/PointArraySegment.hpp>
+#include <Recording/Record/RecordAutomations/RecordBuffer.hpp>
 #include <Recording/Record/RecordManager.hpp>
 
 namespace Recording
@@ -15,17 +14,10 @@ namespace Recording
  */
 struct ParameterPolicy
 {
-  void operator()(
-      const RecordData& proc,
-      const TimeVal& msecs,
-      double msec,
-      float val)
+  void operator()(RecordBuffer& buffer, double msec, float val)
   {
-    auto last = proc.segment.points().rbegin();
-    proc.segment.addPoint(msec - 1, last->second);
-    proc.segment.addPoint(msec, val);
-    static_cast<Automation::ProcessModel*>(proc.curveModel.parent())
-        ->setDuration(msecs);
+    buffer.addPoint(msec - 1, buffer.lastValue());
+    buffer.addPoint(msec, val);
   }
 };
 
@@ -39,79 +31,58 @@ struct ParameterPolicy
  */
 struct MessagePolicy
 {
-  void operator()(
-      const RecordData& proc,
-      const TimeVal& msecs,
-      double msec,
-      float val)
+  void operator()(RecordBuffer& buffer, double msec, float val)
   {
-    proc.segment.addPoint(msec, val);
-    static_cast<Automation::ProcessModel*>(proc.curveModel.parent())
-        ->setDuration(msecs);
+    buffer.addPoint(msec, val);
   }
 };
 
-template <typename RecordingPolicy>
-struct RecordAutomationSubsequentCallbackVisitor
+/**
+ * @brief Splits a received value in the curves which record it.
+ *
+ * Called from the thread of the device: it only pushes to the capture queue,
+ * which is drained in the GUI thread.
+ */
+struct RecordAutomationCaptureVisitor
 {
   AutomationRecorder& recorder;
   const State::Address& addr;
-  TimeVal msecs;
+  RecordContext::clock::time_point time;
 
-  void operator()(std::array<float, 2> val)
+  template <typename Records, std::size_t N>
+  void handle_array(const Records& records, const std::array<float, N>& val)
   {
-    const double msec = msecs.msec();
-    auto it = recorder.vec2_records.find(addr);
-    SCORE_ASSERT(it != recorder.vec2_records.end());
+    auto it = records.find(addr);
+    SCORE_ASSERT(it != records.end());
 
     const auto& proc_data = it->second;
-
-    const constexpr std::size_t N = 2;
     for (std::size_t i = 0; i < N; i++)
     {
-      RecordingPolicy{}(proc_data[i], msecs, msec, val[i]);
+      recorder.capture.enqueue(CapturedValue{&proc_data[i], time, val[i]});
     }
   }
 
-  void operator()(std::array<float, 3> val)
+  void operator()(std::array<float, 2> val)
   {
-    const double msec = msecs.msec();
-    auto it = recorder.vec3_records.find(addr);
-    SCORE_ASSERT(it != recorder.vec3_records.end());
-
-    const auto& proc_data = it->second;
+    handle_array(recorder.vec2_records, val);
+  }
 
-    const constexpr std::size_t N = 3;
-    for (std::size_t i = 0; i < N; i++)
-    {
-      RecordingPolicy{}(proc_data[i], msecs, msec, val[i]);
-    }
+  void operator()(std::array<float, 3> val)
+  {
+    handle_array(recorder.vec3_records, val);
   }
 
   void operator()(std::array<float, 4> val)
   {
-    const double msec = msecs.msec();
-    auto it = recorder.vec4_records.find(addr);
-    SCORE_ASSERT(it != recorder.vec4_records.end());
-
-    const auto& proc_data = it->second;
-
-    const constexpr std::size_t N = 4;
-    for (std::size_t i = 0; i < N; i++)
-    {
-      RecordingPolicy{}(proc_data[i], msecs, msec, val[i]);
-    }
+    handle_array(recorder.vec4_records, val);
   }
 
   void handle_numeric(float newval)
   {
-    const double msec = msecs.msec();
     auto it = recorder.numeric_records.find(addr);
     SCORE_ASSERT(it != recorder.numeric_records.end());
 
-    const RecordData& proc_data = it->second;
-
-    RecordingPolicy{}(proc_data, msecs, msec, newval);
+    recorder.capture.enqueue(CapturedValue{&it->second, time, newval});
   }
 
   void operator()(float f) { handle_numeric(f); }
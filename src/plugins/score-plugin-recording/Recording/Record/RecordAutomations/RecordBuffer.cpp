@@ -0,0 +1,183 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check
+// it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#include "RecordBuffer.hpp"
+
+#include <Curve/Segment/PointArray/PointArraySegment.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace Recording
+{
+namespace
+{
+// Points in a curve before the oldest half of them is written to disk
+constexpr std::size_t max_points = 1 << 16;
+
+// Points kept in the curve for the display of what was written to disk
+constexpr std::size_t max_display_points = max_points / 4;
+}
+
+bool StreamSimplifier::push(point p, double tolerance, point& kept) noexcept
+{
+  switch (m_count)
+  {
+    case 0:
+      m_key = p;
+      m_count = 1;
+      kept = p;
+      return true;
+    case 1:
+      m_direction = p;
+      m_last = p;
+      m_count = 2;
+      return false;
+    default:
+    {
+      const double dx = m_direction.first - m_key.first;
+      const double dy = m_direction.second - m_key.second;
+      const double px = p.first - m_key.first;
+      const double py = p.second - m_key.second;
+      const double len = std::hypot(dx, dy);
+      const double dist = len > 0. ? std::abs(dx * py - dy * px) / len
+                                   : std::hypot(px, py);
+      if (dist <= tolerance)
+      {
+        m_last = p;
+        return false;
+      }
+
+      kept = m_last;
+      m_key = m_last;
+      m_direction = p;
+      m_last = p;
+      return true;
+    }
+  }
+}
+
+bool StreamSimplifier::flush(point& kept) noexcept
+{
+  if (m_count < 2 || m_last == m_key)
+    return false;
+
+  kept = m_last;
+  m_key = m_last;
+  m_count = 1;
+  return true;
+}
+
+RecordBuffer::RecordBuffer(
+    Curve::PointArraySegment& segt,
+    bool simplify,
+    int ratio)
+    : m_segment{segt}
+    , m_ratio{simplify ? 4. * std::max(ratio, 1) : 0.}
+{
+  if (!segt.points().empty())
+    m_lastValue = segt.points().rbegin()->second;
+}
+
+RecordBuffer::~RecordBuffer() = default;
+
+double RecordBuffer::tolerance() const noexcept
+{
+  // Finer than PointArraySegment::simplify, which runs after recording
+  return m_ratio > 0. ? (m_segment.max() - m_segment.min()) / m_ratio : 0.;
+}
+
+void RecordBuffer::addPoint(double x, double y)
+{
+  m_lastValue = y;
+
+  StreamSimplifier::point kept;
+  if (m_simplifier.push({x, y}, tolerance(), kept))
+    push(kept.first, kept.second);
+}
+
+void RecordBuffer::push(double x, double y)
+{
+  m_segment.addPoint(x, y);
+  if (m_segment.points().size() > max_points)
+    spill();
+}
+
+void RecordBuffer::spill()
+{
+  if (!m_spill.isOpen() && !m_spill.open())
+    return;
+
+  const auto& pts = m_segment.points();
+  const auto begin = pts.begin();
+  const auto mid = std::next(begin, pts.size() / 2);
+  const double until = mid->first;
+
+  // The points before m_spilledUntil are the display version
+  // of what a previous spill already wrote.
+  const std::size_t previous = m_spilledCount;
+  for (auto it = begin; it != mid; ++it)
+  {
+    if (previous > 0 && it->first < m_spilledUntil)
+      continue;
+
+    const double xy[2]{it->first, it->second};
+    if (m_spill.write(reinterpret_cast<const char*>(xy), sizeof(xy))
+        != sizeof(xy))
+    {
+      // Keeps the points in memory
+      m_spilledCount = previous;
+      m_spill.resize(previous * sizeof(xy));
+      m_spill.seek(m_spill.size());
+      return;
+    }
+    m_spilledCount++;
+  }
+
+  std::vector<StreamSimplifier::point> display;
+  {
+    StreamSimplifier coarse;
+    StreamSimplifier::point kept;
+    const double tol = 4. * tolerance();
+    for (auto it = begin; it != mid; ++it)
+      if (coarse.push(*it, tol, kept))
+        display.push_back(kept);
+    if (coarse.flush(kept))
+      display.push_back(kept);
+  }
+
+  if (display.size() > max_display_points)
+  {
+    const std::size_t stride = display.size() / max_display_points + 1;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < display.size(); i += stride)
+      display[k++] = display[i];
+    display.resize(k);
+  }
+
+  m_spilledUntil = until;
+  m_segment.replacePointsBefore(until, display);
+}
+
+void RecordBuffer::finish()
+{
+  StreamSimplifier::point kept;
+  if (m_simplifier.flush(kept))
+    push(kept.first, kept.second);
+
+  if (m_spilledCount == 0)
+    return;
+
+  std::vector<StreamSimplifier::point> pts;
+  pts.reserve(m_spilledCount);
+
+  m_spill.seek(0);
+  double xy[2];
+  while (m_spill.read(reinterpret_cast<char*>(xy), sizeof(xy)) == sizeof(xy))
+    pts.emplace_back(xy[0], xy[1]);
+  m_spill.close();
+
+  m_segment.replacePointsBefore(m_spilledUntil, pts);
+  m_spilledCount = 0;
+}
+}
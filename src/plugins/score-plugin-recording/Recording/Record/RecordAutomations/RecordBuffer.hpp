@@ -0,0 +1,79 @@
+#pragma once
+#include <QTemporaryFile>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Curve
+{
+class PointArraySegment;
+}
+
+namespace Recording
+{
+/**
+ * @brief Reumann-Witkam simplification, one point at a time.
+ *
+ * A point is dropped while it stays in the strip of half-width tolerance
+ * around the line going from the last kept point through the one after it.
+ * When a point leaves the strip, the last point inside it is kept and
+ * starts the next strip.
+ */
+class StreamSimplifier
+{
+public:
+  using point = std::pair<double, double>;
+
+  //! Returns true and sets kept if a point is kept
+  bool push(point p, double tolerance, point& kept) noexcept;
+
+  //! Returns true and sets kept if a point was still pending
+  bool flush(point& kept) noexcept;
+
+private:
+  point m_key{};
+  point m_direction{};
+  point m_last{};
+  int m_count{};
+};
+
+/**
+ * @brief The points recorded for an automation.
+ *
+ * The values go through a StreamSimplifier before being added to the curve,
+ * with a tolerance finer than the one used after recording.
+ * If the curve still gets too many points, the oldest ones are written to a
+ * temporary file and replaced by a coarser version, which is only used for
+ * display: they are read back by finish().
+ */
+class RecordBuffer
+{
+public:
+  RecordBuffer(Curve::PointArraySegment& segt, bool simplify, int ratio);
+  ~RecordBuffer();
+
+  void addPoint(double x, double y);
+  double lastValue() const noexcept { return m_lastValue; }
+
+  //! Must be called before using the points of the curve
+  void finish();
+
+  //! Number of points currently on disk
+  std::size_t spilled() const noexcept { return m_spilledCount; }
+
+private:
+  void push(double x, double y);
+  void spill();
+  double tolerance() const noexcept;
+
+  Curve::PointArraySegment& m_segment;
+  StreamSimplifier m_simplifier;
+  double m_ratio{};
+  double m_lastValue{};
+
+  QTemporaryFile m_spill;
+  std::size_t m_spilledCount{};
+  double m_spilledUntil{};
+};
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <State/Unit.hpp>
 
+#include <memory>
+
 namespace Scenario
 {
 class ProcessModel;
@@ -22,6 +24,7 @@ class DeviceExplorerModel;
 
 namespace Recording
 {
+class RecordBuffer;
 struct RecordData
 {
   RecordData(
@@ -29,11 +32,13 @@ struct RecordData
       Scenario::Command::AddLayerModelToSlot* cmd_lay,
       Curve::Model& cm,
       Curve::PointArraySegment& seg,
+      std::shared_ptr<RecordBuffer> buf,
       const State::Unit& u)
       : addProcCmd{cmd_proc}
       , addLayCmd{cmd_lay}
       , curveModel{cm}
       , segment{seg}
+      , buffer{std::move(buf)}
       , unit{u}
   {
   }
@@ -43,6 +48,7 @@ struct RecordData
 
   Curve::Model& curveModel;
   Curve::PointArraySegment& segment;
+  std::shared_ptr<RecordBuffer> buffer;
 
   State::Unit unit;
 };
@@ -19,8 +19,8 @@
 #include <Process/TimeValue.hpp>
 #include <Recording/Commands/Record.hpp>
 #include <Recording/Record/RecordAutomations/RecordAutomationCreationVisitor.hpp>
-#include <Recording/Record/RecordAutomations/RecordAutomationFirstParameterCallbackVisitor.hpp>
 #include <Recording/Record/RecordAutomations/RecordAutomationParameterCallbackVisitor.hpp>
+#include <Recording/Record/RecordAutomations/RecordBuffer.hpp>
 #include <Recording/Record/RecordData.hpp>
 #include <Recording/Record/RecordManager.hpp>
 #include <State/Value.hpp>
@@ -95,8 +95,7 @@ bool AutomationRecorder::setup(
   const auto& devicelist = context.explorer.deviceModel().list();
 
   //// Setup listening on the curves ////
-  const auto curve_mode = m_settings.getCurveMode();
-  m_recordingMode = curve_mode;
+  m_recordingMode = m_settings.getCurveMode();
   int i = 0;
   for (const auto& vec : recordListening)
   {
@@ -106,20 +105,16 @@ bool AutomationRecorder::setup(
 
     dev.addToListening(addresses[i]);
     // Add a custom callback.
-    if (curve_mode == Curve::Settings::Mode::Parameter)
-    {
-      dev.valueUpdated.connect<&AutomationRecorder::parameterCallback>(*this);
-    }
-    else
-    {
-      dev.valueUpdated.connect<&AutomationRecorder::messageCallback>(*this);
-    }
+    dev.valueUpdated.connect<&AutomationRecorder::captureCallback>(*this);
 
     m_recordCallbackConnections.push_back(&dev);
 
     i++;
   }
 
+  // The values are added to the curves when the display is updated
+  connect(&context.timer, &QTimer::timeout, this, [this] { drain(); });
+
   return true;
 }
 
@@ -127,26 +122,18 @@ void AutomationRecorder::stop()
 {
   // Stop all the recording machinery
   auto msecs = context.time();
-  const auto curve_mode = m_recordingMode;
   for (const auto& dev : m_recordCallbackConnections)
   {
     if (dev)
     {
-      if (curve_mode == Curve::Settings::Mode::Parameter)
-      {
-        dev->valueUpdated.disconnect<&AutomationRecorder::parameterCallback>(
-            *this);
-      }
-      else
-      {
-        dev->valueUpdated.disconnect<&AutomationRecorder::messageCallback>(
-            *this);
-      }
+      dev->valueUpdated.disconnect<&AutomationRecorder::captureCallback>(
+          *this);
     }
   }
   m_recordCallbackConnections.clear();
 
   QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+  drain();
 
   // Record and then stop
   if (!context.started())
@@ -224,40 +211,62 @@ void AutomationRecorder::stop()
   }
 }
 
-void AutomationRecorder::messageCallback(
+void AutomationRecorder::captureCallback(
     const State::Address& addr,
     const ossia::value& val)
 {
-  using namespace std::chrono;
-  if (context.started())
-  {
-    val.apply(RecordAutomationSubsequentCallbackVisitor<MessagePolicy>{
-        *this, addr, context.time()});
-  }
-  else
+  const auto now = RecordContext::clock::now();
+  if (!m_firstValue.test_and_set())
   {
     firstMessageReceived();
-    context.start();
-    val.apply(RecordAutomationFirstCallbackVisitor{*this, addr});
+    context.start(now);
   }
+
+  val.apply(RecordAutomationCaptureVisitor{*this, addr, now});
 }
 
-void AutomationRecorder::parameterCallback(
-    const State::Address& addr,
-    const ossia::value& val)
+void AutomationRecorder::drain()
 {
-  using namespace std::chrono;
-  if (context.started())
-  {
-    val.apply(RecordAutomationSubsequentCallbackVisitor<ParameterPolicy>{
-        *this, addr, context.time()});
-  }
-  else
+  if (!context.started())
+    return;
+
+  CapturedValue v;
+  if (!capture.try_dequeue(v))
+    return;
+
+  const auto start = context.firstValueTime;
+  const bool parameter = m_recordingMode == Curve::Settings::Mode::Parameter;
+  do
   {
-    firstMessageReceived();
-    context.start();
-    val.apply(RecordAutomationFirstCallbackVisitor{*this, addr});
-  }
+    RecordBuffer& buffer = *v.record->buffer;
+    const double msec
+        = std::chrono::duration<double, std::milli>(v.time - start).count();
+
+    // The first values are the start of the curves
+    if (msec <= 0.)
+      buffer.addPoint(0., v.value);
+    else if (parameter)
+      ParameterPolicy{}(buffer, msec, v.value);
+    else
+      MessagePolicy{}(buffer, msec, v.value);
+  } while (capture.try_dequeue(v));
+
+  const auto msecs = context.time();
+  auto setDuration = [&](const RecordData& dat) {
+    static_cast<Automation::ProcessModel*>(dat.curveModel.parent())
+        ->setDuration(msecs);
+  };
+  for (const auto& recorded : numeric_records)
+    setDuration(recorded.second);
+  for (const auto& recorded : vec2_records)
+    for (const auto& dat : recorded.second)
+      setDuration(dat);
+  for (const auto& recorded : vec3_records)
+    for (const auto& dat : recorded.second)
+      setDuration(dat);
+  for (const auto& recorded : vec4_records)
+    for (const auto& dat : recorded.second)
+      setDuration(dat);
 }
 
 bool AutomationRecorder::finish(
@@ -267,6 +276,8 @@ bool AutomationRecorder::finish(
     bool simplify,
     int simplifyRatio)
 {
+  recorded.buffer->finish();
+
   Curve::PointArraySegment& segt = recorded.segment;
   if (segt.points().empty()
       || (segt.points().size() == 1 && segt.points().begin()->first == 0.))
@@ -6,6 +6,9 @@
 
 #include <score/tools/std/HashMap.hpp>
 
+#include <ossia/detail/lockfree_queue.hpp>
+
+#include <atomic>
 #include <verdigris>
 namespace Curve
 {
@@ -17,6 +20,15 @@ class Model;
 namespace Recording
 {
 struct RecordContext;
+
+//! A component of a value received for a recorded address
+struct CapturedValue
+{
+  const RecordData* record{};
+  RecordContext::clock::time_point time{};
+  float value{};
+};
+
 // TODO for some reason we have to undo redo
 // to be able to send the curve at execution. Investigate why.
 class AutomationRecorder
@@ -38,6 +50,14 @@ public:
 
   void commit();
 
+  const Curve::Settings::Model& settings() const noexcept
+  {
+    return m_settings;
+  }
+
+  //! Filled from the device threads, drained in the GUI thread
+  ossia::mpmc_queue<CapturedValue> capture;
+
   score::hash_map<State::Address, RecordData> numeric_records;
   score::hash_map<State::Address, std::array<RecordData, 2>> vec2_records;
   score::hash_map<State::Address, std::array<RecordData, 3>> vec3_records;
@@ -48,8 +68,8 @@ public:
   void firstMessageReceived() W_SIGNAL(firstMessageReceived);
 
 private:
-  void messageCallback(const State::Address& addr, const ossia::value& val);
-  void parameterCallback(const State::Address& addr, const ossia::value& val);
+  void captureCallback(const State::Address& addr, const ossia::value& val);
+  void drain();
 
   bool finish(
       State::AddressAccessor addr,
@@ -60,6 +80,7 @@ private:
   const Curve::Settings::Model& m_settings;
   Curve::Settings::Mode m_recordingMode{};
   std::vector<QPointer<Device::DeviceInterface>> m_recordCallbackConnections;
+  std::atomic_flag m_firstValue = ATOMIC_FLAG_INIT;
 
   // TODO see this :
   // http://stackoverflow.com/questions/34596768/stdunordered-mapfind-using-a-type-different-than-the-key-type
@@ -39,9 +39,9 @@ public:
   RecordContext& operator=(const RecordContext& other) = delete;
   RecordContext& operator=(RecordContext&& other) = delete;
 
-  void start()
+  void start(clock::time_point t = clock::now())
   {
-    firstValueTime = clock::now();
+    firstValueTime = t;
     startTimer();
   }
 
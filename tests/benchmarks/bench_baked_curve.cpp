@@ -0,0 +1,126 @@
+#include <Curve/BakedCurve.hpp>
+
+#include <ossia/editor/curve/curve.hpp>
+#include <ossia/editor/curve/curve_segment/easing.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// Link with score_plugin_curve and ossia.
+// An automation of 16 power segments, built as the automation executor
+// does, with and without the "Bake curves for playback" setting.
+static constexpr int segment_count = 16;
+static constexpr int ticks = 512;
+
+struct Segment
+{
+  double x0, y0, x1, y1;
+  ossia::curve_segment<double> fun;
+};
+
+// As PowerSegment::makeFunction
+static std::vector<Segment> makeSegments()
+{
+  std::vector<Segment> segts;
+  for (int i = 0; i < segment_count; i++)
+  {
+    const double gamma = 0.25 + (i % 4);
+    segts.push_back(
+        {double(i) / segment_count,
+         (i % 2) ? 1. : 0.,
+         double(i + 1) / segment_count,
+         (i % 2) ? 0. : 1.,
+         [gamma](double ratio, double start, double end) {
+           return ossia::easing::ease{}(start, end, std::pow(ratio, gamma));
+         }});
+  }
+  return segts;
+}
+
+// As score_to_ossia::curve
+static std::shared_ptr<ossia::curve<double, float>> makeCurve()
+{
+  const auto segts = makeSegments();
+  auto curve = std::make_shared<ossia::curve<double, float>>();
+  curve->set_x0(0.);
+  curve->set_y0(segts.front().y0);
+  for (const auto& s : segts)
+  {
+    curve->add_point(
+        [fun = s.fun](double ratio, float start, float end) {
+          return float(fun(ratio, start, end));
+        },
+        s.x1,
+        s.y1);
+  }
+  return curve;
+}
+
+// As BakedCurve::fromSegments and score_to_ossia::bakedCurve
+static std::shared_ptr<ossia::curve<double, float>> makeBakedCurve()
+{
+  const auto segts = makeSegments();
+  std::vector<double> knots{0.};
+  for (const auto& s : segts)
+    knots.push_back(s.x1);
+
+  auto baked = std::make_shared<Curve::BakedCurve>(Curve::BakedCurve::bake(
+      [&](std::size_t k, double x) {
+        const Segment& s = segts[k];
+        return s.fun((x - s.x0) / (s.x1 - s.x0), s.y0, s.y1);
+      },
+      knots,
+      1e-4));
+
+  auto curve = std::make_shared<ossia::curve<double, float>>();
+  curve->set_x0(0.);
+  curve->set_y0(segts.front().y0);
+  curve->add_point(
+      [baked](double ratio, float, float) {
+        return float(baked->valueAtRatio(ratio));
+      },
+      1.,
+      segts.back().y1);
+  return curve;
+}
+
+// One value per tick, as the automation node asks for them
+static void curve_segments(benchmark::State& state)
+{
+  const auto curve = makeCurve();
+  for (auto _ : state)
+  {
+    for (int i = 0; i < ticks; i++)
+      benchmark::DoNotOptimize(curve->value_at(double(i) / ticks));
+  }
+  state.SetItemsProcessed(state.iterations() * ticks);
+}
+BENCHMARK(curve_segments);
+
+static void curve_baked(benchmark::State& state)
+{
+  const auto curve = makeBakedCurve();
+  for (auto _ : state)
+  {
+    for (int i = 0; i < ticks; i++)
+      benchmark::DoNotOptimize(curve->value_at(double(i) / ticks));
+  }
+  state.SetItemsProcessed(state.iterations() * ticks);
+}
+BENCHMARK(curve_baked);
+
+// Done once when the executor is created
+static void bake(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    auto curve = makeBakedCurve();
+    benchmark::DoNotOptimize(curve.get());
+  }
+}
+BENCHMARK(bake);
+
+BENCHMARK_MAIN();
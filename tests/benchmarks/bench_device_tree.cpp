@@ -0,0 +1,111 @@
+#include <Device/Node/DeviceNode.hpp>
+
+#include <score/model/tree/TreeNodeSerialization.hpp>
+#include <score/serialization/DataStreamVisitor.hpp>
+
+#include <core/application/MockApplication.hpp>
+
+#include <benchmark/benchmark.h>
+
+// A device the size of a large OSCQuery server:
+// 100 nodes with 1000 parameters each, i.e. about 100k nodes.
+static constexpr int branches = 100;
+static constexpr int leaves = 1000;
+
+static Device::Node makeTree()
+{
+  Device::Node root;
+  Device::DeviceSettings dev;
+  dev.name = "bench";
+  auto& device = root.emplace_back(std::move(dev), &root);
+  device.reserve(branches);
+  for (int i = 0; i < branches; i++)
+  {
+    Device::AddressSettings branch;
+    branch.name = QString("branch.%1").arg(i);
+    auto& b = device.emplace_back(std::move(branch), &device);
+    b.reserve(leaves);
+    for (int j = 0; j < leaves; j++)
+    {
+      Device::AddressSettings leaf;
+      leaf.name = QString("param.%1").arg(j);
+      leaf.value = float(j);
+      b.emplace_back(std::move(leaf), &b);
+    }
+  }
+  return root;
+}
+
+static void device_tree_build(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    auto root = makeTree();
+    benchmark::DoNotOptimize(root);
+  }
+  state.SetItemsProcessed(state.iterations() * branches * leaves);
+}
+BENCHMARK(device_tree_build);
+
+// What a view does when scrolling through the whole tree:
+// QAbstractItemModel::index() and parent() on every row
+static int walk(const Device::Node& parent)
+{
+  int res = 0;
+  for (int row = 0; row < parent.childCount(); row++)
+  {
+    const auto& child = parent.childAt(row);
+    res += parent.indexOfChild(&child);
+    res += walk(child);
+  }
+  return res;
+}
+
+static void device_tree_walk(benchmark::State& state)
+{
+  const auto root = makeTree();
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(walk(root));
+  }
+  state.SetItemsProcessed(state.iterations() * branches * leaves);
+}
+BENCHMARK(device_tree_walk);
+
+static void device_tree_serialize(benchmark::State& state)
+{
+  score::testing::MockApplication app;
+  const auto root = makeTree();
+  for (auto _ : state)
+  {
+    QByteArray arr;
+    DataStream::Serializer s{&arr};
+    s.readFrom(root);
+    benchmark::DoNotOptimize(arr.data());
+  }
+  state.SetItemsProcessed(state.iterations() * branches * leaves);
+}
+BENCHMARK(device_tree_serialize);
+
+static void device_tree_deserialize(benchmark::State& state)
+{
+  score::testing::MockApplication app;
+  QByteArray arr;
+  {
+    const auto root = makeTree();
+    DataStream::Serializer s{&arr};
+    s.readFrom(root);
+  }
+
+  for (auto _ : state)
+  {
+    Device::Node root;
+    DataStream::Deserializer s{arr};
+    s.writeTo(root);
+    benchmark::DoNotOptimize(root);
+  }
+  state.SetItemsProcessed(state.iterations() * branches * leaves);
+}
+BENCHMARK(device_tree_deserialize);
+
+BENCHMARK_MAIN();
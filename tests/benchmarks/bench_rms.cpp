@@ -0,0 +1,187 @@
+#include <Media/AudioKernels.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+// Build with -I src/plugins/score-plugin-media, and e.g. -mavx2 to
+// compare the instruction sets.
+//
+// The *_before benchmarks are the loops of RMSData and
+// AudioFile::ViewHandle as they were before the kernels, copied as is.
+static constexpr int block_size = 64;
+static constexpr int frames = 1 << 20;
+
+// ossia::audio_sample, the samples decoded with libav
+using audio_sample = double;
+
+template <typename T>
+static std::vector<T> noise(int n)
+{
+  std::mt19937 gen{1234};
+  std::uniform_real_distribution<T> dist{-1, 1};
+  std::vector<T> f(n);
+  for (auto& v : f)
+    v = dist(gen);
+  return f;
+}
+
+namespace before
+{
+struct Accumulator
+{
+  float min{};
+  float max{};
+  float meansq{};
+};
+
+// RMSData::computeBlocks, for a single channel
+static Accumulator block(const audio_sample* chan, int64_t n)
+{
+  float min = chan[0], max = chan[0], sq = 0.f;
+  for (int64_t i = 0; i < n; i++)
+  {
+    const float f = chan[i];
+    min = std::min(min, f);
+    max = std::max(max, f);
+    sq += f * f;
+  }
+  return {min, max, sq / n};
+}
+
+// RMSData::timerEvent, for memory-mapped files
+static void block_interleaved(
+    const float* floats,
+    int64_t i,
+    int64_t n,
+    int channels,
+    Accumulator* block)
+{
+  for (int c = 0; c < channels; c++)
+  {
+    const float f = floats[i * channels + c];
+    block[c] = {f, f, 0.f};
+  }
+  for (int64_t k = i; k < i + n; k++)
+  {
+    for (int c = 0; c < channels; c++)
+    {
+      const float f = floats[k * channels + c];
+      auto& b = block[c];
+      b.min = std::min(b.min, f);
+      b.max = std::max(b.max, f);
+      b.meansq += f * f;
+    }
+  }
+  for (int c = 0; c < channels; c++)
+    block[c].meansq /= n;
+}
+
+// Media::abs_max, folded by FrameComputer
+static constexpr inline float abs_max(float f1, float f2) noexcept
+{
+  return f2 >= 0.f ? f1 < f2 ? f2 : f1 : f1 < -f2 ? f2 : f1;
+}
+}
+
+static void summary_before(benchmark::State& state)
+{
+  const auto f = noise<audio_sample>(frames);
+  for (auto _ : state)
+  {
+    for (int i = 0; i < frames; i += block_size)
+    {
+      auto s = before::block(f.data() + i, block_size);
+      benchmark::DoNotOptimize(s);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * frames);
+}
+BENCHMARK(summary_before);
+
+static void summary_after(benchmark::State& state)
+{
+  const auto f = noise<audio_sample>(frames);
+  for (auto _ : state)
+  {
+    for (int i = 0; i < frames; i += block_size)
+    {
+      auto s = Media::kernels::minmax(f.data() + i, block_size);
+      benchmark::DoNotOptimize(s);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * frames);
+}
+BENCHMARK(summary_after);
+
+static void summary_interleaved_before(benchmark::State& state)
+{
+  const int channels = state.range(0);
+  const auto f = noise<float>(frames * channels);
+  std::vector<before::Accumulator> out(channels);
+  for (auto _ : state)
+  {
+    for (int i = 0; i < frames; i += block_size)
+    {
+      before::block_interleaved(f.data(), i, block_size, channels, out.data());
+      benchmark::DoNotOptimize(out.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * frames * channels);
+}
+BENCHMARK(summary_interleaved_before)->Arg(1)->Arg(2)->Arg(6);
+
+static void summary_interleaved_after(benchmark::State& state)
+{
+  const int channels = state.range(0);
+  const auto f = noise<float>(frames * channels);
+  std::vector<Media::kernels::MinMax> out(channels);
+  for (auto _ : state)
+  {
+    for (int i = 0; i < frames; i += block_size)
+    {
+      Media::kernels::minmax_interleaved(
+          f.data() + i * channels, block_size, channels, out.data());
+      benchmark::DoNotOptimize(out.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * frames * channels);
+}
+BENCHMARK(summary_interleaved_after)->Arg(1)->Arg(2)->Arg(6);
+
+// Waveform drawing at a low zoom level: one reduction per pixel
+static void absmax_before(benchmark::State& state)
+{
+  const auto f = noise<audio_sample>(frames);
+  for (auto _ : state)
+  {
+    for (int i = 0; i < frames; i += 4096)
+    {
+      float res = f[i];
+      for (int k = i + 1; k < i + 4096; k++)
+        res = before::abs_max(res, (float)f[k]);
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * frames);
+}
+BENCHMARK(absmax_before);
+
+static void absmax_after(benchmark::State& state)
+{
+  const auto f = noise<audio_sample>(frames);
+  for (auto _ : state)
+  {
+    for (int i = 0; i < frames; i += 4096)
+    {
+      float res = Media::kernels::abs_max(
+          Media::kernels::minmax(f.data() + i, 4096));
+      benchmark::DoNotOptimize(res);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * frames);
+}
+BENCHMARK(absmax_after);
+
+BENCHMARK_MAIN();